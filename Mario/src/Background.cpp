@@ -147,13 +147,21 @@ namespace Mario {
     }
     
     // ******************************************************************************
-    // Chnage the subtexture for each tiles in vector
+    // Chnage the subtexture for each tiles in vector. Tiles share the sprite of their
+    // prefab, which is read only, so each tile overrides the sprite. Change is
+    // tracked in journal so it can be undone
     // ******************************************************************************
-    static void ChangeEntitiesSubtex(const std::vector<Entity>& entityVector, const Ref<SubTexture>& subTex)
+    static void ChangeEntitiesSubtex(const std::vector<Entity>& entityVector, SubTextureHandle subTex)
     {
         for (auto entity : entityVector)
-            if (auto &subTexComp = entity.GetComponent<SpriteRendererComponent>().SubTexComp)
-                subTexComp = subTex;
+        {
+            const auto* sprite = entity.FindComponent<SpriteRendererComponent>();
+            if (!sprite || !sprite->SubTexComp)
+                continue;
+
+            entity.GetScene()->GetJournal().Track<SpriteRendererComponent>(entity);
+            entity.OverrideComponent<SpriteRendererComponent>().SubTexComp = subTex;
+        }
     }
     
     // ******************************************************************************
@@ -167,7 +175,7 @@ namespace Mario {
         struct Tile
         {
             bool IsRigid = true;
-            Ref<iKan::SubTexture> SubTexture;
+            SubTextureRef SubTexture;
         };
         
         // Texture to store tile sprite sheet
@@ -175,7 +183,7 @@ namespace Mario {
         
         // Map of vector of subtexture to the Char of their corresponding.
         // Sotring Subtextures of same tile with different color in a vector.
-        std::unordered_map<char, std::vector<Ref<SubTexture>>> SubTextureVectorMap;
+        std::unordered_map<char, std::vector<SubTextureRef>> SubTextureVectorMap;
         
         // Map of tile (property of tile that stores the subtexture also)
         // to the Char of their corresponding. This map stores the Tile information
@@ -187,8 +195,20 @@ namespace Mario {
         // Map of vector of Entity to the Char of their corresponding
         // Storing Entities of samee tiles with different positions in a vector
         std::unordered_map<char, std::vector<Entity>> EntityVectorMap;
+
+        // Map of prefab to the Char of their corresponding. All the entities of same
+        // tile are instances of one prefab, that stores their sprite and physics
+        std::unordered_map<char, Ref<Prefab>> PrefabMap;
     };
     static BgData s_Data;
+
+    // ******************************************************************************
+    // Chnage the subtexture of all the entities of tile
+    // ******************************************************************************
+    static void ChangeTileSubtex(char tileType, SubTextureHandle subTex)
+    {
+        ChangeEntitiesSubtex(s_Data.EntityVectorMap[tileType], subTex);
+    }
     
     glm::vec4 Background::s_BgColor = { 0.3f, 0.4f, 0.6f, 1.0f };
     
@@ -210,33 +230,41 @@ namespace Mario {
         size_t mapWidth    = s_MapTiles.find_first_of('0') + 1;
         uint32_t mapHeight = static_cast<uint32_t>(strlen(s_MapTiles.c_str())) / mapWidth;
         
-        // Creating entity for each tiles
-        IK_INFO("Creating Entity for each tiles");
+        // Prefab for each tile, all the entities of tile share its components
+        for (const auto& [tileType, tile] : s_Data.TileMap)
+        {
+            auto prefab = Prefab::Create(GetEntityNameFromChar(tileType));
+            if (tile.IsRigid)
+            {
+                prefab->AddComponent<RigidBody2DComponent>();
+                prefab->AddComponent<BoxColloider2DComponent>();
+            }
+            prefab->AddComponent<SceneHierarchyPannelProp>(false);
+            prefab->AddComponent<SpriteRendererComponent>(tile.SubTexture);
+            s_Data.PrefabMap[tileType] = prefab;
+        }
+
+        // Transform of each tiles, grouped by tile
+        std::unordered_map<char, std::vector<TransformComponent>> transformVectorMap;
         for (uint32_t y = 0; y < mapHeight; y++)
         {
             for (uint32_t x = 0; x < mapWidth; x++)
             {
                 if (char tileType = s_MapTiles[x + y * mapWidth]; s_Data.TileMap.find(tileType) != s_Data.TileMap.end())
                 {
-                    auto entity = s_Data.EntityVectorMap[tileType].emplace_back(scene->CreateEntity(GetEntityNameFromChar(tileType)));
-                    
-                    if (s_Data.TileMap[tileType].IsRigid)
-                    {
-                        entity.AddComponent<RigidBody2DComponent>();
-                        entity.AddComponent<BoxColloider2DComponent>();
-                    }
-                    entity.GetComponent<SceneHierarchyPannelProp>().IsProp = false;
-                    
-                    auto spriteEntity = entity.AddComponent<SpriteRendererComponent>(s_Data.TileMap[tileType].SubTexture);
-                    auto spriteSize   = spriteEntity.SubTexComp->GetSpriteSize();
-                    
-                    auto& tc = entity.GetComponent<TransformComponent>();
+                    auto spriteSize = SubTexture::Get(s_Data.TileMap[tileType].SubTexture).GetSpriteSize();
                     
+                    auto& tc = transformVectorMap[tileType].emplace_back();
                     tc.Translation = { x, (mapHeight / 2.0f) - y, 0.0f };
                     tc.Scale       = { spriteSize.x, spriteSize.y , 0.0f};
                 } //if (char tileType = s_MapTiles[x + y * mapWidth]; s_TextureMap.find(tileType) != s_TextureMap.end())
             } // for (uint32_t x = 0; x < mapWidth; x++)
         } // for (uint32_t y = 0; y < mapHeight; y++)
+
+        // Creating entity for each tiles, instances of a tile are created at once
+        IK_INFO("Creating Entity for each tiles");
+        for (const auto& [tileType, transforms] : transformVectorMap)
+            s_Data.EntityVectorMap[tileType] = scene->Instantiate(s_Data.PrefabMap[tileType], transforms);
     }
     
     // ******************************************************************************
@@ -278,38 +306,42 @@ namespace Mario {
             {
                 ImGui::PushID(i);
                 
-                auto coords = subTex->GetCoords();
+                auto coords = SubTexture::Get(subTex).GetCoords();
                 glm::vec2 uv1 = { (coords.x + 1) * 16.0f, coords.y * 16.0f };
                 glm::vec2 uv0 = { coords.x * 16.0f, (coords.y + 1) * 16.0f };
                 if (ImGui::ImageButton(myTexId, ImVec2(32.0f, 32.0f), ImVec2(uv0.x / myTexW, uv0.y / myTexH), ImVec2(uv1.x / myTexW, uv1.y / myTexH), 0))
                 {
-                    ChangeEntitiesSubtex(s_Data.EntityVectorMap[name], subTex);
+                    ChangeTileSubtex(name, subTex);
                     
                     if (name == 'Y')
                     {
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['!'], s_Data.SubTextureVectorMap['!'][i]);
+                        ChangeTileSubtex('!', s_Data.SubTextureVectorMap['!'][i]);
                     }
                     
                     else if (name == 'v')
                     {
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['<'], s_Data.SubTextureVectorMap['<'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['>'], s_Data.SubTextureVectorMap['>'][i]);
+                        ChangeTileSubtex('<', s_Data.SubTextureVectorMap['<'][i]);
+                        ChangeTileSubtex('>', s_Data.SubTextureVectorMap['>'][i]);
                     }
                     
                     else if (name == '^')
                     {
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap[')'], s_Data.SubTextureVectorMap[')'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['('], s_Data.SubTextureVectorMap['('][i]);
+                        ChangeTileSubtex(')', s_Data.SubTextureVectorMap[')'][i]);
+                        ChangeTileSubtex('(', s_Data.SubTextureVectorMap['('][i]);
                     }
                     
                     else if (name == '{')
                     {
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['*'], s_Data.SubTextureVectorMap['*'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['}'], s_Data.SubTextureVectorMap['}'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['1'], s_Data.SubTextureVectorMap['1'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['2'], s_Data.SubTextureVectorMap['2'][i]);
-                        ChangeEntitiesSubtex(s_Data.EntityVectorMap['3'], s_Data.SubTextureVectorMap['3'][i]);
+                        ChangeTileSubtex('*', s_Data.SubTextureVectorMap['*'][i]);
+                        ChangeTileSubtex('}', s_Data.SubTextureVectorMap['}'][i]);
+                        ChangeTileSubtex('1', s_Data.SubTextureVectorMap['1'][i]);
+                        ChangeTileSubtex('2', s_Data.SubTextureVectorMap['2'][i]);
+                        ChangeTileSubtex('3', s_Data.SubTextureVectorMap['3'][i]);
                     }
+
+                    // All the tiles changed by button are one step of journal
+                    if (auto& entities = s_Data.EntityVectorMap[name]; !entities.empty())
+                        entities.front().GetScene()->GetJournal().Commit();
                 }
                 ImGui::PopID();
                 ImGui::SameLine();
@@ -12,21 +12,26 @@
 namespace Mario {
 
     Ref<Texture> StartScreen::s_Texture = nullptr;
-    std::unordered_map<char, Ref<SubTexture>> StartScreen::s_TileMap;
+    std::unordered_map<char, SubTextureRef> StartScreen::s_TileMap;
     
+    // Frame of title, title text is rendered by one text entity
     static std::string s_MapTiles =
-    //          I__K A N
     "aggggggggggggggggggggggggggggggggb0"
-    "e          I  JJ  yzG            h0"
-    "e          w  JlyzJJJ            h0"
-    "e          w  JJJvJCH            h0"
-    "e          N  NNJJNOP            h0"
-    "e            yuzMwMzIyz          h0"
-    "e            JxxJvJlwww          h0"
-    "e            JJJNNJtwCD          h0"
-    "cffffffffffffnnnffnnnEFffffffffffd0"
+    "e                                h0"
+    "e                                h0"
+    "e                                h0"
+    "e                                h0"
+    "e                                h0"
+    "e                                h0"
+    "e                                h0"
+    "cffffffffffffffffffffffffffffffffd0"
     ;
     
+    // Title text
+    static const std::string s_Title = "iKan";
+    static const std::string s_TitleFontPath = "../../../Mario/assets/Resources/Fonts/Mario.ttf";
+    static constexpr float s_TitleScale = 4.0f;
+    
     // ******************************************************************************
     // Initialize the background tiles and creat entities
     // ******************************************************************************
@@ -57,7 +62,7 @@ namespace Mario {
                     entity.GetComponent<SceneHierarchyPannelProp>().IsProp = false;
                     
                     auto spriteEntity = entity.AddComponent<SpriteRendererComponent>(s_TileMap[tileType]);
-                    auto spriteSize   = spriteEntity.SubTexComp->GetSpriteSize();
+                    auto spriteSize   = SubTexture::Get(spriteEntity.SubTexComp).GetSpriteSize();
                     
                     auto& tc = entity.GetComponent<TransformComponent>();
                     
@@ -66,6 +71,23 @@ namespace Mario {
                 } //if (char tileType = s_MapTiles[x + y * mapWidth]; s_TextureMap.find(tileType) != s_TextureMap.end())
             } // for (uint32_t x = 0; x < mapWidth; x++)
         } // for (uint32_t y = 0; y < mapHeight; y++)
+        
+        // Creating one entity for title text
+        {
+            Ref<Font> font = Font::Create(s_TitleFontPath);
+            
+            auto entity = scene->CreateEntity("Title");
+            entity.GetComponent<SceneHierarchyPannelProp>().IsProp = false;
+            entity.AddComponent<TextRendererComponent>(s_Title, font, glm::vec4(1.0f, 0.8f, 0.7f, 1.0f));
+            
+            // Center of frame, pen is at the base line of text
+            float titleWidth = font->GetLayout(s_Title).Size.x * s_TitleScale;
+            float frameRight = (float)(mapWidth - 2);
+            
+            auto& tc = entity.GetComponent<TransformComponent>();
+            tc.Translation = { (frameRight - titleWidth) / 2.0f, 0.5f - s_TitleScale / 3.0f, 0.1f };
+            tc.Scale       = { s_TitleScale, s_TitleScale, 1.0f };
+        }
     }
     
     // ******************************************************************************
@@ -76,19 +98,6 @@ namespace Mario {
         for (size_t i = 0; i < 10; i++)
             s_TileMap['a' + (char)i] = SubTexture::CreateFromCoords(s_Texture, { float(i), 0.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
         
-        s_TileMap['N'] = SubTexture::CreateFromCoords(s_Texture, { 11.0f, 0.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        s_TileMap['O'] = SubTexture::CreateFromCoords(s_Texture, { 12.0f, 0.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        s_TileMap['P'] = SubTexture::CreateFromCoords(s_Texture, { 13.0f, 0.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        
-        for (size_t i = 0; i < 13; i++)
-            s_TileMap['l' + (char)i] = SubTexture::CreateFromCoords(s_Texture, { float(i), 1.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        
-        for (size_t i = 0; i < 2; i++)
-            s_TileMap['y' + (char)i] = SubTexture::CreateFromCoords(s_Texture, { float(i), 2.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        
-        for (size_t i = 0; i < 13; i++)
-            s_TileMap['A' + (char)i] = SubTexture::CreateFromCoords(s_Texture, { float(i + 2), 2.0f }, { 1.0f, 1.0f }, { 8.0f, 8.0f });
-        
         s_TileMap[' '] = s_TileMap['j'];
         
     }
@@ -31,7 +31,7 @@ namespace Mario {
         static Ref<Texture> s_Texture;
         
         // Map of subtexture to character tile
-        static std::unordered_map<char, Ref<SubTexture>> s_TileMap;
+        static std::unordered_map<char, SubTextureRef> s_TileMap;
     };
     
 }
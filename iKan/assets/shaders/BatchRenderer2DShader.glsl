@@ -1,7 +1,10 @@
 // ******************************************************************************
 // File         : BatchRenderer.glsl
 // Project      : i-Kan : Assets
-// Description  : Shader code for Batch renderer
+// Description  : Shader code for Batch renderer. Variants:
+//                TEXTURED   : Sample the texture slots, else only vertex color
+//                ID_BUFFER  : Write entity ID for mouse picking
+//                ALPHA_TEST : Discard the transparent fragments
 //
 // Created on   : 29/04/21.
 // ******************************************************************************
@@ -19,7 +22,7 @@ layout(location = 3) in float a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
 layout(location = 5) in int   a_ObjectID;
 
-uniform mat4 u_ViewProjection;
+#include "Camera.glsl"
 
 out VS_OUT
 {
@@ -38,7 +41,7 @@ void main()
     vs_out.TilingFactor  = a_TilingFactor;
     vs_out.ObjectID      = float(a_ObjectID);
 
-    gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+    gl_Position = r_ViewProjection * vec4(a_Position, 1.0);
 }
 
 // ******************************************************************************
@@ -47,7 +50,9 @@ void main()
 #type fragment
 #version 330 core
 layout(location = 0) out vec4 o_Color;
+#ifdef ID_BUFFER
 layout(location = 1) out int  o_IDBuffer;
+#endif
 
 in VS_OUT
 {
@@ -58,32 +63,22 @@ in VS_OUT
     float ObjectID;
 } fs_in;
 
-uniform sampler2D u_Textures[16];
+#ifdef TEXTURED
+#include "TextureSlots.glsl"
+#endif
 
 void main()
 {
     vec4 texColor = fs_in.Color;
-    switch(int(fs_in.TexIndex))
-    {
-        case 0: texColor *= texture(u_Textures[0], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 1: texColor *= texture(u_Textures[1], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 2: texColor *= texture(u_Textures[2], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 3: texColor *= texture(u_Textures[3], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 4: texColor *= texture(u_Textures[4], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 5: texColor *= texture(u_Textures[5], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 6: texColor *= texture(u_Textures[6], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 7: texColor *= texture(u_Textures[7], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 8: texColor *= texture(u_Textures[8], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 9: texColor *= texture(u_Textures[9], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 10: texColor *= texture(u_Textures[10], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 11: texColor *= texture(u_Textures[11], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 12: texColor *= texture(u_Textures[12], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 13: texColor *= texture(u_Textures[13], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 14: texColor *= texture(u_Textures[14], fs_in.TexCoord * fs_in.TilingFactor); break;
-        case 15: texColor *= texture(u_Textures[15], fs_in.TexCoord * fs_in.TilingFactor); break;
-    }
+#ifdef TEXTURED
+    texColor *= SampleTexture(fs_in.TexIndex, fs_in.TexCoord * fs_in.TilingFactor);
+#endif
+#ifdef ALPHA_TEST
     if(texColor.a < 0.1)
         discard;
+#endif
     o_Color = texColor;
+#ifdef ID_BUFFER
     o_IDBuffer = int(fs_in.ObjectID);
+#endif
 }
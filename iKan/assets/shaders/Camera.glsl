@@ -0,0 +1,17 @@
+// ******************************************************************************
+// File         : Camera.glsl
+// Project      : i-Kan : Assets
+// Description  : Per frame camera data, updated once by Scene Renderer. Included
+//                by shaders that need camera
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+layout(std140) uniform r_Camera
+{
+    mat4  r_View;
+    mat4  r_Projection;
+    mat4  r_ViewProjection;
+    float r_Time;
+    vec2  r_ViewportSize;
+};
@@ -0,0 +1,81 @@
+// ******************************************************************************
+// File         : LineShader.glsl
+// Project      : i-Kan : Assets
+// Description  : Shader code for instanced lines. One instance per segment, the
+//                segment is expanded to a quad of constant thickness in pixels
+//                in screen space. Variants:
+//                ID_BUFFER  : Write entity ID for mouse picking
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+// ******************************************************************************
+// vertex Shader
+// ******************************************************************************
+#type vertex
+#version 330 core
+
+// Per vertex : corner of unit quad, x along the segment and y across it
+layout(location = 0) in vec2  a_Corner;
+
+// Per instance : segment record
+layout(location = 1) in vec3  a_Start;
+layout(location = 2) in vec3  a_End;
+layout(location = 3) in vec4  a_Color;
+layout(location = 4) in float a_Thickness;
+layout(location = 5) in int   a_ObjectID;
+
+#include "Camera.glsl"
+
+out VS_OUT
+{
+    vec4  Color;
+    flat int ObjectID;
+} vs_out;
+
+void main()
+{
+    vs_out.Color    = a_Color;
+    vs_out.ObjectID = a_ObjectID;
+
+    vec4 start = r_ViewProjection * vec4(a_Start, 1.0);
+    vec4 end   = r_ViewProjection * vec4(a_End, 1.0);
+
+    // Direction of segment in pixels
+    vec2 viewport  = max(r_ViewportSize, vec2(1.0));
+    vec2 direction = (end.xy / end.w - start.xy / start.w) * viewport;
+    direction      = length(direction) > 0.0 ? normalize(direction) : vec2(1.0, 0.0);
+    vec2 normal    = vec2(-direction.y, direction.x);
+
+    // Corner x -0.5 is start and 0.5 is end. Ends are extended by half the thickness
+    // so that segments of polyline join without gap
+    vec4 position = a_Corner.x < 0.0 ? start : end;
+    vec2 offset   = (normal * a_Corner.y + direction * a_Corner.x) * a_Thickness;
+
+    position.xy += offset / viewport * 2.0 * position.w;
+    gl_Position  = position;
+}
+
+// ******************************************************************************
+// Fragment Shader
+// ******************************************************************************
+#type fragment
+#version 330 core
+layout(location = 0) out vec4 o_Color;
+#ifdef ID_BUFFER
+layout(location = 1) out int  o_IDBuffer;
+#endif
+
+in VS_OUT
+{
+    vec4  Color;
+    flat int ObjectID;
+} fs_in;
+
+void main()
+{
+    o_Color = fs_in.Color;
+#ifdef ID_BUFFER
+    o_IDBuffer = fs_in.ObjectID;
+#endif
+}
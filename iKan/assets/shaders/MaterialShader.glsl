@@ -0,0 +1,99 @@
+// ******************************************************************************
+// File         : MaterialShader.glsl
+// Project      : i-Kan : Assets
+// Description  : Shader code for quads drawn with Material. Parameters of each
+//                material of batch are in "r_Materials" block, quad picks its
+//                block with per vertex material index. Variants:
+//                ID_BUFFER  : Write entity ID for mouse picking
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+// ******************************************************************************
+// vertex Shader
+// ******************************************************************************
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3  a_Position;
+layout(location = 1) in vec4  a_Color;
+layout(location = 2) in vec2  a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+layout(location = 5) in int   a_ObjectID;
+layout(location = 6) in float a_MaterialIndex;
+
+#include "Camera.glsl"
+
+out VS_OUT
+{
+    vec4  Color;
+    vec2  TexCoord;
+    float TexIndex;
+    float TilingFactor;
+    float ObjectID;
+    flat int MaterialIndex;
+} vs_out;
+
+void main()
+{
+    vs_out.Color         = a_Color;
+    vs_out.TexCoord      = a_TexCoord;
+    vs_out.TexIndex      = a_TexIndex;
+    vs_out.TilingFactor  = a_TilingFactor;
+    vs_out.ObjectID      = float(a_ObjectID);
+    vs_out.MaterialIndex = int(a_MaterialIndex);
+
+    gl_Position = r_ViewProjection * vec4(a_Position, 1.0);
+}
+
+// ******************************************************************************
+// Fragment Shader
+// ******************************************************************************
+#type fragment
+#version 330 core
+layout(location = 0) out vec4 o_Color;
+#ifdef ID_BUFFER
+layout(location = 1) out int  o_IDBuffer;
+#endif
+
+in VS_OUT
+{
+    vec4  Color;
+    vec2  TexCoord;
+    float TexIndex;
+    float TilingFactor;
+    float ObjectID;
+    flat int MaterialIndex;
+} fs_in;
+
+// Parameters of material, set with Material::Set by name
+struct Material
+{
+    vec4  Tint;
+    vec2  UVOffset;
+    float TilingFactor;
+};
+
+layout(std140) uniform r_Materials
+{
+    Material r_MaterialInstances[64];
+};
+
+#include "TextureSlots.glsl"
+
+void main()
+{
+    Material material = r_MaterialInstances[fs_in.MaterialIndex];
+    vec2 uv = (fs_in.TexCoord + material.UVOffset) * fs_in.TilingFactor * max(material.TilingFactor, 0.0001);
+
+    vec4 texColor = fs_in.Color * material.Tint;
+    texColor *= SampleTexture(fs_in.TexIndex, uv);
+    if(texColor.a < 0.1)
+        discard;
+
+    o_Color = texColor;
+#ifdef ID_BUFFER
+    o_IDBuffer = int(fs_in.ObjectID);
+#endif
+}
@@ -0,0 +1,130 @@
+// ******************************************************************************
+// File         : SDFShapeShader.glsl
+// Project      : i-Kan : Assets
+// Description  : Shader code for instanced SDF shapes (circle, ring, rounded rect
+//                and capsule). One instance per shape, edges are anti aliased
+//                analytically. Variants:
+//                ID_BUFFER  : Write entity ID for mouse picking
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+// ******************************************************************************
+// vertex Shader
+// ******************************************************************************
+#type vertex
+#version 330 core
+
+// Per vertex : corner of unit quad
+layout(location = 0) in vec2  a_Corner;
+
+// Per instance : shape record
+layout(location = 1) in vec3  a_AxisX;
+layout(location = 2) in vec3  a_AxisY;
+layout(location = 3) in vec3  a_Center;
+layout(location = 4) in vec4  a_Color;
+layout(location = 5) in vec4  a_Params;
+layout(location = 6) in int   a_Shape;
+layout(location = 7) in int   a_ObjectID;
+
+#include "Camera.glsl"
+
+out VS_OUT
+{
+    vec4  Color;
+    vec2  LocalPos;
+    vec2  HalfSize;
+    vec4  Params;
+    flat int Shape;
+    flat int ObjectID;
+} vs_out;
+
+void main()
+{
+    // Shape is evaluated in world units so non uniform scale do not stretch edges
+    vs_out.HalfSize = 0.5 * vec2(length(a_AxisX), length(a_AxisY));
+    vs_out.LocalPos = a_Corner * 2.0 * vs_out.HalfSize;
+    vs_out.Color    = a_Color;
+    vs_out.Params   = a_Params;
+    vs_out.Shape    = a_Shape;
+    vs_out.ObjectID = a_ObjectID;
+
+    vec3 position = a_Center + a_Corner.x * a_AxisX + a_Corner.y * a_AxisY;
+    gl_Position = r_ViewProjection * vec4(position, 1.0);
+}
+
+// ******************************************************************************
+// Fragment Shader
+// ******************************************************************************
+#type fragment
+#version 330 core
+layout(location = 0) out vec4 o_Color;
+#ifdef ID_BUFFER
+layout(location = 1) out int  o_IDBuffer;
+#endif
+
+in VS_OUT
+{
+    vec4  Color;
+    vec2  LocalPos;
+    vec2  HalfSize;
+    vec4  Params;
+    flat int Shape;
+    flat int ObjectID;
+} fs_in;
+
+// Same as Renderer2D SDF shape types
+const int Circle      = 0;
+const int RoundedRect = 1;
+const int Capsule     = 2;
+
+float CircleSDF(vec2 p, float radius)
+{
+    return length(p) - radius;
+}
+
+float RoundedRectSDF(vec2 p, vec2 halfSize, float cornerRadius)
+{
+    vec2 q = abs(p) - halfSize + cornerRadius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - cornerRadius;
+}
+
+float CapsuleSDF(vec2 p, vec2 halfSize, float radius)
+{
+    // Segment along the longer axis
+    if (halfSize.x >= halfSize.y)
+        p.x -= clamp(p.x, -(halfSize.x - radius), halfSize.x - radius);
+    else
+        p.y -= clamp(p.y, -(halfSize.y - radius), halfSize.y - radius);
+    return length(p) - radius;
+}
+
+void main()
+{
+    // Params : x = thickness (fraction of radius, 1 is filled), y = fade (fraction
+    // of radius), z = corner radius of rounded rect (fraction of radius)
+    float radius    = min(fs_in.HalfSize.x, fs_in.HalfSize.y);
+    float thickness = fs_in.Params.x * radius;
+
+    float distance;
+    if (fs_in.Shape == RoundedRect)
+        distance = RoundedRectSDF(fs_in.LocalPos, fs_in.HalfSize, fs_in.Params.z * radius);
+    else if (fs_in.Shape == Capsule)
+        distance = CapsuleSDF(fs_in.LocalPos, fs_in.HalfSize, radius);
+    else
+        distance = CircleSDF(fs_in.LocalPos, radius);
+
+    // Edge is at least one pixel wide, fade makes it softer
+    float width = max(fwidth(distance), fs_in.Params.y * radius);
+    float alpha = 1.0 - smoothstep(-width, 0.0, distance);
+    if (fs_in.Params.x < 1.0)
+        alpha *= smoothstep(-thickness - width, -thickness, distance);
+
+    if (alpha <= 0.0)
+        discard;
+
+    o_Color = vec4(fs_in.Color.rgb, fs_in.Color.a * alpha);
+#ifdef ID_BUFFER
+    o_IDBuffer = fs_in.ObjectID;
+#endif
+}
@@ -0,0 +1,88 @@
+// ******************************************************************************
+// File         : TextShader.glsl
+// Project      : i-Kan : Assets
+// Description  : Shader code for instanced glyphs of signed distance field font.
+//                One instance per glyph, distance is in alpha of atlas and edge
+//                is anti aliased with screen space derivative. Variants:
+//                ID_BUFFER  : Write entity ID for mouse picking
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+// ******************************************************************************
+// vertex Shader
+// ******************************************************************************
+#type vertex
+#version 330 core
+
+// Per vertex : corner of unit quad
+layout(location = 0) in vec2  a_Corner;
+
+// Per instance : glyph record
+layout(location = 1) in vec3  a_Position;
+layout(location = 2) in vec3  a_AxisX;
+layout(location = 3) in vec3  a_AxisY;
+layout(location = 4) in vec4  a_TexRect;
+layout(location = 5) in vec4  a_Color;
+layout(location = 6) in float a_TexIndex;
+layout(location = 7) in int   a_ObjectID;
+
+#include "Camera.glsl"
+
+out VS_OUT
+{
+    vec4  Color;
+    vec2  TexCoord;
+    float TexIndex;
+    flat int ObjectID;
+} vs_out;
+
+void main()
+{
+    // Corner is -0.5 to 0.5, position of glyph is its bottom left corner
+    vec2 corner = a_Corner + 0.5;
+
+    vs_out.Color    = a_Color;
+    vs_out.TexCoord = mix(a_TexRect.xy, a_TexRect.zw, corner);
+    vs_out.TexIndex = a_TexIndex;
+    vs_out.ObjectID = a_ObjectID;
+
+    vec3 position = a_Position + corner.x * a_AxisX + corner.y * a_AxisY;
+    gl_Position = r_ViewProjection * vec4(position, 1.0);
+}
+
+// ******************************************************************************
+// Fragment Shader
+// ******************************************************************************
+#type fragment
+#version 330 core
+layout(location = 0) out vec4 o_Color;
+#ifdef ID_BUFFER
+layout(location = 1) out int  o_IDBuffer;
+#endif
+
+in VS_OUT
+{
+    vec4  Color;
+    vec2  TexCoord;
+    float TexIndex;
+    flat int ObjectID;
+} fs_in;
+
+#include "TextureSlots.glsl"
+
+void main()
+{
+    float distance = SampleTexture(fs_in.TexIndex, fs_in.TexCoord).a;
+
+    // Edge is at 0.5, smoothed over one pixel
+    float width = max(fwidth(distance), 0.0001);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    if (alpha <= 0.0)
+        discard;
+
+    o_Color = vec4(fs_in.Color.rgb, fs_in.Color.a * alpha);
+#ifdef ID_BUFFER
+    o_IDBuffer = fs_in.ObjectID;
+#endif
+}
@@ -0,0 +1,36 @@
+// ******************************************************************************
+// File         : TextureSlots.glsl
+// Project      : i-Kan : Assets
+// Description  : Texture slots of batch renderers. Included by fragment shaders
+//                that sample the texture of quad by its slot index
+//
+// Created on   : 19/10/26.
+// ******************************************************************************
+
+uniform sampler2D u_Textures[16];
+
+// Index of sampler array must be constant, so slot is selected by switch. Slot out
+// of range samples white
+vec4 SampleTexture(float slot, vec2 uv)
+{
+    switch(int(slot))
+    {
+        case 0: return texture(u_Textures[0], uv);
+        case 1: return texture(u_Textures[1], uv);
+        case 2: return texture(u_Textures[2], uv);
+        case 3: return texture(u_Textures[3], uv);
+        case 4: return texture(u_Textures[4], uv);
+        case 5: return texture(u_Textures[5], uv);
+        case 6: return texture(u_Textures[6], uv);
+        case 7: return texture(u_Textures[7], uv);
+        case 8: return texture(u_Textures[8], uv);
+        case 9: return texture(u_Textures[9], uv);
+        case 10: return texture(u_Textures[10], uv);
+        case 11: return texture(u_Textures[11], uv);
+        case 12: return texture(u_Textures[12], uv);
+        case 13: return texture(u_Textures[13], uv);
+        case 14: return texture(u_Textures[14], uv);
+        case 15: return texture(u_Textures[15], uv);
+    }
+    return vec4(1.0);
+}
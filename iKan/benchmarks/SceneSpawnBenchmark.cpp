@@ -0,0 +1,96 @@
+// ******************************************************************************
+// File         : SceneSpawnBenchmark.cpp
+// Description  : Benchmark of entity creation one by one against CreateEntities
+// Project      : iKan : Benchmarks
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+// ******************************************************************************
+// Standalone program, not part of engine target. Scene needs the engine, so build
+// libiKan.a with Xcode first and link the benchmark with it and the vendor libs.
+// From repo root (BUILT_PRODUCTS_DIR is the Xcode build directory), in one line:
+//
+//     c++ -std=c++17 -O2 -include iKan/src/PrefixHeader.pch
+//         -I iKan/src -I iKan/vendor/spdlog/include -I iKan/vendor/glm
+//         -I iKan/vendor/EnTT/include -I iKan/vendor/Imgui/Imgui
+//         -I iKan/vendor/box2D/box2D/include -I iKan/vendor/yaml/yaml/include
+//         iKan/benchmarks/SceneSpawnBenchmark.cpp -L $BUILT_PRODUCTS_DIR
+//         -liKan -lImgui -lbox2D -lyaml -lGlad -L iKan/vendor/glfw/lib -lglfw3
+//         -framework OpenGL -framework Cocoa -framework IOKit -o SceneSpawnBenchmark
+//     ./SceneSpawnBenchmark
+//
+// Spawns count tiles in a new scene, first with CreateEntity per tile (how tiles
+// were created before CreateEntities) then with one CreateEntities call. Core
+// logger is set to warn, so per entity trace logs are not part of the timing
+// ******************************************************************************
+
+#include <chrono>
+#include <cstdio>
+
+#include <iKan/Core/Log.h>
+#include <iKan/Scene/Scene.h>
+#include <iKan/Scene/Entity.h>
+#include <iKan/Scene/Component.h>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Time of spawn in nano seconds per entity, best of few runs. Each run spawns in
+    // a new scene, creating and destroying the scene is not timed
+    // ******************************************************************************
+    template<typename Function>
+    static double MeasureSpawn(size_t count, Function spawn)
+    {
+        double best = 1e30;
+        for (int run = 0; run < 5; run++)
+        {
+            Ref<Scene> scene = CreateRef<Scene>();
+
+            auto start = std::chrono::steady_clock::now();
+            spawn(*scene);
+            auto end = std::chrono::steady_clock::now();
+
+            IK_CORE_ASSERT((scene->GetNumEntities() == count), "Spawned entity count mismatch");
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / (double)count);
+        }
+        return best;
+    }
+
+    // ******************************************************************************
+    // Time both ways of spawning count tiles
+    // ******************************************************************************
+    static void Benchmark(size_t count)
+    {
+        std::vector<TransformComponent> transforms(count);
+        for (size_t i = 0; i < count; i++)
+            transforms[i].Translation = { (float)(i % 256), (float)(i / 256), 0.0f };
+
+        double perEntity = MeasureSpawn(count, [&](Scene& scene) {
+            for (const auto& transform : transforms)
+                scene.CreateEntity("Tile").GetComponent<TransformComponent>() = transform;
+        });
+
+        double bulk = MeasureSpawn(count, [&](Scene& scene) {
+            scene.CreateEntities(transforms, "Tile");
+        });
+
+        std::printf("%9zu  CreateEntity %8.2f ns  CreateEntities %8.2f ns  (x%.2f)\n", count, perEntity, bulk, perEntity / bulk);
+    }
+
+}
+
+int main()
+{
+    iKan::Log::Config config;
+    config.Async = false;
+    iKan::Log::Init(config);
+    iKan::Log::GetCoreLogger()->set_level(spdlog::level::warn);
+
+    for (size_t count : { 1000, 10000, 100000 })
+        iKan::Benchmark(count);
+
+    iKan::Log::Shutdown();
+    return 0;
+}
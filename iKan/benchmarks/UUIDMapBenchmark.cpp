@@ -0,0 +1,176 @@
+// ******************************************************************************
+// File         : UUIDMapBenchmark.cpp
+// Description  : Micro benchmark of UUIDMap against std::unordered_map
+// Project      : iKan : Benchmarks
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+// ******************************************************************************
+// Standalone program, not part of engine target. Build and run from repo root:
+//
+//     c++ -std=c++17 -O2 -I iKan/src iKan/benchmarks/UUIDMapBenchmark.cpp -o UUIDMapBenchmark
+//     ./UUIDMapBenchmark
+//
+// Keys are random 64 bit integers like UUIDs, values are entity handles. Results
+// of both maps are compared before timing, so benchmark also checks UUIDMap
+// (including key 0) against std::unordered_map
+// ******************************************************************************
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Engine precompiled header and logger are not used by standalone program
+#define IK_CORE_ASSERT(x, ...) { if (!(x)) { std::fprintf(stderr, "Assertion failed: %s\n", #x); std::abort(); } }
+
+#include <iKan/Core/UUIDMap.h>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Time of function in nano seconds per operation, best of few runs
+    // ******************************************************************************
+    template<typename Function>
+    static double Measure(size_t numOperations, Function function)
+    {
+        double best = 1e30;
+        for (int run = 0; run < 5; run++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / (double)numOperations);
+        }
+        return best;
+    }
+
+    // ******************************************************************************
+    // Check UUIDMap against std::unordered_map with random inserts and erases
+    // ******************************************************************************
+    static void Validate(std::mt19937_64& random)
+    {
+        UUIDMap<uint32_t> map;
+        std::unordered_map<uint64_t, uint32_t> reference;
+
+        // Small range of keys so that keys (and 0) are erased and inserted again
+        for (uint32_t i = 0; i < 200000; i++)
+        {
+            uint64_t key = random() % 5000;
+            if (random() % 3 == 0)
+            {
+                bool erased = map.Erase(key);
+                IK_CORE_ASSERT(erased == (reference.erase(key) == 1), "Erase mismatch");
+            }
+            else
+            {
+                map[key] = i;
+                reference[key] = i;
+            }
+        }
+
+        IK_CORE_ASSERT(map.Size() == reference.size(), "Size mismatch");
+        for (uint64_t key = 0; key < 5000; key++)
+        {
+            const uint32_t* value = map.Find(key);
+            auto it = reference.find(key);
+            IK_CORE_ASSERT((value != nullptr) == (it != reference.end()), "Find mismatch");
+            IK_CORE_ASSERT(!value || *value == it->second, "Value mismatch");
+        }
+
+        map.Clear();
+        IK_CORE_ASSERT(map.Empty() && !map.Contains(0), "Clear failed");
+    }
+
+    // ******************************************************************************
+    // Time insert, find (hit and miss) and erase of count keys in both maps
+    // ******************************************************************************
+    static void Benchmark(std::mt19937_64& random, size_t count)
+    {
+        std::vector<uint64_t> keys(count), missingKeys(count);
+        for (auto& key : keys)
+            key = random() | 1;
+        for (auto& key : missingKeys)
+            key = random() & ~1ull;
+
+        volatile uint64_t sink = 0;
+        double uuidMap[4], unorderedMap[4];
+
+        {
+            UUIDMap<uint32_t> map;
+            uuidMap[0] = Measure(count, [&]() {
+                map.Clear();
+                map.Reserve(count);
+                for (size_t i = 0; i < count; i++)
+                    map[keys[i]] = (uint32_t)i;
+            });
+            uuidMap[1] = Measure(count, [&]() {
+                uint64_t sum = 0;
+                for (uint64_t key : keys)
+                    sum += *map.Find(key);
+                sink = sink + sum;
+            });
+            uuidMap[2] = Measure(count, [&]() {
+                uint64_t found = 0;
+                for (uint64_t key : missingKeys)
+                    found += map.Contains(key);
+                sink = sink + found;
+            });
+            uuidMap[3] = Measure(count, [&]() {
+                for (size_t i = 0; i < count; i++)
+                    map[keys[i]] = (uint32_t)i;
+                for (uint64_t key : keys)
+                    map.Erase(key);
+            });
+        }
+
+        {
+            std::unordered_map<uint64_t, uint32_t> map;
+            unorderedMap[0] = Measure(count, [&]() {
+                map.clear();
+                map.reserve(count);
+                for (size_t i = 0; i < count; i++)
+                    map[keys[i]] = (uint32_t)i;
+            });
+            unorderedMap[1] = Measure(count, [&]() {
+                uint64_t sum = 0;
+                for (uint64_t key : keys)
+                    sum += map.find(key)->second;
+                sink = sink + sum;
+            });
+            unorderedMap[2] = Measure(count, [&]() {
+                uint64_t found = 0;
+                for (uint64_t key : missingKeys)
+                    found += map.count(key);
+                sink = sink + found;
+            });
+            unorderedMap[3] = Measure(count, [&]() {
+                for (size_t i = 0; i < count; i++)
+                    map[keys[i]] = (uint32_t)i;
+                for (uint64_t key : keys)
+                    map.erase(key);
+            });
+        }
+
+        const char* names[] = { "Insert", "Find (hit)", "Find (miss)", "Insert + Erase" };
+        for (int i = 0; i < 4; i++)
+            std::printf("%9zu  %-15s  UUIDMap %7.2f ns  std::unordered_map %7.2f ns  (x%.2f)\n",
+                        count, names[i], uuidMap[i], unorderedMap[i], unorderedMap[i] / uuidMap[i]);
+    }
+
+}
+
+int main()
+{
+    std::mt19937_64 random(42);
+    iKan::Validate(random);
+
+    for (size_t count : { 1000, 100000, 1000000 })
+        iKan::Benchmark(random, count);
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <iKan/Core/Window.h>
 #include <iKan/Core/Layer.h>
 #include <iKan/Core/TimeStep.h>
+#include <iKan/Core/FileWatcher.h>
 #include <iKan/Core/Events/Event.h>
 #include <iKan/Core/Events/ApplicationEvent.h>
 #include <iKan/Core/Events/KeyEvent.h>
@@ -29,7 +30,10 @@
 #include <iKan/Renderer/VertexArray.h>
 #include <iKan/Renderer/FrameBuffer.h>
 #include <iKan/Renderer/Shader.h>
+#include <iKan/Renderer/Material.h>
+#include <iKan/Renderer/Font.h>
 #include <iKan/Renderer/Texture.h>
+#include <iKan/Renderer/TextureMemory.h>
 #include <iKan/Renderer/Camera.h>
 
 // Editor files
@@ -43,6 +47,8 @@
 #include <iKan/Scene/Component.h>
 #include <iKan/Scene/Viewport.h>
 #include <iKan/Scene/SceneSerializer.h>
+#include <iKan/Scene/SceneJournal.h>
+#include <iKan/Scene/Prefab.h>
 #include <iKan/Scene/ScriptableEntity.h>
 
 // Imgui Files
@@ -9,6 +9,7 @@
 
 #include "Application.h"
 #include <iKan/Imgui/ImguiAPI.h>
+#include <iKan/Core/FileWatcher.h>
 
 namespace iKan {
     
@@ -34,6 +35,7 @@ namespace iKan {
     {
         IK_CORE_WARN("Destroying the application");
         Renderer::WaitAndRender();
+        FileWatcher::Shutdown();
     }
     
     // ******************************************************************************
@@ -75,6 +77,9 @@ namespace iKan {
         IK_CORE_INFO("-----------------------------     Entering Game loop   ---------------------------------");
         while (m_IsRunning)
         {
+            // Reload the assets changed on disk since last frame
+            FileWatcher::Update();
+            
             // Updating all the attached layer
             for (Ref<Layer> layer : m_Layerstack)
                 layer->OnUpdate(m_Window->GetTime());
@@ -0,0 +1,356 @@
+// ******************************************************************************
+// File         : AsyncLogSink.cpp
+// Description  : spd log sink that writes messages on background thread
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "AsyncLogSink.h"
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Next power of 2 of value, so that position is mapped to slot by mask
+    // ******************************************************************************
+    static uint64_t NextPowerOf2(uint64_t value)
+    {
+        uint64_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    // ******************************************************************************
+    // Async log sink constructor. Starts the background thread
+    // ******************************************************************************
+    AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity, spdlog::level::level_enum flushLevel,
+                               spdlog::level::level_enum syncLevel, std::chrono::milliseconds flushInterval)
+    : m_Sinks(std::move(sinks)), m_FlushLevel(flushLevel), m_SyncLevel(syncLevel), m_FlushInterval(flushInterval)
+    {
+        uint64_t numSlots = NextPowerOf2(std::max<uint64_t>(capacity, 2));
+        m_Slots = std::make_unique<Slot[]>(numSlots);
+        m_Mask  = numSlots - 1;
+        for (uint64_t i = 0; i < numSlots; i++)
+            m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+        m_Thread = std::thread(&AsyncLogSink::Run, this);
+    }
+
+    // ******************************************************************************
+    // Async log sink destructor
+    // ******************************************************************************
+    AsyncLogSink::~AsyncLogSink()
+    {
+        Stop();
+    }
+
+    // ******************************************************************************
+    // Copy the message in ring buffer. Long message is copied in consecutive slots,
+    // position is of the last one. Returns false if buffer is full
+    // ******************************************************************************
+    bool AsyncLogSink::Push(const spdlog::details::log_msg& msg, uint64_t& position)
+    {
+        size_t size       = std::min<size_t>(msg.payload.size(), (m_Mask + 1) * s_SlotPayloadSize);
+        uint64_t numSlots = std::max<uint64_t>(1, (size + s_SlotPayloadSize - 1) / s_SlotPayloadSize);
+
+        uint64_t first = m_WritePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            // Slots are freed in order, so all the slots are free if the last one is
+            uint64_t last = first + numSlots - 1;
+            int64_t difference = (int64_t)m_Slots[last & m_Mask].Sequence.load(std::memory_order_acquire) - (int64_t)last;
+            if (difference == 0)
+            {
+                if (m_WritePosition.compare_exchange_weak(first, first + numSlots, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                first = m_WritePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t nameSize = std::min<size_t>(msg.logger_name.size(), s_MaxLoggerNameSize);
+        for (uint64_t i = 0; i < numSlots; i++)
+        {
+            Slot& slot = m_Slots[(first + i) & m_Mask];
+            size_t offset = i * s_SlotPayloadSize;
+
+            Message& message = slot.Msg;
+            message.Time  = msg.time;
+            message.Level = msg.level;
+            message.Size  = (uint16_t)std::min<size_t>(size - offset, s_SlotPayloadSize);
+            message.More  = i + 1 < numSlots;
+            memcpy(message.Payload, msg.payload.data() + offset, message.Size);
+            memcpy(message.LoggerName, msg.logger_name.data(), nameSize);
+            message.LoggerName[nameSize] = '\0';
+
+            slot.Sequence.store(first + i + 1, std::memory_order_release);
+        }
+
+        position = first + numSlots - 1;
+        return true;
+    }
+
+    // ******************************************************************************
+    // Take the oldest message out of ring buffer. Only background thread pops
+    // ******************************************************************************
+    bool AsyncLogSink::Pop(Message& message)
+    {
+        Slot& slot = m_Slots[m_ReadPosition & m_Mask];
+        if (slot.Sequence.load(std::memory_order_acquire) != m_ReadPosition + 1)
+            return false;
+
+        message = slot.Msg;
+        slot.Sequence.store(m_ReadPosition + m_Mask + 1, std::memory_order_release);
+        m_ReadPosition++;
+        return true;
+    }
+
+    // ******************************************************************************
+    // Check if oldest message is ready to read
+    // ******************************************************************************
+    bool AsyncLogSink::HasMessage() const
+    {
+        return m_Slots[m_ReadPosition & m_Mask].Sequence.load(std::memory_order_acquire) == m_ReadPosition + 1;
+    }
+
+    // ******************************************************************************
+    // Log the message. Returns as soon as message is in buffer, unless it is of sync
+    // level
+    // ******************************************************************************
+    void AsyncLogSink::log(const spdlog::details::log_msg& msg)
+    {
+        m_ActiveProducers.fetch_add(1);
+
+        uint64_t position = 0;
+        bool buffered = false;
+        while (!buffered && m_Running.load())
+        {
+            if (Push(msg, position))
+            {
+                Wake();
+
+                // Wait till message is on disk
+                if (msg.level >= m_SyncLevel)
+                    while (m_FlushedPosition.load(std::memory_order_acquire) <= position && m_Running.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                buffered = true;
+            }
+            else if (msg.level < spdlog::level::warn)
+            {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                buffered = true;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        m_ActiveProducers.fetch_sub(1);
+        if (buffered)
+            return;
+
+        // Thread is stopped
+        std::scoped_lock lock(m_SinkMutex);
+        for (auto& sink : m_Sinks)
+            if (sink->should_log(msg.level))
+                sink->log(msg);
+    }
+
+    // ******************************************************************************
+    // Flush is done by background thread
+    // ******************************************************************************
+    void AsyncLogSink::flush()
+    {
+        if (m_Running.load(std::memory_order_acquire))
+        {
+            m_FlushRequested.store(true, std::memory_order_release);
+            Wake();
+            return;
+        }
+
+        std::scoped_lock lock(m_SinkMutex);
+        FlushSinks();
+    }
+
+    // ******************************************************************************
+    // Pattern is applied to all the wrapped sinks
+    // ******************************************************************************
+    void AsyncLogSink::set_pattern(const std::string& pattern)
+    {
+        std::scoped_lock lock(m_SinkMutex);
+        for (auto& sink : m_Sinks)
+            sink->set_pattern(pattern);
+    }
+
+    // ******************************************************************************
+    // Formatter is applied to all the wrapped sinks
+    // ******************************************************************************
+    void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+    {
+        std::scoped_lock lock(m_SinkMutex);
+        for (auto& sink : m_Sinks)
+            sink->set_formatter(formatter->clone());
+    }
+
+    // ******************************************************************************
+    // Write the message to all the sinks
+    // ******************************************************************************
+    void AsyncLogSink::Write(const Message& message, spdlog::string_view_t payload)
+    {
+        spdlog::details::log_msg msg(message.Time, spdlog::source_loc{}, spdlog::string_view_t(message.LoggerName), message.Level, payload);
+        for (auto& sink : m_Sinks)
+            if (sink->should_log(msg.level))
+                sink->log(msg);
+    }
+
+    // ******************************************************************************
+    // Flush all the sinks
+    // ******************************************************************************
+    void AsyncLogSink::FlushSinks()
+    {
+        for (auto& sink : m_Sinks)
+            sink->flush();
+    }
+
+    // ******************************************************************************
+    // Wake the background thread if it is waiting for message
+    // ******************************************************************************
+    void AsyncLogSink::Wake()
+    {
+        // Pairs with the fence in Run, either background thread sees the message or
+        // producer sees that thread is waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Waiting.load(std::memory_order_relaxed))
+        {
+            std::scoped_lock lock(m_WakeMutex);
+            m_WakeCondition.notify_one();
+        }
+    }
+
+    // ******************************************************************************
+    // Write all the messages in buffer and the count of dropped ones. Parts of long
+    // message are joined before writing. Returns the number of messages written
+    // ******************************************************************************
+    uint32_t AsyncLogSink::WritePending(bool& flush)
+    {
+        uint32_t numWritten = 0;
+
+        Message message;
+        while (Pop(message))
+        {
+            if (message.More || !m_LongPayload.empty())
+            {
+                m_LongPayload.append(message.Payload, message.Size);
+                if (message.More)
+                    continue;
+
+                Write(message, spdlog::string_view_t(m_LongPayload));
+                m_LongPayload.clear();
+            }
+            else
+            {
+                Write(message, spdlog::string_view_t(message.Payload, message.Size));
+            }
+
+            flush |= message.Level >= m_FlushLevel || message.Level >= m_SyncLevel;
+            numWritten++;
+        }
+
+        if (uint64_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed))
+        {
+            std::string text = std::to_string(dropped) + " log messages are dropped as log buffer is full";
+            spdlog::details::log_msg msg(spdlog::source_loc{}, spdlog::string_view_t("iKAN"), spdlog::level::warn, spdlog::string_view_t(text));
+            for (auto& sink : m_Sinks)
+                sink->log(msg);
+            numWritten++;
+        }
+        return numWritten;
+    }
+
+    // ******************************************************************************
+    // Background thread. Writes the messages till sink is stopped and buffer is empty.
+    // Waits on condition variable while there is no message, at most flush interval
+    // so that pending messages are flushed in time
+    // ******************************************************************************
+    void AsyncLogSink::Run()
+    {
+        auto lastFlush = std::chrono::steady_clock::now();
+        bool pending   = false;
+
+        while (true)
+        {
+            bool running = m_Running.load(std::memory_order_acquire);
+            bool flush   = m_FlushRequested.exchange(false, std::memory_order_acq_rel);
+
+            uint32_t numWritten = 0;
+            {
+                std::scoped_lock lock(m_SinkMutex);
+                numWritten = WritePending(flush);
+
+                pending |= numWritten > 0;
+                auto now = std::chrono::steady_clock::now();
+                if (pending && (flush || !running || now - lastFlush >= m_FlushInterval))
+                {
+                    FlushSinks();
+                    pending   = false;
+                    lastFlush = now;
+                }
+            }
+
+            // Messages of sync level always flush, so their callers can return now
+            m_FlushedPosition.store(m_ReadPosition, std::memory_order_release);
+
+            if (!running && numWritten == 0)
+                break;
+
+            if (numWritten == 0)
+            {
+                std::unique_lock lock(m_WakeMutex);
+                m_Waiting.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_WakeCondition.wait_for(lock, m_FlushInterval, [this]() {
+                    return HasMessage() || m_FlushRequested.load(std::memory_order_acquire) || !m_Running.load(std::memory_order_acquire);
+                });
+                m_Waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // ******************************************************************************
+    // Stop the background thread once all the messages are written. Messages pushed
+    // after the last look of thread at buffer are written here
+    // ******************************************************************************
+    void AsyncLogSink::Stop()
+    {
+        if (!m_Running.exchange(false))
+            return;
+
+        {
+            std::scoped_lock lock(m_WakeMutex);
+            m_WakeCondition.notify_one();
+        }
+
+        if (m_Thread.joinable())
+            m_Thread.join();
+
+        // Producers that saw the thread running finish their push
+        while (m_ActiveProducers.load() > 0)
+            std::this_thread::yield();
+
+        std::scoped_lock lock(m_SinkMutex);
+        bool flush = true;
+        WritePending(flush);
+        FlushSinks();
+        m_FlushedPosition.store(m_ReadPosition, std::memory_order_release);
+    }
+
+}
@@ -0,0 +1,124 @@
+// ******************************************************************************
+// File         : AsyncLogSink.h
+// Description  : spd log sink that writes messages on background thread
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <spdlog/sinks/sink.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Sink that puts the messages in a lock free ring buffer and returns. Messages
+    // are written to the wrapped sinks by a background thread.
+    // - Sinks are flushed when a message of flush level or above is written, and
+    //   every flush interval.
+    // - Caller of message of sync level or above waits till its message is written
+    //   and flushed, so message of assert is on disk before program stops.
+    // - When buffer is full, messages below warning are dropped (and counted),
+    //   others wait for the space.
+    // - Message longer than payload of a slot takes consecutive slots.
+    // - Background thread sleeps on condition variable while buffer is empty.
+    // ******************************************************************************
+    class AsyncLogSink : public spdlog::sinks::sink
+    {
+    public:
+        AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity, spdlog::level::level_enum flushLevel,
+                     spdlog::level::level_enum syncLevel, std::chrono::milliseconds flushInterval);
+        virtual ~AsyncLogSink();
+
+        AsyncLogSink(const AsyncLogSink&) = delete;
+        AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+        virtual void log(const spdlog::details::log_msg& msg) override;
+        virtual void flush() override;
+        virtual void set_pattern(const std::string& pattern) override;
+        virtual void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+        // Write the pending messages and stop the background thread. Messages after
+        // this are written directly
+        void Stop();
+
+    private:
+        // Longer messages take more slots, they are cut only if they do not fit in
+        // whole buffer
+        static constexpr uint32_t s_SlotPayloadSize   = 480;
+        static constexpr uint32_t s_MaxLoggerNameSize = 15;
+
+        // ******************************************************************************
+        // Copy of message (or of its part) in ring buffer
+        // ******************************************************************************
+        struct Message
+        {
+            spdlog::log_clock::time_point Time;
+            spdlog::level::level_enum Level;
+            uint16_t Size;
+            bool More; // Payload continues in next slot
+            char LoggerName[s_MaxLoggerNameSize + 1];
+            char Payload[s_SlotPayloadSize];
+        };
+
+        // ******************************************************************************
+        // Slot of ring buffer. Sequence tells if slot is free to write (equal to write
+        // position) or ready to read (one more than write position)
+        // ******************************************************************************
+        struct Slot
+        {
+            std::atomic<uint64_t> Sequence;
+            Message Msg;
+        };
+
+        bool Push(const spdlog::details::log_msg& msg, uint64_t& position);
+        bool Pop(Message& message);
+        bool HasMessage() const;
+        uint32_t WritePending(bool& flush);
+        void Write(const Message& message, spdlog::string_view_t payload);
+        void FlushSinks();
+        void Wake();
+        void Run();
+
+    private:
+        std::vector<spdlog::sink_ptr> m_Sinks;
+        spdlog::level::level_enum m_FlushLevel, m_SyncLevel;
+        std::chrono::milliseconds m_FlushInterval;
+
+        std::unique_ptr<Slot[]> m_Slots;
+        uint64_t m_Mask;
+
+        // Producers claim the write position, only background thread reads
+        alignas(64) std::atomic<uint64_t> m_WritePosition = 0;
+        alignas(64) uint64_t m_ReadPosition = 0;
+
+        // Messages before this position are written and flushed
+        std::atomic<uint64_t> m_FlushedPosition = 0;
+        std::atomic<uint64_t> m_Dropped = 0;
+        std::atomic<bool> m_FlushRequested = false;
+
+        // Parts of long message read till now (background thread only)
+        std::string m_LongPayload;
+
+        // Background thread waits here while there is no message
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        std::atomic<bool> m_Waiting = false;
+
+        // Producers that are putting message in buffer. Stop writes their messages
+        // once they are done
+        std::atomic<uint32_t> m_ActiveProducers = 0;
+
+        // Sinks are used directly once thread is stopped
+        std::mutex m_SinkMutex;
+        std::atomic<bool> m_Running = true;
+        std::thread m_Thread;
+    };
+
+}
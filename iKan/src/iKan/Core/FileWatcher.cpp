@@ -0,0 +1,270 @@
+// ******************************************************************************
+// File         : FileWatcher.cpp
+// Description  : Watch asset files for changes on background thread
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "FileWatcher.h"
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <set>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace iKan {
+    
+    // ******************************************************************************
+    // Stores the watched files and the changes collected by watcher thread
+    // ******************************************************************************
+    struct FileWatcherData
+    {
+        // ******************************************************************************
+        // Callback of one owner for a file
+        // ******************************************************************************
+        struct Watch
+        {
+            const void* Owner;
+            FileWatcher::Callback Callback;
+        };
+        
+        // Callbacks are only touched from main thread
+        std::unordered_map<std::string, std::vector<Watch>> Watches;
+        
+        // Shared with watcher thread
+        std::mutex Mutex;
+        std::set<std::string> WatchedFiles;
+        std::set<std::string> ChangedFiles;
+        std::atomic<bool> Running = false;
+        std::thread Thread;
+        
+#ifdef __linux__
+        int32_t InotifyFd = -1;
+        std::unordered_map<int32_t, std::string> WatchedDirectories;
+#endif
+    };
+    
+    // ******************************************************************************
+    // Data is created on first use and never deleted, as textures and shaders held
+    // in statics of client unwatch their files while statics are destroyed
+    // ******************************************************************************
+    static FileWatcherData& GetData()
+    {
+        static FileWatcherData* s_Data = new FileWatcherData();
+        return *s_Data;
+    }
+    
+    // ******************************************************************************
+    // Path is used as key so relative and absolute path of same file should match
+    // ******************************************************************************
+    static std::string NormalisePath(const std::string& path)
+    {
+        std::error_code error;
+        auto absolutePath = std::filesystem::absolute(path, error);
+        return error ? path : absolutePath.lexically_normal().string();
+    }
+    
+#ifdef __linux__
+    // ******************************************************************************
+    // Watch the directory of file, editors mostly save by renaming a temp file so
+    // watching the file itself would loose the watch after first save. Only written
+    // and closed or renamed files are changed, created file is still empty
+    // ******************************************************************************
+    static void WatchDirectory(const std::string& directory)
+    {
+        FileWatcherData& data = GetData();
+
+        for (const auto& [wd, watchedDirectory] : data.WatchedDirectories)
+            if (watchedDirectory == directory)
+                return;
+        
+        int32_t wd = inotify_add_watch(data.InotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0)
+            IK_CORE_WARN("Can not watch directory {0}", directory);
+        else
+            data.WatchedDirectories[wd] = directory;
+    }
+    
+    // ******************************************************************************
+    // Read inotify events and collect the changed files that are watched
+    // ******************************************************************************
+    static void WatchThread()
+    {
+        FileWatcherData& data = GetData();
+
+        alignas(inotify_event) char buffer[4096];
+        pollfd fd = { data.InotifyFd, POLLIN, 0 };
+        
+        while (data.Running)
+        {
+            if (poll(&fd, 1, 100) <= 0)
+                continue;
+            
+            ssize_t length = read(data.InotifyFd, buffer, sizeof(buffer));
+            
+            std::scoped_lock lock(data.Mutex);
+            for (char* ptr = buffer; length > 0 && ptr < buffer + length; )
+            {
+                const inotify_event* event = (const inotify_event*)ptr;
+                ptr += sizeof(inotify_event) + event->len;
+                
+                auto it = data.WatchedDirectories.find(event->wd);
+                if (it == data.WatchedDirectories.end() || event->len == 0)
+                    continue;
+                
+                std::string path = it->second + "/" + event->name;
+                if (data.WatchedFiles.find(path) != data.WatchedFiles.end())
+                    data.ChangedFiles.insert(path);
+            }
+        }
+    }
+#else
+    // ******************************************************************************
+    // Compare the modified time of watched files every half second
+    // ******************************************************************************
+    static void WatchThread()
+    {
+        FileWatcherData& data = GetData();
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;
+        while (data.Running)
+        {
+            std::set<std::string> files;
+            {
+                std::scoped_lock lock(data.Mutex);
+                files = data.WatchedFiles;
+            }
+            
+            for (const auto& file : files)
+            {
+                std::error_code error;
+                auto writeTime = std::filesystem::last_write_time(file, error);
+                if (error)
+                    continue;
+                
+                auto it = writeTimes.find(file);
+                if (it != writeTimes.end() && it->second != writeTime)
+                {
+                    std::scoped_lock lock(data.Mutex);
+                    data.ChangedFiles.insert(file);
+                }
+                writeTimes[file] = writeTime;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+    }
+#endif
+    
+    // ******************************************************************************
+    // Watch the file. Watcher thread starts on first watch
+    // ******************************************************************************
+    void FileWatcher::Watch(const std::string& path, const void* owner, const Callback& callback)
+    {
+        FileWatcherData& data = GetData();
+
+        std::string file = NormalisePath(path);
+        data.Watches[file].push_back({ owner, callback });
+        
+        std::scoped_lock lock(data.Mutex);
+        data.WatchedFiles.insert(file);
+        
+#ifdef __linux__
+        if (data.InotifyFd < 0)
+            data.InotifyFd = inotify_init1(IN_NONBLOCK);
+        WatchDirectory(std::filesystem::path(file).parent_path().string());
+#endif
+        
+        if (!data.Running)
+        {
+            IK_CORE_INFO("Starting the File Watcher thread");
+            data.Running = true;
+            data.Thread  = std::thread(WatchThread);
+        }
+    }
+    
+    // ******************************************************************************
+    // Remove all the watches of owner
+    // ******************************************************************************
+    void FileWatcher::Unwatch(const void* owner)
+    {
+        FileWatcherData& data = GetData();
+
+        for (auto it = data.Watches.begin(); it != data.Watches.end(); )
+        {
+            auto& watches = it->second;
+            watches.erase(std::remove_if(watches.begin(), watches.end(), [owner](const auto& watch) { return watch.Owner == owner; }), watches.end());
+            
+            if (watches.empty())
+            {
+                std::scoped_lock lock(data.Mutex);
+                data.WatchedFiles.erase(it->first);
+                it = data.Watches.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+    
+    // ******************************************************************************
+    // Call the callbacks of files changed since last update. Called from main thread
+    // once per frame
+    // ******************************************************************************
+    void FileWatcher::Update()
+    {
+        FileWatcherData& data = GetData();
+
+        std::set<std::string> changedFiles;
+        {
+            std::scoped_lock lock(data.Mutex);
+            if (data.ChangedFiles.empty())
+                return;
+            changedFiles.swap(data.ChangedFiles);
+        }
+        
+        for (const auto& file : changedFiles)
+        {
+            auto it = data.Watches.find(file);
+            if (it == data.Watches.end())
+                continue;
+            
+            IK_CORE_INFO("File {0} is changed, reloading", file);
+            
+            // Callback might add or remove watches so iterate on copy
+            auto watches = it->second;
+            for (const auto& watch : watches)
+                watch.Callback(file);
+        }
+    }
+    
+    // ******************************************************************************
+    // Stop the watcher thread
+    // ******************************************************************************
+    void FileWatcher::Shutdown()
+    {
+        FileWatcherData& data = GetData();
+
+        if (!data.Running)
+            return;
+        
+        IK_CORE_INFO("Stopping the File Watcher thread");
+        data.Running = false;
+        data.Thread.join();
+        
+#ifdef __linux__
+        close(data.InotifyFd);
+        data.InotifyFd = -1;
+        data.WatchedDirectories.clear();
+#endif
+    }
+    
+}
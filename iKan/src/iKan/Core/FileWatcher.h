@@ -0,0 +1,33 @@
+// ******************************************************************************
+// File         : FileWatcher.h
+// Description  : Watch asset files for changes on background thread
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+namespace iKan {
+    
+    // ******************************************************************************
+    // Watches files on a background thread (inotify on Linux, polling the modified
+    // time elsewhere). Changes are only collected there, callbacks are called from
+    // main thread in FileWatcher::Update() so that owner can not be destroyed while
+    // its callback is running
+    // ******************************************************************************
+    class FileWatcher
+    {
+    public:
+        using Callback = std::function<void(const std::string& path)>;
+        
+        // Owner is only used as key to remove all the watches of one object
+        static void Watch(const std::string& path, const void* owner, const Callback& callback);
+        static void Unwatch(const void* owner);
+        
+        static void Update();
+        static void Shutdown();
+    };
+    
+}
@@ -8,6 +8,7 @@
 // ******************************************************************************
 
 #include "Log.h"
+#include <iKan/Core/AsyncLogSink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
@@ -15,11 +16,13 @@ namespace iKan {
     
     std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
     std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
+    std::shared_ptr<AsyncLogSink> Log::s_AsyncSink;
     
     // ******************************************************************************
-    // Initialize the logger
+    // Initialize the logger. Both loggers share the sinks, in async mode they share
+    // the one background thread that writes to the sinks
     // ******************************************************************************
-    void Log::Init()
+    void Log::Init(const Config& config)
     {
         std::vector<spdlog::sink_ptr> logSinks;
         logSinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
@@ -28,17 +31,40 @@ namespace iKan {
         logSinks[0]->set_pattern("[%T:%e:%f] [%-8l] [%-4n] : %v");
         logSinks[1]->set_pattern("[%T:%e:%f] [%-8l] [%-4n] : %v");
 
+        // Flush is done by the async sink as per config
+        spdlog::level::level_enum flushLevel = config.FlushLevel;
+        if (config.Async)
+        {
+            s_AsyncSink = std::make_shared<AsyncLogSink>(std::move(logSinks), config.QueueSize, config.FlushLevel, config.SyncLevel, config.FlushInterval);
+            logSinks    = { s_AsyncSink };
+            flushLevel  = spdlog::level::off;
+        }
+
         s_CoreLogger = std::make_shared<spdlog::logger>("iKAN", begin(logSinks), end(logSinks));
         spdlog::register_logger(s_CoreLogger);
         
         s_CoreLogger->set_level(spdlog::level::trace);
-        s_CoreLogger->flush_on(spdlog::level::trace);
+        s_CoreLogger->flush_on(flushLevel);
         
         s_ClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
         spdlog::register_logger(s_ClientLogger);
         
         s_ClientLogger->set_level(spdlog::level::trace);
-        s_ClientLogger->flush_on(spdlog::level::trace);
+        s_ClientLogger->flush_on(flushLevel);
+    }
+    
+    // ******************************************************************************
+    // Shutdown the logger. Pending messages are written before returning
+    // ******************************************************************************
+    void Log::Shutdown()
+    {
+        if (s_AsyncSink)
+            s_AsyncSink->Stop();
+
+        if (s_CoreLogger)
+            s_CoreLogger->flush();
+        if (s_ClientLogger)
+            s_ClientLogger->flush();
     }
     
 }
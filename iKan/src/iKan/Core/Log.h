@@ -13,13 +13,40 @@
 
 namespace iKan {
     
+    class AsyncLogSink;
+
     // ******************************************************************************
     // Wrapper to Use spd logger
     // ******************************************************************************
     class Log
     {
     public:
-        static void Init();
+        // ******************************************************************************
+        // Configuration of loggers
+        // ******************************************************************************
+        struct Config
+        {
+            // Messages are written on background thread
+            bool Async = true;
+
+            // Number of messages that can wait to be written (Async only)
+            uint32_t QueueSize = 8192;
+
+            // Sinks are flushed on message of this level or above
+            spdlog::level::level_enum FlushLevel = spdlog::level::warn;
+
+            // Caller waits till message of this level or above is written (Async only)
+            spdlog::level::level_enum SyncLevel = spdlog::level::err;
+
+            // Sinks are flushed at least this often if there are messages (Async only)
+            std::chrono::milliseconds FlushInterval = std::chrono::milliseconds(1000);
+        };
+
+    public:
+        static void Init(const Config& config = Config());
+        
+        // Write the pending messages and stop the background thread
+        static void Shutdown();
         
         static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
         static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
@@ -27,24 +54,61 @@ namespace iKan {
     private:
         static std::shared_ptr<spdlog::logger> s_CoreLogger;
         static std::shared_ptr<spdlog::logger> s_ClientLogger;
+        static std::shared_ptr<AsyncLogSink> s_AsyncSink;
     };
     
 }
 
+// ******************************************************************************
+// Log levels lower than IK_LOG_LEVEL are removed at compile time, their arguments
+// are not evaluated
+// ******************************************************************************
+#define IK_LOG_LEVEL_TRACE    0
+#define IK_LOG_LEVEL_INFO     1
+#define IK_LOG_LEVEL_WARN     2
+#define IK_LOG_LEVEL_ERROR    3
+#define IK_LOG_LEVEL_CRITICAL 4
+
+#ifndef IK_LOG_LEVEL
+#define IK_LOG_LEVEL IK_LOG_LEVEL_TRACE
+#endif
+
 #ifdef IK_ENABLE_LOG
 /* Core log macros */
+#if IK_LOG_LEVEL <= IK_LOG_LEVEL_TRACE
 #define IK_CORE_TRACE(...)    ::iKan::Log::GetCoreLogger()->trace(__VA_ARGS__)
+#define IK_TRACE(...)         ::iKan::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+#define IK_CORE_TRACE(...)
+#define IK_TRACE(...)
+#endif
+
+#if IK_LOG_LEVEL <= IK_LOG_LEVEL_INFO
 #define IK_CORE_INFO(...)     ::iKan::Log::GetCoreLogger()->info(__VA_ARGS__)
+#define IK_INFO(...)          ::iKan::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+#define IK_CORE_INFO(...)
+#define IK_INFO(...)
+#endif
+
+#if IK_LOG_LEVEL <= IK_LOG_LEVEL_WARN
 #define IK_CORE_WARN(...)     ::iKan::Log::GetCoreLogger()->warn(__VA_ARGS__)
+#define IK_WARN(...)          ::iKan::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+#define IK_CORE_WARN(...)
+#define IK_WARN(...)
+#endif
+
+#if IK_LOG_LEVEL <= IK_LOG_LEVEL_ERROR
 #define IK_CORE_ERROR(...)    ::iKan::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define IK_CORE_CRITICAL(...) ::iKan::Log::GetCoreLogger()->critical(__VA_ARGS__)
+#define IK_ERROR(...)         ::iKan::Log::GetClientLogger()->error(__VA_ARGS__)
+#else
+#define IK_CORE_ERROR(...)
+#define IK_ERROR(...)
+#endif
 
-/* Client log macros */
-#define IK_TRACE(...)          ::iKan::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define IK_INFO(...)           ::iKan::Log::GetClientLogger()->info(__VA_ARGS__)
-#define IK_WARN(...)           ::iKan::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define IK_ERROR(...)          ::iKan::Log::GetClientLogger()->error(__VA_ARGS__)
-#define IK_CRITICAL(...)       ::iKan::Log::GetClientLogger()->critical(__VA_ARGS__)
+#define IK_CORE_CRITICAL(...) ::iKan::Log::GetCoreLogger()->critical(__VA_ARGS__)
+#define IK_CRITICAL(...)      ::iKan::Log::GetClientLogger()->critical(__VA_ARGS__)
 
 #else
 
@@ -0,0 +1,57 @@
+// ******************************************************************************
+// File         : MappedFile.cpp
+// Project      : iKan : Core
+// Description  : Read only memory mapped file
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Map the file. File descriptor is not needed once file is mapped
+    // ******************************************************************************
+    MappedFile::MappedFile(const std::string& path)
+    {
+        int32_t file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            IK_CORE_ERROR("Could not open file '{0}' for mapping", path);
+            return;
+        }
+
+        struct stat fileStat;
+        if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED)
+            {
+                m_Data = (const uint8_t*)data;
+                m_Size = (size_t)fileStat.st_size;
+            }
+            else
+            {
+                IK_CORE_ERROR("Could not map file '{0}'", path);
+            }
+        }
+        close(file);
+    }
+
+    // ******************************************************************************
+    // Unmap the file
+    // ******************************************************************************
+    MappedFile::~MappedFile()
+    {
+        if (m_Data)
+            munmap((void*)m_Data, m_Size);
+    }
+
+}
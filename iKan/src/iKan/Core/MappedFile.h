@@ -0,0 +1,38 @@
+// ******************************************************************************
+// File         : MappedFile.h
+// Project      : iKan : Core
+// Description  : Read only memory mapped file
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Maps the entire file in memory for reading. Pages are loaded by OS when they
+    // are touched, so data can be used in place without copying it to buffer.
+    // Mapping is released in destructor
+    // ******************************************************************************
+    class MappedFile
+    {
+    public:
+        MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool IsValid() const { return m_Data != nullptr; }
+
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+    };
+
+}
@@ -0,0 +1,152 @@
+// ******************************************************************************
+// File         : RefCountedSlots.h
+// Description  : Reference counted slots addressed by generational handles
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Book keeping of slots of a table. Client keeps its entries in its own array at
+    // IndexOf(handle). Handle has the index of slot in low bits and generation of
+    // slot in high bits. Generation is changed when slot is freed, so handles to
+    // freed (or reused) slot are stale and refused by every function. Generation
+    // wraps after 4096 reuses of one slot.
+    // Slot 0 is never allocated, so handle 0 means "No Slot"
+    // ******************************************************************************
+    class RefCountedSlots
+    {
+    public:
+        static constexpr uint32_t s_IndexBits     = 20;
+        static constexpr uint32_t s_IndexMask     = (1u << s_IndexBits) - 1;
+        static constexpr uint32_t s_GenerationMax = (1u << (32 - s_IndexBits)) - 1;
+
+        RefCountedSlots() { Clear(); }
+        ~RefCountedSlots() = default;
+
+        static uint32_t IndexOf(uint32_t handle) { return handle & s_IndexMask; }
+
+        // ******************************************************************************
+        // Allocate the slot, freed slots are reused first. New slot is live with no
+        // reference. Returns 0 if all the indices are used
+        // ******************************************************************************
+        uint32_t Allocate()
+        {
+            uint32_t index;
+            if (!m_FreeIndices.empty())
+            {
+                index = m_FreeIndices.back();
+                m_FreeIndices.pop_back();
+            }
+            else
+            {
+                if (m_Slots.size() > s_IndexMask)
+                    return 0;
+
+                index = (uint32_t)m_Slots.size();
+                m_Slots.emplace_back();
+            }
+
+            Slot& slot    = m_Slots[index];
+            slot.Live     = true;
+            slot.RefCount = 0;
+            return MakeHandle(index, slot.Generation);
+        }
+
+        // ******************************************************************************
+        // Handle refers to live slot of its generation
+        // ******************************************************************************
+        bool IsValid(uint32_t handle) const
+        {
+            uint32_t index = IndexOf(handle);
+            if (index == 0 || index >= m_Slots.size())
+                return false;
+
+            const Slot& slot = m_Slots[index];
+            return slot.Live && MakeHandle(index, slot.Generation) == handle;
+        }
+
+        // ******************************************************************************
+        // Add the reference. Stale handles and freed slots are refused
+        // ******************************************************************************
+        bool Retain(uint32_t handle)
+        {
+            if (!IsValid(handle))
+                return false;
+
+            m_Slots[IndexOf(handle)].RefCount++;
+            return true;
+        }
+
+        // ******************************************************************************
+        // Remove the reference. Returns true if it was the last reference, slot is
+        // freed then and client should reset its entry
+        // ******************************************************************************
+        bool Release(uint32_t handle)
+        {
+            if (!IsValid(handle))
+                return false;
+
+            uint32_t index = IndexOf(handle);
+            Slot& slot = m_Slots[index];
+            if (slot.RefCount == 0 || --slot.RefCount > 0)
+                return false;
+
+            slot.Live       = false;
+            slot.Generation = (slot.Generation + 1) & s_GenerationMax;
+            m_FreeIndices.push_back(index);
+            return true;
+        }
+
+        uint32_t GetRefCount(uint32_t handle) const { return IsValid(handle) ? m_Slots[IndexOf(handle)].RefCount : 0; }
+
+        // Number of slots that client array needs (including slot 0)
+        uint32_t GetCapacity() const { return (uint32_t)m_Slots.size(); }
+        uint32_t GetNumLive() const { return (uint32_t)(m_Slots.size() - 1 - m_FreeIndices.size()); }
+        uint32_t GetNumFree() const { return (uint32_t)m_FreeIndices.size(); }
+
+        // ******************************************************************************
+        // Free all the slots. Generations are kept, so old handles stay stale
+        // ******************************************************************************
+        void Clear()
+        {
+            if (m_Slots.empty())
+                m_Slots.emplace_back();
+
+            m_FreeIndices.clear();
+            for (uint32_t index = (uint32_t)m_Slots.size() - 1; index > 0; index--)
+            {
+                Slot& slot = m_Slots[index];
+                if (slot.Live)
+                    slot.Generation = (slot.Generation + 1) & s_GenerationMax;
+
+                slot.Live     = false;
+                slot.RefCount = 0;
+                m_FreeIndices.push_back(index);
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint32_t Generation = 0;
+            uint32_t RefCount   = 0;
+            bool     Live       = false;
+        };
+
+        static uint32_t MakeHandle(uint32_t index, uint32_t generation) { return (generation << s_IndexBits) | index; }
+
+    private:
+        std::vector<Slot>     m_Slots;
+        std::vector<uint32_t> m_FreeIndices;
+    };
+
+}
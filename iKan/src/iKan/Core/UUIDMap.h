@@ -0,0 +1,216 @@
+// ******************************************************************************
+// File         : UUIDMap.h
+// Description  : Flat open addressing hash map with UUID as key
+// Project      : iKan : Core
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <iKan/Core/UUID.h>
+#include <algorithm>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Hash map from UUID to Value, stored in one flat array of slots. Collision is
+    // resolved by linear probing and erase shifts the next slots back, so there are
+    // no tombstones and lookup stops at first empty slot.
+    // UUIDs are already random 64 bit integers (mt19937_64), so key itself is used
+    // as hash. UUID 0 marks the empty slot, so value of key 0 (IDComponent default)
+    // is stored out of the slots with its own occupied flag
+    // ******************************************************************************
+    template<typename Value>
+    class UUIDMap
+    {
+    public:
+        UUIDMap() = default;
+        ~UUIDMap() = default;
+
+        // ******************************************************************************
+        // Value of key, default value is inserted if key is not present
+        // ******************************************************************************
+        Value& operator[](uint64_t key)
+        {
+            if (key == s_EmptyKey)
+            {
+                if (!m_HasEmptyKey)
+                {
+                    m_HasEmptyKey = true;
+                    m_Size++;
+                }
+                return m_EmptyKeyVal;
+            }
+
+            if ((m_Size + 1) * s_MaxLoadDen > m_Slots.size() * s_MaxLoadNum)
+                Rehash(std::max(s_MinCapacity, m_Slots.size() * 2));
+
+            for (size_t i = IndexOf(key);; i = (i + 1) & m_Mask)
+            {
+                Slot& slot = m_Slots[i];
+                if (slot.Key == key)
+                    return slot.Val;
+
+                if (slot.Key == s_EmptyKey)
+                {
+                    slot.Key = key;
+                    m_Size++;
+                    return slot.Val;
+                }
+            }
+        }
+
+        // ******************************************************************************
+        // Value of key, null if key is not present
+        // ******************************************************************************
+        Value* Find(uint64_t key)
+        {
+            return const_cast<Value*>(static_cast<const UUIDMap*>(this)->Find(key));
+        }
+
+        const Value* Find(uint64_t key) const
+        {
+            if (key == s_EmptyKey)
+                return m_HasEmptyKey ? &m_EmptyKeyVal : nullptr;
+
+            if (m_Slots.empty())
+                return nullptr;
+
+            for (size_t i = IndexOf(key);; i = (i + 1) & m_Mask)
+            {
+                const Slot& slot = m_Slots[i];
+                if (slot.Key == key)
+                    return &slot.Val;
+
+                if (slot.Key == s_EmptyKey)
+                    return nullptr;
+            }
+        }
+
+        bool Contains(uint64_t key) const { return Find(key) != nullptr; }
+
+        // ******************************************************************************
+        // Erase the key. Slots after it that are away from their home slot are moved
+        // back to fill the hole. Returns false if key is not present
+        // ******************************************************************************
+        bool Erase(uint64_t key)
+        {
+            if (key == s_EmptyKey)
+            {
+                if (!m_HasEmptyKey)
+                    return false;
+
+                m_HasEmptyKey = false;
+                m_EmptyKeyVal = Value();
+                m_Size--;
+                return true;
+            }
+
+            if (m_Slots.empty())
+                return false;
+
+            size_t hole = IndexOf(key);
+            while (m_Slots[hole].Key != key)
+            {
+                if (m_Slots[hole].Key == s_EmptyKey)
+                    return false;
+                hole = (hole + 1) & m_Mask;
+            }
+
+            for (size_t i = (hole + 1) & m_Mask; m_Slots[i].Key != s_EmptyKey; i = (i + 1) & m_Mask)
+            {
+                // Slot stays if its home is in between hole and slot (cyclic)
+                size_t home = IndexOf(m_Slots[i].Key);
+                bool inBetween = (hole <= i) ? (hole < home && home <= i) : (hole < home || home <= i);
+                if (inBetween)
+                    continue;
+
+                m_Slots[hole] = std::move(m_Slots[i]);
+                hole = i;
+            }
+
+            m_Slots[hole] = Slot();
+            m_Size--;
+            return true;
+        }
+
+        // ******************************************************************************
+        // Allocate the slots for count keys, so that inserting them does not rehash
+        // ******************************************************************************
+        void Reserve(size_t count)
+        {
+            size_t capacity = s_MinCapacity;
+            while (capacity * s_MaxLoadNum < count * s_MaxLoadDen)
+                capacity *= 2;
+
+            if (capacity > m_Slots.size())
+                Rehash(capacity);
+        }
+
+        // ******************************************************************************
+        // Remove all the keys, slots are kept for next inserts
+        // ******************************************************************************
+        void Clear()
+        {
+            std::fill(m_Slots.begin(), m_Slots.end(), Slot());
+            m_HasEmptyKey = false;
+            m_EmptyKeyVal = Value();
+            m_Size = 0;
+        }
+
+        size_t Size() const { return m_Size; }
+        bool Empty() const { return m_Size == 0; }
+
+    private:
+        struct Slot
+        {
+            uint64_t Key = s_EmptyKey;
+            Value    Val = {};
+        };
+
+        // ******************************************************************************
+        // Home slot of key. High bits are folded in case IDs only differ in them
+        // ******************************************************************************
+        size_t IndexOf(uint64_t key) const { return (size_t)(key ^ (key >> 32)) & m_Mask; }
+
+        // ******************************************************************************
+        // Move all the keys to new slots. Capacity is power of 2
+        // ******************************************************************************
+        void Rehash(size_t capacity)
+        {
+            std::vector<Slot> oldSlots(capacity);
+            m_Slots.swap(oldSlots);
+            m_Mask = capacity - 1;
+
+            for (auto& oldSlot : oldSlots)
+            {
+                if (oldSlot.Key == s_EmptyKey)
+                    continue;
+
+                size_t i = IndexOf(oldSlot.Key);
+                while (m_Slots[i].Key != s_EmptyKey)
+                    i = (i + 1) & m_Mask;
+                m_Slots[i] = std::move(oldSlot);
+            }
+        }
+
+    private:
+        static constexpr uint64_t s_EmptyKey    = 0;
+        static constexpr size_t   s_MinCapacity = 16;
+
+        // Maximum load factor (3 / 4), keeps probe chains of linear probing short
+        static constexpr size_t   s_MaxLoadNum  = 3;
+        static constexpr size_t   s_MaxLoadDen  = 4;
+
+        std::vector<Slot> m_Slots;
+        size_t            m_Mask = 0;
+        size_t            m_Size = 0;
+
+        // Key 0 can not be in slots
+        bool              m_HasEmptyKey = false;
+        Value             m_EmptyKeyVal = {};
+    };
+
+}
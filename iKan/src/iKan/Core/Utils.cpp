@@ -167,4 +167,18 @@ namespace iKan {
         return -1;
     }
 
+    // ******************************************************************************
+    // FNV-1a hash of data
+    // ******************************************************************************
+    uint64_t Utils::Hash(const void* data, size_t size, uint64_t hash)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
 }
@@ -30,6 +30,11 @@ namespace iKan {
         
         static int32_t GetFirstSetBit(uint32_t value);
 
+        // FNV-1a hash, same across the launches and standard libraries (for keys of
+        // files cached on disk). Pass the previous hash to continue hashing
+        static constexpr uint64_t s_HashOffset = 14695981039346656037ull;
+        static uint64_t Hash(const void* data, size_t size, uint64_t hash = s_HashOffset);
+
     };
 
 }
@@ -29,6 +29,9 @@ namespace iKan {
         
         if (entity.HasComponent<T>())
         {
+            // State before the edit is kept in journal till edit is committed
+            entity.GetScene()->GetJournal().Track<T>(entity);
+
             auto& component               = entity.GetComponent<T>();
             ImVec2 contentRegionAvailable = ImGui::GetContentRegionAvail();
             
@@ -218,15 +221,25 @@ namespace iKan {
             ImGui::Separator();
         }
         
+        SceneJournal& journal = m_Context->GetJournal();
         if (entity.HasComponent<TagComponent>())
         {
+            journal.Track<TagComponent>(entity);
             auto& tag = entity.GetComponent<TagComponent>().Tag;
             PropertyGrid::String("Tag", tag, 100.0f);
             ImGui::Separator();
         }
 
+        // Components shared from prefab are not shown, added component overrides them
+        if (entity.HasComponent<PrefabComponent>())
+        {
+            PropertyGrid::String("Prefab", entity.GetComponent<PrefabComponent>().Source->GetName(), "Components not added to entity are shared from prefab", 100.0f);
+            ImGui::Separator();
+        }
+
         if (entity.HasComponent<AABBColloiderComponent>())
         {
+            journal.Track<AABBColloiderComponent>(entity);
             auto& isRigid = entity.GetComponent<AABBColloiderComponent>().IsRigid;
             PropertyGrid::CheckBox("Is Rigid", isRigid, 100.0f);
             ImGui::Separator();
@@ -337,7 +350,7 @@ namespace iKan {
 
             ImGui::SetColumnWidth(0, 100);
 
-            size_t texId = ((src.Texture.Component) ? src.Texture.Component->GetRendererID() : ((src.SubTexComp) ? src.SubTexComp->GetTexture()->GetRendererID() : m_DefaultTexture->GetRendererID()));
+            size_t texId = ((src.Texture.Component) ? src.Texture.Component->GetRendererID() : ((src.SubTexComp) ? SubTexture::Get(src.SubTexComp).GetTexture()->GetRendererID() : m_DefaultTexture->GetRendererID()));
             ImGui::Image((void*)texId, ImVec2(40.0f, 40.0f), ImVec2(0, 1), ImVec2(1, 0), ImVec4(1.0f,1.0f,1.0f,1.0f), ImVec4(1.0f,1.0f,1.0f,0.5f));
             if (ImGui::IsItemClicked((int32_t)MouseCode::ButtonRight))
                 ImGui::OpenPopup("Select Texture");
@@ -375,7 +388,7 @@ namespace iKan {
                     }
                 }
 
-                if (ImGui::MenuItem("Remove Texture", nullptr, false, ((src.Texture.Component != nullptr) || (src.SubTexComp != nullptr))))
+                if (ImGui::MenuItem("Remove Texture", nullptr, false, ((src.Texture.Component != nullptr) || (src.SubTexComp != 0))))
                 {
                     src.ResetAllComponents();
                 }
@@ -408,10 +421,13 @@ namespace iKan {
                 static ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Selected | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_AllowItemOverlap;
                 if (ImGui::TreeNodeEx((void*)99298273, flags, "Sub Texture Compinent"))
                 {
-                    // Subtexture property
-                    glm::vec2& coords     = src.SubTexComp->GetCoords();
-                    glm::vec2& spriteSize = src.SubTexComp->GetSpriteSize();
-                    glm::vec2& cellSize   = src.SubTexComp->GetCellSize();
+                    // Subtexture property. Interned SubTexture is immutable so edit the copy and
+                    // intern the modified one
+                    const auto& subTexture = SubTexture::Get(src.SubTexComp);
+                    Ref<Texture> texture   = subTexture.GetTexture();
+                    glm::vec2 coords       = subTexture.GetCoords();
+                    glm::vec2 spriteSize   = subTexture.GetSpriteSize();
+                    glm::vec2 cellSize     = subTexture.GetCellSize();
 
                     // Sprite texture
                     bool opened = ImGui::TreeNodeEx((void*)99298273, ImGuiTreeNodeFlags_Selected | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_AllowItemOverlap, "Tile Image");
@@ -424,9 +440,9 @@ namespace iKan {
                         static float zoom = 6.0f;
                         PropertyGrid::Float("Zoom", zoom, nullptr);
 
-                        size_t texId    = src.SubTexComp->GetTexture()->GetRendererID();
-                        float texWidth  = (float)src.SubTexComp->GetTexture()->GetWidth();
-                        float texHeight = (float)src.SubTexComp->GetTexture()->GetHeight();
+                        size_t texId    = texture->GetRendererID();
+                        float texWidth  = (float)texture->GetWidth();
+                        float texHeight = (float)texture->GetHeight();
 
                         ImGui::Image((void*)texId, ImVec2(texWidth, texHeight), ImVec2(0, 1), ImVec2(1, 0), ImVec4(1.0f,1.0f,1.0f,1.0f), ImVec4(1.0f,1.0f,1.0f,0.5f));
 
@@ -465,7 +481,7 @@ namespace iKan {
                                 coords.x = (((regionX + regionFixedX)) / cellSize.x) - 1;
                                 coords.y = (((regionY + regionFixedX)) / cellSize.y) - 1;
 
-                                src.SubTexComp = SubTexture::CreateFromCoords(src.SubTexComp->GetTexture(), coords, spriteSize, cellSize);
+                                src.SubTexComp = SubTexture::CreateFromCoords(texture, coords, spriteSize, cellSize);
                             }
                             ImGui::EndTooltip();
                         }
@@ -478,7 +494,7 @@ namespace iKan {
                     bool modCellSize   = PropertyGrid::Float2("Cell Size", cellSize, nullptr);
 
                     if (modCoord || modSpriteSize || modCellSize)
-                        src.SubTexComp = SubTexture::CreateFromCoords(src.SubTexComp->GetTexture(), coords, spriteSize, cellSize);
+                        src.SubTexComp = SubTexture::CreateFromCoords(texture, coords, spriteSize, cellSize);
 
                     ImGui::Separator();
                     ImGui::TreePop();
@@ -538,6 +554,18 @@ namespace iKan {
             PropertyGrid::Float("Fade", cc.Fade, nullptr, 0.0001f);
         });
         
+        DrawComponent<TextRendererComponent>("Text Renderer", entity, [](auto& tc)
+                                             {
+            PropertyGrid::String("Text", tc.Text, 100.0f, 300.0f, nullptr, true, true, 3);
+            ImGui::ColorEdit4("Color", glm::value_ptr(tc.ColorComp), ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_NoLabel);
+            
+            PropertyGrid::String("Font", tc.Font ? tc.Font->GetPath() : "", "Drop the TTF file here from content browser pannel", 100.0f);
+            PropertyGrid::DropConent([&tc](const std::string& path)
+                                     {
+                tc.Font = Font::Create(path);
+            });
+        });
+        
     }
     
     // ******************************************************************************
@@ -549,7 +577,8 @@ namespace iKan {
         {
             if (ImGui::MenuItem("Camera"))
             {
-                m_SelectedEntity.AddComponent<CameraComponent>();
+                m_Context->GetJournal().Track<CameraComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<CameraComponent>();
                 ImGui::CloseCurrentPopup();
             }
         }
@@ -558,7 +587,8 @@ namespace iKan {
         {
             if (ImGui::MenuItem("Sprite Renderer"))
             {
-                m_SelectedEntity.AddComponent<SpriteRendererComponent>();
+                m_Context->GetJournal().Track<SpriteRendererComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<SpriteRendererComponent>();
                 ImGui::CloseCurrentPopup();
             }
         }
@@ -567,7 +597,8 @@ namespace iKan {
         {
             if (ImGui::MenuItem("Rigid Body 2D"))
             {
-                m_SelectedEntity.AddComponent<RigidBody2DComponent>();
+                m_Context->GetJournal().Track<RigidBody2DComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<RigidBody2DComponent>();
                 ImGui::CloseCurrentPopup();
             }
         }
@@ -576,7 +607,8 @@ namespace iKan {
         {
             if (ImGui::MenuItem("Box Colloider"))
             {
-                m_SelectedEntity.AddComponent<BoxColloider2DComponent>();
+                m_Context->GetJournal().Track<BoxColloider2DComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<BoxColloider2DComponent>();
                 ImGui::CloseCurrentPopup();
             }
         }
@@ -594,7 +626,18 @@ namespace iKan {
         {
             if (ImGui::MenuItem("Circle Component Script"))
             {
-                m_SelectedEntity.AddComponent<CircleRendererComponent>();
+                m_Context->GetJournal().Track<CircleRendererComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<CircleRendererComponent>();
+                ImGui::CloseCurrentPopup();
+            }
+        }
+        
+        if (!m_SelectedEntity.HasComponent<TextRendererComponent>())
+        {
+            if (ImGui::MenuItem("Text Renderer"))
+            {
+                m_Context->GetJournal().Track<TextRendererComponent>(m_SelectedEntity);
+                m_SelectedEntity.OverrideComponent<TextRendererComponent>();
                 ImGui::CloseCurrentPopup();
             }
         }
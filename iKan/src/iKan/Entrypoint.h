@@ -23,5 +23,9 @@ int main()
     // Application is created
     iKan::Scope<iKan::Application> app = iKan::CreateApplication();
     app->Run();
+    app.reset();
+
+    // Write the pending log messages
+    iKan::Log::Shutdown();
     return 0;
 }
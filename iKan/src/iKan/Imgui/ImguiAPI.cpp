@@ -128,7 +128,7 @@ namespace iKan {
     // ******************************************************************************
     // Renderer Stats
     // ******************************************************************************
-    void ImGuiAPI::RendererStats(bool *pIsOpen)
+    void ImGuiAPI::RendererStats(bool *pIsOpen, const TextureMemory::Usage* sceneTextures)
     {
         ImGui::Begin("Renderer Stats", pIsOpen);
 
@@ -148,6 +148,34 @@ namespace iKan {
         ImGui::Text("Texture Counts : %d", RendererStatistics::TextureCount);
 
         ImGui::Columns(1);
+        ImGui::Separator();
+
+        // Texture memory
+        static constexpr float MB = 1024.0f * 1024.0f;
+        TextureMemory::Usage usage = TextureMemory::GetUsage();
+
+        ImGui::Columns(4);
+
+        ImGui::Text("Texture GPU : %.2f MB", usage.GpuBytes / MB);
+        ImGui::NextColumn();
+
+        ImGui::Text("Texture CPU : %.2f MB", usage.CpuBytes / MB);
+        ImGui::NextColumn();
+
+        ImGui::Text("Resident : %d / %d", usage.NumResident, usage.NumTextures);
+        ImGui::NextColumn();
+
+        ImGui::Text("Evicted : %d", TextureMemory::GetNumEvicted());
+
+        ImGui::Columns(1);
+
+        if (sceneTextures)
+            ImGui::Text("Scene Textures : %d (GPU %.2f MB, CPU %.2f MB)", sceneTextures->NumTextures, sceneTextures->GpuBytes / MB, sceneTextures->CpuBytes / MB);
+
+        // 0 budget means no limit
+        int32_t budgetMB = (int32_t)(TextureMemory::GetGpuBudget() / (uint64_t)MB);
+        if (ImGui::DragInt("Texture GPU Budget (MB)", &budgetMB, 1.0f, 0, 8192))
+            TextureMemory::SetGpuBudget((uint64_t)budgetMB * (uint64_t)MB);
 
         ImGui::PopID();
 
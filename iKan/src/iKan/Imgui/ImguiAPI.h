@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <iKan/Renderer/TextureMemory.h>
+
 namespace iKan {
     
     class ImGuiAPI
@@ -19,7 +21,7 @@ namespace iKan {
         
         static void RendererVersion(bool *pIsOpen = nullptr);
         static void FrameRate(float ts, bool *pIsOpen = nullptr);
-        static void RendererStats(bool *pIsOpen = nullptr);
+        static void RendererStats(bool *pIsOpen = nullptr, const TextureMemory::Usage* sceneTextures = nullptr);
 
         static void ColorEdit(glm::vec4& colorRef);
         
@@ -135,4 +135,48 @@ namespace iKan {
         Renderer::Submit([this]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); });
     }
     
+    // ******************************************************************************
+    // Open GL Uniform Buffer Constructor
+    // ******************************************************************************
+    OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+    : m_Size(size), m_Binding(binding)
+    {
+        Renderer::Submit([this]()
+                         {
+            IK_CORE_INFO("Open GL Uniform Buffer constructed of size {0} at binding {1}", m_Size, m_Binding);
+            
+            glGenBuffers(1, &m_RendererId);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_RendererId);
+            glBufferData(GL_UNIFORM_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererId);
+        });
+    }
+    
+    // ******************************************************************************
+    // Open GL Uniform Buffer Destructor
+    // ******************************************************************************
+    OpenGLUniformBuffer::~OpenGLUniformBuffer()
+    {
+        Renderer::Submit([rendererId = m_RendererId]()
+                         {
+            IK_CORE_WARN("Open GL Uniform Buffer destroyed ...");
+            glDeleteBuffers(1, &rendererId);
+        });
+    }
+    
+    // ******************************************************************************
+    // Update the Open GL Uniform Buffer. Data is copied in the command so buffer can
+    // be updated multiple times in a frame
+    // ******************************************************************************
+    void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        IK_CORE_ASSERT(offset + size <= m_Size, "Uniform Buffer overflow!");
+        Renderer::Submit([this, offset, data = Buffer::Copy((void*)data, size)]() mutable
+                         {
+            glBindBuffer(GL_UNIFORM_BUFFER, m_RendererId);
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, data.Size, data.Data);
+            data.Clear();
+        });
+    }
+
 }
@@ -61,4 +61,24 @@ namespace iKan {
         uint32_t m_Count;
     };
 
+    // ******************************************************************************
+    // Implementation of Open GL Uniform Buffer
+    // ******************************************************************************
+    class OpenGLUniformBuffer : public UniformBuffer
+    {
+    public:
+        OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+        virtual ~OpenGLUniformBuffer();
+        
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        
+        virtual uint32_t GetBinding() const override { return m_Binding; }
+        virtual uint32_t GetRendererID() const override { return m_RendererId; }
+        
+    private:
+        uint32_t m_RendererId = 0;
+        uint32_t m_Size;
+        uint32_t m_Binding;
+    };
+
 }
@@ -9,14 +9,29 @@
 
 #include "OpenGLShader.h"
 #include <iKan/Renderer/Renderer.h>
+#include <iKan/Core/FileWatcher.h>
+#include <iKan/Platform/OpenGL/OpenGLShaderLexer.h>
 #include <glad/glad.h>
+#include <filesystem>
+#include <charconv>
+
+// From GL_KHR_parallel_shader_compile, same value as GL_COMPLETION_STATUS_ARB
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 namespace iKan {
+    
+    OpenGLShader* OpenGLShader::s_BoundShader = nullptr;
+    std::vector<OpenGLShader*> OpenGLShader::s_PendingShaders;
+    
+    // Directory to store the linked program binaries
+    static const std::string s_ShaderCacheDirectory = "../../../Cache/Shaders/";
 
     // ******************************************************************************
     // get the type of uniform is premitive or not
     // ******************************************************************************
-    static bool IsTypeStringResource(const std::string& type)
+    static bool IsTypeStringResource(std::string_view type)
     {
         if (type == "sampler2D")          return true;
         if (type == "sampler2DMS")        return true;
@@ -61,50 +76,105 @@ namespace iKan {
         m_Source[GL_VERTEX_SHADER]   = vertexSrc;
         m_Source[GL_FRAGMENT_SHADER] = fragmentSrc;
         
-        Compile();
+        Load();
     }
     
     // ******************************************************************************
     // Open GL Constructor
     // ******************************************************************************
-    OpenGLShader::OpenGLShader(const std::string& path)
-    : m_AssetPath(path)
+    OpenGLShader::OpenGLShader(const std::string& path, const std::vector<std::string>& defines)
+    : m_AssetPath(path), m_Defines(defines)
     {
         IK_CORE_INFO("Open GL Shader Constructed from path : {0}", path.c_str());
 
-        // Find the last '/' and extract the rest of the string
-        size_t found = path.find_last_of("/\\");
-        m_Name       = found != std::string::npos ? path.substr(found + 1) : path;
-
-        // Find the last '.' and extract the rest of the string
-        found  = m_Name.find_last_of(".");
-        m_Name = found != std::string::npos ? m_Name.substr(0, found) : m_Name;
+        // Extract the name. Each variant has its own name so that they are cached
+        // seperately
+        m_Name = Utils::GetNameFromFilePath(path);
+        for (const auto& define : m_Defines)
+            m_Name += "_" + define;
 
-        std::string source  = ReadFromFile(path);
+        std::vector<std::string> includedFiles;
+        std::string source  = ExpandIncludes(ReadFromFile(path), path, &includedFiles);
         m_Source            = PreprocessFile(source);
-        
-        // Extract the name
-        m_Name = Utils::GetNameFromFilePath(path);
 
+        Load();
+        
+        // Recompile in same shader instance so all the references stay valid
+        FileWatcher::Watch(m_AssetPath, this, [this](const std::string&) { Reload(); });
+        for (const auto& includedFile : includedFiles)
+            FileWatcher::Watch(includedFile, this, [this](const std::string&) { Reload(); });
+    }
+    
+    // ******************************************************************************
+    // Parse and compile the source. Reloaded shader replaces the program only if
+    // new source compiles
+    // ******************************************************************************
+    void OpenGLShader::Load()
+    {
         if (!m_IsCompute)
+        {
             Parse();
+            BuildUniformSlots();
+        }
 
+        // Uniforms are resolved once program is linked
         Compile();
 
-        if (!m_IsCompute)
-            ResolveUniforms();
-
         if (m_Loaded)
             for (auto& callback : m_ShaderReloadedCallbacks)
                 callback();
 
         m_Loaded = true;
     }
+    
+    // ******************************************************************************
+    // File is changed on disk, read and preprocess it again on worker thread
+    // ******************************************************************************
+    void OpenGLShader::Reload()
+    {
+        if (m_Reloading.valid())
+            m_Reloading.wait();
+        
+        m_Reloading = std::async(std::launch::async, [this]() { return PreprocessFile(ExpandIncludes(ReadFromFile(m_AssetPath), m_AssetPath)); });
+    }
+    
+    // ******************************************************************************
+    // Compile the reloaded source once preprocessing is done
+    // ******************************************************************************
+    void OpenGLShader::ApplyReloadIfReady()
+    {
+        if (!m_Reloading.valid() || m_Reloading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        
+        auto source = m_Reloading.get();
+        if (source.empty())
+            return;
+        
+        IK_CORE_INFO("Reloading Open GL Shader {0}", m_Name.c_str());
+        m_Source = std::move(source);
+        Load();
+    }
 
+    // ******************************************************************************
+    // Find the renderer uniform block declared in any stage by name
+    // ******************************************************************************
+    const ShaderUniformBufferDeclaration* OpenGLShader::FindRendererUniformBuffer(const std::string& name) const
+    {
+        for (const auto* buffer : m_VSRendererUniformBuffers)
+            if (buffer->GetName() == name)
+                return buffer;
+        
+        for (const auto* buffer : m_PSRendererUniformBuffers)
+            if (buffer->GetName() == name)
+                return buffer;
+        
+        return nullptr;
+    }
+    
     // ******************************************************************************
     // Find the structure from stored ones by name
     // ******************************************************************************
-    ShaderStruct* OpenGLShader::FindStruct(const std::string& name)
+    ShaderStruct* OpenGLShader::FindStruct(std::string_view name)
     {
         for (ShaderStruct* s : m_Structs)
             if (s->GetName() == name)
@@ -112,176 +182,295 @@ namespace iKan {
 
         return nullptr;
     }
+    
+    // ******************************************************************************
+    // Skip the precision qualifier if it is next token
+    // ******************************************************************************
+    static OpenGLShaderLexer::Token NextType(OpenGLShaderLexer& lexer)
+    {
+        OpenGLShaderLexer::Token token = lexer.Next();
+        if (token.Is("highp") || token.Is("mediump") || token.Is("lowp"))
+            token = lexer.Next();
+        return token;
+    }
+    
+    // ******************************************************************************
+    // Parse the "[count]" after name if present, returns 1 otherwise
+    // ******************************************************************************
+    static uint32_t ParseArrayCount(OpenGLShaderLexer& lexer)
+    {
+        if (!lexer.Accept('['))
+            return 1;
+        
+        uint32_t count = 1;
+        OpenGLShaderLexer::Token token = lexer.Next();
+        if (token.Kind == OpenGLShaderLexer::Token::Type::Number)
+            std::from_chars(token.Text.data(), token.Text.data() + token.Text.size(), count);
+        
+        if (!token.Is(']'))
+            lexer.SkipPast(']');
+        return count;
+    }
+    
+    // ******************************************************************************
+    // Parse the members "type name[count], name;" of struct or block till "}". "{" is
+    // already consumed. Callback is called for each member
+    // ******************************************************************************
+    template<typename Callback>
+    static void ParseMembers(OpenGLShaderLexer& lexer, Callback callback)
+    {
+        while (lexer.Peek().Kind != OpenGLShaderLexer::Token::Type::End && !lexer.Accept('}'))
+        {
+            OpenGLShaderLexer::Token type = NextType(lexer);
+            do
+            {
+                OpenGLShaderLexer::Token name = lexer.Next();
+                uint32_t count = ParseArrayCount(lexer);
+                if (type.Kind == OpenGLShaderLexer::Token::Type::Identifier && name.Kind == OpenGLShaderLexer::Token::Type::Identifier)
+                    callback(type.Text, name.Text, count);
+            } while (lexer.Accept(','));
+            lexer.SkipPast(';');
+        }
+    }
 
     // ******************************************************************************
-    // Psrse the compute shader
+    // Parse the shader sources and build the reflection. Declarations of previous
+    // parse are released
     // ******************************************************************************
     void OpenGLShader::Parse()
     {
-        const char* token;
-        const char* vstr;
-        const char* fstr;
-
         m_Resources.clear();
         m_Structs.clear();
 
-        m_VSMaterialUniformBuffer.reset();
-        m_PSMaterialUniformBuffer.reset();
-
-        auto& vertexSource   = m_Source[GL_VERTEX_SHADER];
-        auto& fragmentSource = m_Source[GL_FRAGMENT_SHADER];
-
-        // Vertex Shader
-        vstr = vertexSource.c_str();
-        while ((token = Utils::FindToken(vstr, "struct")))
-            ParseUniformStruct(Utils::GetBlock(token, &vstr), ShaderDomain::Vertex);
-
-        vstr = vertexSource.c_str();
-        while ((token = Utils::FindToken(vstr, "uniform")))
-            ParseUniform(Utils::GetStatement(token, &vstr), ShaderDomain::Vertex);
-
-        // Fragment Shader
-        fstr = fragmentSource.c_str();
-        while ((token = Utils::FindToken(fstr, "struct")))
-            ParseUniformStruct(Utils::GetBlock(token, &fstr), ShaderDomain::Pixel);
+        m_VSMaterialUniformBuffer = nullptr;
+        m_PSMaterialUniformBuffer = nullptr;
+        
+        m_VSRendererUniformBuffers.clear();
+        m_PSRendererUniformBuffers.clear();
+        
+        m_Reflection.Clear();
 
-        fstr = fragmentSource.c_str();
-        while ((token = Utils::FindToken(fstr, "uniform")))
-            ParseUniform(Utils::GetStatement(token, &fstr), ShaderDomain::Pixel);
+        ParseSource(m_Source[GL_VERTEX_SHADER], ShaderDomain::Vertex);
+        ParseSource(m_Source[GL_FRAGMENT_SHADER], ShaderDomain::Pixel);
     }
-
+    
     // ******************************************************************************
-    // Parse the uniforms, like uniform texture, sampler2D ...
+    // Parse the structs, uniform statements and uniform blocks of source in single
+    // pass. Only global scope is parsed, bodies of functions and interface blocks
+    // are skipped
     // ******************************************************************************
-    void OpenGLShader::ParseUniform(const std::string& statement, ShaderDomain domain)
+    void OpenGLShader::ParseSource(const std::string& source, ShaderDomain domain)
     {
-        std::vector<std::string> tokens = Utils::Tokenize(statement);
-        uint32_t index = 1; // 0th is for keyword unifrom
-
-        std::string typeString = tokens[index++];
-        std::string name = tokens[index++];
-
-        // Strip ; from name if present
-        if (const char* s = strstr(name.c_str(), ";"))
-            name = std::string(name.c_str(), s - name.c_str());
-
-        std::string n(name);
-        int32_t count = 1;
-        const char* namestr = n.c_str();
-        if (const char* s = strstr(namestr, "["))
+        OpenGLShaderLexer lexer(source);
+        for (OpenGLShaderLexer::Token token = lexer.Next(); token.Kind != OpenGLShaderLexer::Token::Type::End; token = lexer.Next())
         {
-            name = std::string(namestr, s - namestr);
-
-            const char* end = strstr(namestr, "]");
-            std::string c(s + 1, end - s);
-            count = atoi(c.c_str());
+            if (token.Is("struct"))
+                ParseUniformStruct(lexer, domain);
+            else if (token.Is("uniform"))
+                ParseUniform(lexer, domain);
+            else if (token.Is('{'))
+                lexer.SkipPast('}');
+        }
+    }
+    
+    // ******************************************************************************
+    // Parse the uniform block "uniform r_Name { ... };". Only renderer blocks are
+    // supported, their data comes from renderer uniform buffer. "{" is next token
+    // ******************************************************************************
+    void OpenGLShader::ParseUniformBlock(std::string_view name, OpenGLShaderLexer& lexer, ShaderDomain domain)
+    {
+        lexer.Accept('{');
+        if (Shader::GetRendererBlockBinding(std::string(name)) == -1)
+        {
+            IK_CORE_ERROR("Uniform block {0} in shader {1} is not a renderer block", std::string(name), m_Name);
+            lexer.SkipPast('}');
+            lexer.SkipPast(';');
+            return;
         }
+        
+        OpenGLShaderUniformBufferDeclaration* buffer = &m_Reflection.Buffers.emplace_back(std::string(name), domain);
+        ParseMembers(lexer, [&](std::string_view type, std::string_view uniformName, uint32_t count) {
+            OpenGLShaderUniformDeclaration::Type t = OpenGLShaderUniformDeclaration::StringToType(std::string(type));
+            if (t != OpenGLShaderUniformDeclaration::Type::NONE)
+            {
+                buffer->PushUniform(&m_Reflection.Uniforms.emplace_back(domain, t, std::string(uniformName), count));
+            }
+            else if (ShaderStruct* s = FindStruct(type))
+            {
+                // Array of struct like "Material r_MaterialInstances[64]"
+                buffer->PushUniform(&m_Reflection.Uniforms.emplace_back(domain, s, std::string(uniformName), count));
+            }
+            else
+            {
+                IK_CORE_ERROR("Unknown type {0} in uniform block {1} of shader {2}", std::string(type), std::string(name), m_Name);
+            }
+        });
+        
+        // Instance name of block if any
+        lexer.SkipPast(';');
+        
+        if (domain == ShaderDomain::Vertex)
+            m_VSRendererUniformBuffers.push_back(buffer);
+        else if (domain == ShaderDomain::Pixel)
+            m_PSRendererUniformBuffers.push_back(buffer);
+    }
 
-        if (IsTypeStringResource(typeString))
+    // ******************************************************************************
+    // Parse the uniforms, like uniform texture, sampler2D ... "uniform" is already
+    // consumed
+    // ******************************************************************************
+    void OpenGLShader::ParseUniform(OpenGLShaderLexer& lexer, ShaderDomain domain)
+    {
+        OpenGLShaderLexer::Token typeToken = NextType(lexer);
+        if (lexer.Peek().Is('{'))
         {
-            ShaderResourceDeclaration* declaration = new OpenGLShaderResourceDeclaration(OpenGLShaderResourceDeclaration::StringToType(typeString), name, count);
-            m_Resources.push_back(declaration);
+            ParseUniformBlock(typeToken.Text, lexer, domain);
+            return;
         }
-        else
+        
+        std::string typeString(typeToken.Text);
+        do
         {
+            OpenGLShaderLexer::Token nameToken = lexer.Next();
+            uint32_t count = ParseArrayCount(lexer);
+            std::string name(nameToken.Text);
+            
+            if (IsTypeStringResource(typeString))
+            {
+                ShaderResourceDeclaration* declaration = &m_Reflection.Resources.emplace_back(OpenGLShaderResourceDeclaration::StringToType(typeString), name, count);
+                m_Resources.push_back(declaration);
+                continue;
+            }
+            
             OpenGLShaderUniformDeclaration::Type t = OpenGLShaderUniformDeclaration::StringToType(typeString);
             OpenGLShaderUniformDeclaration* declaration = nullptr;
-
+            
             if (t == OpenGLShaderUniformDeclaration::Type::NONE)
             {
                 // Find struct
                 ShaderStruct* s = FindStruct(typeString);
                 IK_CORE_ASSERT(s, "");
-                declaration = new OpenGLShaderUniformDeclaration(domain, s, name, count);
+                declaration = &m_Reflection.Uniforms.emplace_back(domain, s, name, count);
             }
             else
             {
-                declaration = new OpenGLShaderUniformDeclaration(domain, t, name, count);
+                declaration = &m_Reflection.Uniforms.emplace_back(domain, t, name, count);
             }
-
+            
             if (Utils::StartsWith(name, "r_"))
             {
-                if (domain == ShaderDomain::Vertex)
-                    ((OpenGLShaderUniformBufferDeclaration*)m_VSRendererUniformBuffers.front())->PushUniform(declaration);
-                else if (domain == ShaderDomain::Pixel)
-                    ((OpenGLShaderUniformBufferDeclaration*)m_PSRendererUniformBuffers.front())->PushUniform(declaration);
+                // Renderer uniforms outside block are stored in unnamed buffer at front
+                auto& buffers = domain == ShaderDomain::Vertex ? m_VSRendererUniformBuffers : m_PSRendererUniformBuffers;
+                if (buffers.empty() || !buffers.front()->GetName().empty())
+                    buffers.insert(buffers.begin(), &m_Reflection.Buffers.emplace_back("", domain));
+                
+                ((OpenGLShaderUniformBufferDeclaration*)buffers.front())->PushUniform(declaration);
             }
             else
             {
-                if (domain == ShaderDomain::Vertex)
-                {
-                    if (!m_VSMaterialUniformBuffer)
-                        m_VSMaterialUniformBuffer.reset(new OpenGLShaderUniformBufferDeclaration("", domain));
-
-                    m_VSMaterialUniformBuffer->PushUniform(declaration);
-                }
-                else if (domain == ShaderDomain::Pixel)
-                {
-                    if (!m_PSMaterialUniformBuffer)
-                        m_PSMaterialUniformBuffer.reset(new OpenGLShaderUniformBufferDeclaration("", domain));
-
-                    m_PSMaterialUniformBuffer->PushUniform(declaration);
-                }
+                auto& buffer = domain == ShaderDomain::Vertex ? m_VSMaterialUniformBuffer : m_PSMaterialUniformBuffer;
+                if (!buffer)
+                    buffer = &m_Reflection.Buffers.emplace_back("", domain);
+                
+                buffer->PushUniform(declaration);
             }
-        }
+        } while (lexer.Accept(','));
+        
+        lexer.SkipPast(';');
     }
 
     // ******************************************************************************
-    // block  : struct block string "struct { ... }"
+    // Parse the struct "struct Name { ... };", "struct" is already consumed
     // domain : type of shader
     // ******************************************************************************
-    void OpenGLShader::ParseUniformStruct(const std::string& block, ShaderDomain domain)
+    void OpenGLShader::ParseUniformStruct(OpenGLShaderLexer& lexer, ShaderDomain domain)
     {
-        // get each word from the block and store them in vector
-        std::vector<std::string> tokens = Utils::Tokenize(block);
-
-        uint32_t index = 0;
-        index++;  // "struct"
-
-        std::string name = tokens[index++];
-        ShaderStruct* uniformStruct = new ShaderStruct(name);
-        index++;
-        while (index < tokens.size())
-        {
-            if (tokens[index] == "}")
-                break;
-
-            std::string type = tokens[index++];
-            std::string name = tokens[index++];
-
-            // Strip ; from name if present
-            if (const char* s = strstr(name.c_str(), ";"))
-                name = std::string(name.c_str(), s - name.c_str());
-
-            uint32_t count = 1;
-            const char* namestr = name.c_str();
-            if (const char* s = strstr(namestr, "["))
-            {
-                auto tempName = std::string(namestr, s - namestr);
-
-                const char* end = strstr(namestr, "]");
-                std::string c(s + 1, end - s);
-                count = atoi(c.c_str());
-
-                name = tempName;
-            }
-            ShaderUniformDeclaration* field = new OpenGLShaderUniformDeclaration(domain, OpenGLShaderUniformDeclaration::StringToType(type), name, count);
-            uniformStruct->AddField(field);
-        }
+        OpenGLShaderLexer::Token name = lexer.Next();
+        if (name.Kind != OpenGLShaderLexer::Token::Type::Identifier || !lexer.Accept('{'))
+            return;
+        
+        ShaderStruct* uniformStruct = &m_Reflection.Structs.emplace_back(std::string(name.Text));
+        ParseMembers(lexer, [&](std::string_view type, std::string_view fieldName, uint32_t count) {
+            OpenGLShaderUniformDeclaration::Type t = OpenGLShaderUniformDeclaration::StringToType(std::string(type));
+            uniformStruct->AddField(&m_Reflection.Uniforms.emplace_back(domain, t, std::string(fieldName), count));
+        });
+        lexer.SkipPast(';');
+        
         m_Structs.push_back(uniformStruct);
     }
 
     // ******************************************************************************
+    // Get the uniform locations and bind the samplers and renderer blocks of linked
+    // program. Called from Render Command Queue once program is ready
     // ******************************************************************************
     void OpenGLShader::ResolveUniforms()
     {
-        Renderer::Submit([this]()
-                         {
-            glUseProgram(m_RendererId);
+        glUseProgram(m_RendererId);
 
-            for (size_t i = 0; i < m_VSRendererUniformBuffers.size(); i++)
+        for (size_t i = 0; i < m_VSRendererUniformBuffers.size(); i++)
+        {
+            OpenGLShaderUniformBufferDeclaration* decl = (OpenGLShaderUniformBufferDeclaration*)m_VSRendererUniformBuffers[i];
+            if (!decl->GetName().empty())
+            {
+                BindRendererBlock(decl->GetName());
+                continue;
+            }
+            
+            const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
+            for (size_t j = 0; j < uniforms.size(); j++)
+            {
+                OpenGLShaderUniformDeclaration* uniform = (OpenGLShaderUniformDeclaration*)uniforms[j];
+                if (uniform->GetType() == OpenGLShaderUniformDeclaration::Type::STRUCT)
+                {
+                    const ShaderStruct& s = uniform->GetShaderUniformStruct();
+                    const auto& fields = s.GetFields();
+                    for (size_t k = 0; k < fields.size(); k++)
+                    {
+                        OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
+                        field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+                    }
+                }
+                else
+                {
+                    uniform->m_Location = GetUniformLocation(uniform->m_Name);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m_PSRendererUniformBuffers.size(); i++)
+        {
+            OpenGLShaderUniformBufferDeclaration* decl = (OpenGLShaderUniformBufferDeclaration*)m_PSRendererUniformBuffers[i];
+            if (!decl->GetName().empty())
+            {
+                BindRendererBlock(decl->GetName());
+                continue;
+            }
+            
+            const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
+            for (size_t j = 0; j < uniforms.size(); j++)
+            {
+                OpenGLShaderUniformDeclaration* uniform = (OpenGLShaderUniformDeclaration*)uniforms[j];
+                if (uniform->GetType() == OpenGLShaderUniformDeclaration::Type::STRUCT)
+                {
+                    const ShaderStruct& s = uniform->GetShaderUniformStruct();
+                    const auto& fields = s.GetFields();
+                    for (size_t k = 0; k < fields.size(); k++)
+                    {
+                        OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
+                        field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+                    }
+                }
+                else
+                {
+                    uniform->m_Location = GetUniformLocation(uniform->m_Name);
+                }
+            }
+        }
+
+        {
+            const auto& decl = m_VSMaterialUniformBuffer;
+            if (decl)
             {
-                OpenGLShaderUniformBufferDeclaration* decl = (OpenGLShaderUniformBufferDeclaration*)m_VSRendererUniformBuffers[i];
                 const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
                 for (size_t j = 0; j < uniforms.size(); j++)
                 {
@@ -302,10 +491,12 @@ namespace iKan {
                     }
                 }
             }
+        }
 
-            for (size_t i = 0; i < m_PSRendererUniformBuffers.size(); i++)
+        {
+            const auto& decl = m_PSMaterialUniformBuffer;
+            if (decl)
             {
-                OpenGLShaderUniformBufferDeclaration* decl = (OpenGLShaderUniformBufferDeclaration*)m_PSRendererUniformBuffers[i];
                 const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
                 for (size_t j = 0; j < uniforms.size(); j++)
                 {
@@ -326,91 +517,179 @@ namespace iKan {
                     }
                 }
             }
+        }
+
+        uint32_t sampler = 0;
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            OpenGLShaderResourceDeclaration* resource = (OpenGLShaderResourceDeclaration*)m_Resources[i];
+            int32_t location = GetUniformLocation(resource->m_Name);
 
+            if (resource->GetCount() == 1)
             {
-                const auto& decl = m_VSMaterialUniformBuffer;
-                if (decl)
-                {
-                    const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
-                    for (size_t j = 0; j < uniforms.size(); j++)
-                    {
-                        OpenGLShaderUniformDeclaration* uniform = (OpenGLShaderUniformDeclaration*)uniforms[j];
-                        if (uniform->GetType() == OpenGLShaderUniformDeclaration::Type::STRUCT)
-                        {
-                            const ShaderStruct& s = uniform->GetShaderUniformStruct();
-                            const auto& fields = s.GetFields();
-                            for (size_t k = 0; k < fields.size(); k++)
-                            {
-                                OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-                                field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
-                            }
-                        }
-                        else
-                        {
-                            uniform->m_Location = GetUniformLocation(uniform->m_Name);
-                        }
-                    }
-                }
-            }
+                resource->m_Register = sampler;
+                if (location != -1)
+                    glUniform1i(location, sampler);
 
+                sampler++;
+            }
+            else if (resource->GetCount() > 1)
             {
-                const auto& decl = m_PSMaterialUniformBuffer;
-                if (decl)
-                {
-                    const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
-                    for (size_t j = 0; j < uniforms.size(); j++)
-                    {
-                        OpenGLShaderUniformDeclaration* uniform = (OpenGLShaderUniformDeclaration*)uniforms[j];
-                        if (uniform->GetType() == OpenGLShaderUniformDeclaration::Type::STRUCT)
-                        {
-                            const ShaderStruct& s = uniform->GetShaderUniformStruct();
-                            const auto& fields = s.GetFields();
-                            for (size_t k = 0; k < fields.size(); k++)
-                            {
-                                OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-                                field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
-                            }
-                        }
-                        else
-                        {
-                            uniform->m_Location = GetUniformLocation(uniform->m_Name);
-                        }
-                    }
-                }
+                resource->m_Register = 0;
+                uint32_t count = resource->GetCount();
+                std::vector<int32_t> samplers(count);
+                for (uint32_t s = 0; s < count; s++)
+                    samplers[s] = s;
+                glUniform1iv(location, count, samplers.data());
             }
-
-            uint32_t sampler = 0;
-            for (size_t i = 0; i < m_Resources.size(); i++)
+        }
+        
+        s_BoundShader = this;
+        ResolveUniformSlots();
+    }
+    
+    // ******************************************************************************
+    // Bind the renderer uniform block of program to its fixed binding point
+    // ******************************************************************************
+    void OpenGLShader::BindRendererBlock(const std::string& name)
+    {
+        uint32_t blockIndex = glGetUniformBlockIndex(m_RendererId, name.c_str());
+        if (blockIndex == GL_INVALID_INDEX)
+        {
+            IK_CORE_WARN("Warning: uniform block '{0}' doesnt exist", name);
+            return;
+        }
+        glUniformBlockBinding(m_RendererId, blockIndex, Shader::GetRendererBlockBinding(name));
+    }
+    
+    // ******************************************************************************
+    // Create the uniform slots from parsed declarations. Struct members get their own
+    // slot named as "uniform.member"
+    // ******************************************************************************
+    void OpenGLShader::BuildUniformSlots()
+    {
+        if (m_UniformSlots.empty())
+            m_UniformSlots.emplace_back();
+        
+        auto addDeclarations = [this](const ShaderUniformList& uniforms)
+        {
+            for (auto* declaration : uniforms)
             {
-                OpenGLShaderResourceDeclaration* resource = (OpenGLShaderResourceDeclaration*)m_Resources[i];
-                int32_t location = GetUniformLocation(resource->m_Name);
-
-                if (resource->GetCount() == 1)
+                auto* uniform = (OpenGLShaderUniformDeclaration*)declaration;
+                if (uniform->GetType() == OpenGLShaderUniformDeclaration::Type::STRUCT)
                 {
-                    resource->m_Register = sampler;
-                    if (location != -1)
-                        SetUniformInt1(resource->m_Name, sampler);
-
-                    sampler++;
+                    for (auto* field : uniform->GetShaderUniformStruct().GetFields())
+                        AddUniformSlot(uniform->m_Name + "." + field->GetName(), *(OpenGLShaderUniformDeclaration*)field);
                 }
-                else if (resource->GetCount() > 1)
+                else
                 {
-                    resource->m_Register = 0;
-                    uint32_t count = resource->GetCount();
-                    int* samplers = new int[count];
-                    for (uint32_t s = 0; s < count; s++)
-                        samplers[s] = s;
-                    SetIntArray(resource->GetName(), samplers, count);
-                    delete[] samplers;
+                    AddUniformSlot(uniform->m_Name, *uniform);
                 }
             }
-        });
+        };
+        
+        // Members of renderer blocks come from uniform buffer, so no slot for them
+        for (auto* buffer : m_VSRendererUniformBuffers)
+            if (buffer->GetName().empty())
+                addDeclarations(buffer->GetUniformDeclarations());
+        for (auto* buffer : m_PSRendererUniformBuffers)
+            if (buffer->GetName().empty())
+                addDeclarations(buffer->GetUniformDeclarations());
+        if (m_VSMaterialUniformBuffer)
+            addDeclarations(m_VSMaterialUniformBuffer->GetUniformDeclarations());
+        if (m_PSMaterialUniformBuffer)
+            addDeclarations(m_PSMaterialUniformBuffer->GetUniformDeclarations());
+        
+        // So that staging uniforms does not allocate in frame
+        m_DirtyUniforms.reserve(m_UniformSlots.size());
+    }
+    
+    // ******************************************************************************
+    // Add the slot for uniform or update the existing one after reload
+    // ******************************************************************************
+    void OpenGLShader::AddUniformSlot(const std::string& name, const OpenGLShaderUniformDeclaration& declaration)
+    {
+        UniformHandle& handle = m_UniformHandles[name];
+        if (handle == 0)
+        {
+            handle = (UniformHandle)m_UniformSlots.size();
+            m_UniformSlots.emplace_back();
+            m_UniformSlots.back().Name = name;
+        }
+        
+        // Uniform same in both vertex and fragment shader shares one slot
+        UniformSlot& slot = m_UniformSlots[handle];
+        if (declaration.GetSize() > slot.Size)
+        {
+            slot.Offset = (uint32_t)m_UniformStorage.size();
+            slot.Size   = declaration.GetSize();
+            m_UniformStorage.resize(m_UniformStorage.size() + slot.Size);
+        }
+        slot.Type  = declaration.GetType();
+        slot.Count = declaration.GetCount();
+    }
+    
+    // ******************************************************************************
+    // Get the location of each slot after link. Values set before reload are
+    // uploaded again to new program
+    // ******************************************************************************
+    void OpenGLShader::ResolveUniformSlots()
+    {
+        for (size_t handle = 1; handle < m_UniformSlots.size(); handle++)
+        {
+            UniformSlot& slot = m_UniformSlots[handle];
+            slot.Location = GetUniformLocation(slot.Name);
+            
+            if (slot.Written && !slot.Dirty)
+            {
+                slot.Dirty = true;
+                m_DirtyUniforms.push_back((UniformHandle)handle);
+            }
+        }
+    }
+    
+    // ******************************************************************************
+    // Upload all the changed uniforms in one pass. Shader should be bound
+    // ******************************************************************************
+    void OpenGLShader::FlushUniforms()
+    {
+        for (UniformHandle handle : m_DirtyUniforms)
+        {
+            UniformSlot& slot = m_UniformSlots[handle];
+            slot.Dirty = false;
+            
+            if (slot.Location == -1)
+                continue;
+            
+            const uint8_t* data = m_UniformStorage.data() + slot.Offset;
+            switch (slot.Type)
+            {
+                case OpenGLShaderUniformDeclaration::Type::INT32   : glUniform1iv(slot.Location, slot.Count, (const GLint*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::FLOAT32 : glUniform1fv(slot.Location, slot.Count, (const GLfloat*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::VEC2    : glUniform2fv(slot.Location, slot.Count, (const GLfloat*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::VEC3    : glUniform3fv(slot.Location, slot.Count, (const GLfloat*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::VEC4    : glUniform4fv(slot.Location, slot.Count, (const GLfloat*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::MAT3    : glUniformMatrix3fv(slot.Location, slot.Count, GL_FALSE, (const GLfloat*)data); break;
+                case OpenGLShaderUniformDeclaration::Type::MAT4    : glUniformMatrix4fv(slot.Location, slot.Count, GL_FALSE, (const GLfloat*)data); break;
+                default: break;
+            }
+        }
+        m_DirtyUniforms.clear();
+    }
+    
+    // ******************************************************************************
+    // Upload the staged uniforms of shader bound in Render Command Queue
+    // ******************************************************************************
+    void OpenGLShader::FlushBoundUniforms()
+    {
+        if (s_BoundShader)
+            s_BoundShader->FlushUniforms();
     }
     
     // ******************************************************************************
     // Open GL Read from file
     // ******************************************************************************
-    std::string OpenGLShader::ReadFromFile(const std::string& path)
+    std::string OpenGLShader::ReadFromFile(const std::string& path) const
     {
         IK_CORE_INFO("Reading Open GL Shdaer from file : {0}", path.c_str());
 
@@ -441,7 +720,50 @@ namespace iKan {
     }
     
     // ******************************************************************************
-    // Process the Shader file
+    // Replace the '#include "file"' lines with content of file. Path of included file
+    // is relative to the file including it
+    // ******************************************************************************
+    std::string OpenGLShader::ExpandIncludes(const std::string& source, const std::string& path, std::vector<std::string>* includedFiles, uint32_t depth) const
+    {
+        static constexpr uint32_t MaxIncludeDepth = 8;
+        if (depth > MaxIncludeDepth)
+        {
+            IK_CORE_ERROR("Shader {0} has too deep or recursive include", path);
+            return "";
+        }
+        
+        size_t found = path.find_last_of("/\\");
+        std::string directory = found != std::string::npos ? path.substr(0, found + 1) : "";
+        
+        std::string result;
+        const char* token = "#include";
+        size_t begin = 0, pos;
+        while ((pos = source.find(token, begin)) != std::string::npos)
+        {
+            size_t eol   = source.find_first_of("\r\n", pos);
+            size_t open  = source.find('"', pos);
+            size_t close = open == std::string::npos ? open : source.find('"', open + 1);
+            if (close == std::string::npos || (eol != std::string::npos && close > eol))
+            {
+                IK_CORE_ERROR("Invalid include in shader {0}", path);
+                break;
+            }
+            
+            std::string includePath = directory + source.substr(open + 1, close - open - 1);
+            if (includedFiles)
+                includedFiles->push_back(includePath);
+            
+            result += source.substr(begin, pos - begin);
+            result += ExpandIncludes(ReadFromFile(includePath), includePath, includedFiles, depth + 1);
+            begin = eol == std::string::npos ? source.size() : eol;
+        }
+        result += source.substr(std::min(begin, source.size()));
+        return result;
+    }
+    
+    // ******************************************************************************
+    // Process the Shader file. Split the stages and inject the defines of variant
+    // right after "#version" line of each stage
     // ******************************************************************************
     std::unordered_map<GLenum, std::string> OpenGLShader::PreprocessFile(const std::string& source)
     {
@@ -449,105 +771,327 @@ namespace iKan {
 
         std::unordered_map<GLenum, std::string> shaderSource;
         
-        const char* token = "#type";
-        size_t pos        = source.find(token);
-        while (pos != std::string::npos)
+        std::string defines;
+        for (const auto& define : m_Defines)
+            defines += "#define " + define + "\n";
+        
+        for (const auto& [typeName, stageSource] : OpenGLShaderLexer::SplitStages(source))
         {
-            size_t eol = source.find_first_of("\r\n", pos);
-            IK_CORE_ASSERT((eol != std::string::npos), "Syntax error");
-
-            size_t begin     = pos + strlen(token) + 1;
-            std::string type = source.substr(begin, eol - begin);
-            IK_CORE_ASSERT(ShaderTypeFromString(type), "Invalid shader type specified");
+            std::string type(typeName);
+            if (type != "vertex" && type != "fragment" && type != "geometry")
+            {
+                IK_CORE_ERROR("Invalid shader type '{0}' in shader {1}", type, m_Name);
+                continue;
+            }
             
-            size_t nextLine = source.find_first_of("\r\n", eol);
-            pos             = source.find(token, nextLine);
+            std::string stage(stageSource);
             
-            shaderSource[ShaderTypeFromString(type)] = source.substr(nextLine, pos - (nextLine == std::string::npos ? source.size() - 1 : nextLine));
+            // "#version" must be first statement so defines go after it
+            if (!defines.empty())
+            {
+                size_t version = stage.find("#version");
+                size_t at      = version == std::string::npos ? 0 : stage.find_first_of("\r\n", version);
+                stage.insert(at == std::string::npos ? stage.size() : at, "\n" + defines);
+            }
+            shaderSource[ShaderTypeFromString(type)] = stage;
         }
         
         return shaderSource;
     }
     
     // ******************************************************************************
-    // Compile the Shader file
+    // Compile the Shader file. Program binary is loaded from cache if source and
+    // driver are same as when it was cached, else compile and link are issued to
+    // driver and their status is checked later so that driver compiles all the
+    // shaders created together in parallel
     // ******************************************************************************
     void OpenGLShader::Compile()
     {
-        Renderer::Submit([this]()
+        Renderer::Submit([this, reloading = m_Loaded]()
                          {
-            IK_CORE_INFO("Compiling Open GL Shader: {0} ", m_Name.c_str());
+            // Drop the compile that is still pending, source is changed again
+            if (m_Pending.Program)
+            {
+                glDeleteProgram(m_Pending.Program);
+                for (auto id : m_Pending.Shaders)
+                    glDeleteShader(id);
+                m_Pending = PendingProgram();
+            }
+            
+            uint32_t program = glCreateProgram();
+            uint64_t sourceHash = GetSourceHash();
+            
+            if (LoadProgramBinary(program, sourceHash))
+                OnProgramLinked(program, reloading);
+            else
+                IssueCompile(program, sourceHash, reloading);
+        });
+    }
+    
+    // ******************************************************************************
+    // Issue compile of all the stages and link of program without waiting for them
+    // ******************************************************************************
+    void OpenGLShader::IssueCompile(uint32_t program, uint64_t sourceHash, bool reloading)
+    {
+        IK_CORE_INFO("Compiling Open GL Shader: {0} ", m_Name.c_str());
+        
+        m_Pending.Program    = program;
+        m_Pending.SourceHash = sourceHash;
+        m_Pending.Reloading  = reloading;
 
-            int32_t program = glCreateProgram();
-            int32_t glShaderIDIndex = 0;
-            std::array<uint32_t, 3> shaderId;
+        int32_t glShaderIDIndex = 0;
+        for (auto& kv : m_Source)
+        {
+            GLenum type = kv.first;
 
-            for (auto& kv : m_Source)
-            {
-                GLenum type = kv.first;
-                std::string src = kv.second;
+            uint32_t shader = glCreateShader(type);
 
-                uint32_t shader = glCreateShader(type);
+            // Attch the shader source and then compile
+            const char* string = kv.second.c_str();
+            glShaderSource(shader, 1, &string, nullptr);
+            glCompileShader(shader);
 
-                // Attch the shader source and then compile
-                const char* string = src.c_str();
-                glShaderSource(shader, 1, &string, nullptr);
-                glCompileShader(shader);
+            // Attach all the shaders and link them. Compile status is checked only if
+            // link fails
+            glAttachShader(program, shader);
+            m_Pending.Types[glShaderIDIndex]     = type;
+            m_Pending.Shaders[glShaderIDIndex++] = shader;
+        }
 
-                // Error Handling
+        // So that linked program can be stored in cache
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(program);
+        
+        if (std::find(s_PendingShaders.begin(), s_PendingShaders.end(), this) == s_PendingShaders.end())
+            s_PendingShaders.push_back(this);
+    }
+    
+    // ******************************************************************************
+    // Check the pending compile. Returns false till driver is still compiling. If
+    // driver does not support parallel compile then status query waits for it
+    // ******************************************************************************
+    bool OpenGLShader::PollCompile()
+    {
+        if (!m_Pending.Program)
+            return true;
+        
+        if (RendererAPI::GetCapabilities().ParallelShaderCompile)
+        {
+            GLint completed = GL_FALSE;
+            glGetProgramiv(m_Pending.Program, GL_COMPLETION_STATUS_KHR, &completed);
+            if (completed == GL_FALSE)
+                return false;
+        }
+        
+        PendingProgram pending = m_Pending;
+        m_Pending = PendingProgram();
+        
+        // Error Handling
+        // Note the different functions here: glGetProgram* instead of glGetShader
+        GLint isLinked = 0;
+        glGetProgramiv(pending.Program, GL_LINK_STATUS, (int32_t*)&isLinked);
+        if (isLinked == GL_FALSE)
+        {
+            // Find the stage that failed to compile
+            for (size_t i = 0; i < pending.Shaders.size() && pending.Shaders[i]; i++)
+            {
                 GLint isCompiled = 0;
-                glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+                glGetShaderiv(pending.Shaders[i], GL_COMPILE_STATUS, &isCompiled);
                 if (isCompiled == GL_FALSE)
                 {
                     GLint maxLength = 0;
-                    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-
-                    std::vector<GLchar> infoLog(maxLength);
-                    glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+                    glGetShaderiv(pending.Shaders[i], GL_INFO_LOG_LENGTH, &maxLength);
 
-                    glDeleteShader(shader);
+                    std::vector<GLchar> infoLog(maxLength + 1);
+                    glGetShaderInfoLog(pending.Shaders[i], maxLength, &maxLength, &infoLog[0]);
 
-                    IK_CORE_ERROR("Shader Compilation failure for {0}", ShaderTypeString(type));
+                    IK_CORE_ERROR("Shader Compilation failure for {0}", ShaderTypeString(pending.Types[i]));
                     IK_CORE_ERROR("{0}", infoLog.data());
-                    IK_CORE_ASSERT(false, "Shader compilation failure!");
                 }
-                // Attach both shader and link them
-                glAttachShader(program, shader);
-                shaderId[glShaderIDIndex++] = shader;
             }
+            
+            GLint maxLength = 0;
+            glGetProgramiv(pending.Program, GL_INFO_LOG_LENGTH, &maxLength);
 
-            // Create Shader program to activate and linke the shader
-            m_RendererId = program;
-
-            glLinkProgram(m_RendererId);
-
-            // Error Handling
-            // Note the different functions here: glGetProgram* instead of glGetShader
-            GLint isLinked = 0;
-            glGetProgramiv(m_RendererId, GL_LINK_STATUS, (int32_t*)&isLinked);
-            if (isLinked == GL_FALSE)
-            {
-                GLint maxLength = 0;
-                glGetProgramiv(m_RendererId, GL_INFO_LOG_LENGTH, &maxLength);
-
-                /* The maxLength includes the NULL character */
-                std::vector<GLchar> infoLog(maxLength);
-                glGetProgramInfoLog(m_RendererId, maxLength, &maxLength, &infoLog[0]);
+            /* The maxLength includes the NULL character */
+            std::vector<GLchar> infoLog(maxLength + 1);
+            glGetProgramInfoLog(pending.Program, maxLength, &maxLength, &infoLog[0]);
 
-                /* We don't need the program anymore. */
-                glDeleteProgram(m_RendererId);
+            /* We don't need the program anymore. */
+            glDeleteProgram(pending.Program);
 
-                for (auto id : shaderId)
-                {
-                    glDeleteShader(id);
-                }
+            for (auto id : pending.Shaders)
+                glDeleteShader(id);
 
-                IK_CORE_ERROR("{0}", infoLog.data());
+            IK_CORE_ERROR("{0}", infoLog.data());
+            
+            // Keep using older program till the file is fixed
+            if (!pending.Reloading)
                 IK_CORE_ASSERT(false, "Shader link failure!");
-            }
-            for (auto id : shaderId)
-                glDeleteShader(id);
-        });
+            return true;
+        }
+        
+        for (auto id : pending.Shaders)
+            glDeleteShader(id);
+        
+        SaveProgramBinary(pending.Program, pending.SourceHash);
+        OnProgramLinked(pending.Program, pending.Reloading);
+        return true;
+    }
+    
+    // ******************************************************************************
+    // Use the linked program and resolve its uniforms
+    // ******************************************************************************
+    void OpenGLShader::OnProgramLinked(uint32_t program, bool reloading)
+    {
+        // Replace the older program, uniform locations belong to older one
+        if (reloading)
+        {
+            glDeleteProgram(m_RendererId);
+            m_LocationMap.clear();
+        }
+
+        // Create Shader program to activate and linke the shader
+        m_RendererId = program;
+        
+        if (!m_IsCompute)
+            ResolveUniforms();
+        
+        m_Ready = true;
+    }
+    
+    // ******************************************************************************
+    // Check all the pending compiles. Called once per frame after executing Render
+    // Command Queue
+    // ******************************************************************************
+    void OpenGLShader::PollPendingCompiles()
+    {
+        s_PendingShaders.erase(std::remove_if(s_PendingShaders.begin(), s_PendingShaders.end(), [](OpenGLShader* shader) { return shader->PollCompile(); }), s_PendingShaders.end());
+    }
+    
+    // ******************************************************************************
+    // Hash of shader source along with the driver. Cached binary is valid only for
+    // same source compiled by same driver. Uses FNV-1a so that hash is same across
+    // the launches
+    // ******************************************************************************
+    uint64_t OpenGLShader::GetSourceHash() const
+    {
+        uint64_t hash = Utils::s_HashOffset;
+        auto combine = [&hash](const std::string& string)
+        {
+            // Seperator so that "ab" + "c" differs from "a" + "bc"
+            static constexpr uint8_t separator = 0xff;
+            hash = Utils::Hash(string.data(), string.size(), hash);
+            hash = Utils::Hash(&separator, 1, hash);
+        };
+        
+        const auto& caps = RendererAPI::GetCapabilities();
+        combine(caps.Vendor);
+        combine(caps.Renderer);
+        combine(caps.Version);
+        
+        // Source map is unordered so hash the stages in fixed order
+        for (GLenum type : { GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER })
+            if (auto it = m_Source.find(type); it != m_Source.end())
+                combine(std::to_string(type) + it->second);
+        
+        return hash;
+    }
+    
+    // ******************************************************************************
+    // Path of cached program binary. Shader without name (created from strings) is
+    // not cached
+    // ******************************************************************************
+    std::string OpenGLShader::GetCachePath() const
+    {
+        return m_Name.empty() ? "" : s_ShaderCacheDirectory + m_Name + ".bin";
+    }
+    
+    // ******************************************************************************
+    // Load the program from cached binary. Returns false if there is no cache, cache
+    // is of other source or driver, or driver rejects the binary
+    // ******************************************************************************
+    bool OpenGLShader::LoadProgramBinary(uint32_t program, uint64_t sourceHash)
+    {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        
+        std::string path = GetCachePath();
+        if (numFormats == 0 || path.empty())
+            return false;
+        
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in)
+            return false;
+        
+        uint64_t hash = 0;
+        GLenum format = 0;
+        uint32_t size = 0;
+        in.read((char*)&hash, sizeof(hash));
+        in.read((char*)&format, sizeof(format));
+        in.read((char*)&size, sizeof(size));
+        
+        if (!in || hash != sourceHash)
+        {
+            IK_CORE_INFO("Cached Open GL Shader {0} is out of date", m_Name.c_str());
+            return false;
+        }
+        
+        std::vector<char> binary(size);
+        in.read(binary.data(), size);
+        if (!in)
+            return false;
+        
+        glProgramBinary(program, format, binary.data(), size);
+        
+        GLint isLinked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
+        {
+            IK_CORE_WARN("Driver rejected cached Open GL Shader {0}, compiling from source", m_Name.c_str());
+            return false;
+        }
+        
+        IK_CORE_INFO("Loaded Open GL Shader {0} from cache", m_Name.c_str());
+        return true;
+    }
+    
+    // ******************************************************************************
+    // Store the linked program binary in cache
+    // ******************************************************************************
+    void OpenGLShader::SaveProgramBinary(uint32_t program, uint64_t sourceHash)
+    {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        
+        std::string path = GetCachePath();
+        if (numFormats == 0 || path.empty())
+            return;
+        
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+        
+        GLenum format = 0;
+        std::vector<char> binary(length);
+        glGetProgramBinary(program, length, &length, &format, binary.data());
+        
+        std::error_code error;
+        std::filesystem::create_directories(s_ShaderCacheDirectory, error);
+        
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            IK_CORE_WARN("Could not write Open GL Shader cache '{0}'", path);
+            return;
+        }
+        
+        uint32_t size = (uint32_t)length;
+        out.write((const char*)&sourceHash, sizeof(sourceHash));
+        out.write((const char*)&format, sizeof(format));
+        out.write((const char*)&size, sizeof(size));
+        out.write(binary.data(), size);
     }
     
     // ******************************************************************************
@@ -555,10 +1099,28 @@ namespace iKan {
     // ******************************************************************************
     OpenGLShader::~OpenGLShader()
     {
-        Renderer::Submit([this]()
+        FileWatcher::Unwatch(this);
+        if (s_BoundShader == this)
+            s_BoundShader = nullptr;
+        
+        s_PendingShaders.erase(std::remove(s_PendingShaders.begin(), s_PendingShaders.end(), this), s_PendingShaders.end());
+
+        if (m_Reloading.valid())
+            m_Reloading.wait();
+        
+        // Program being compiled or reloaded is deleted too. Ids are copied as shader
+        // is destroyed when command is executed
+        Renderer::Submit([name = m_Name, rendererId = m_RendererId, pending = m_Pending]()
                          {
-            IK_CORE_WARN("Destroying Open GL Shader : {0}", m_Name.c_str());
-            glDeleteProgram(m_RendererId);
+            IK_CORE_WARN("Destroying Open GL Shader : {0}", name.c_str());
+            glDeleteProgram(rendererId);
+            
+            if (pending.Program)
+            {
+                glDeleteProgram(pending.Program);
+                for (auto id : pending.Shaders)
+                    glDeleteShader(id);
+            }
         });
     }
     
@@ -567,7 +1129,12 @@ namespace iKan {
     // ******************************************************************************
     void OpenGLShader::Bind()
     {
-        Renderer::Submit([this]() { glUseProgram(m_RendererId); });
+        ApplyReloadIfReady();
+        Renderer::Submit([this]()
+                         {
+            glUseProgram(m_RendererId);
+            s_BoundShader = this;
+        });
     }
     
     // ******************************************************************************
@@ -575,7 +1142,11 @@ namespace iKan {
     // ******************************************************************************
     void OpenGLShader::Unbind()
     {
-        Renderer::Submit([]() { glUseProgram(0); });
+        Renderer::Submit([]()
+                         {
+            glUseProgram(0);
+            s_BoundShader = nullptr;
+        });
     }
     
     // ******************************************************************************
@@ -586,47 +1157,64 @@ namespace iKan {
         m_ShaderReloadedCallbacks.push_back(callback);
     }
     
+    // ******************************************************************************
+    // Get the handle of uniform declared in shader
+    // ******************************************************************************
+    UniformHandle OpenGLShader::GetUniformHandle(const std::string& name)
+    {
+        auto [it, inserted] = m_UniformHandles.try_emplace(name, 0);
+        if (inserted)
+            IK_CORE_WARN("Warning: uniform '{0}' is not declared in shader {1}", name, m_Name);
+        return it->second;
+    }
+    
     //-------------------------------- Uniforms --------------------------------
+    void OpenGLShader::SetUniform(UniformHandle handle, int32_t value)            { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, float value)              { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, const glm::vec2& value)   { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, const glm::vec3& value)   { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, const glm::vec4& value)   { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, const glm::mat3& value)   { StageUniform(handle, value); }
+    void OpenGLShader::SetUniform(UniformHandle handle, const glm::mat4& value)   { StageUniform(handle, value); }
+    
     void OpenGLShader::SetUniformInt1(const std::string& name, int32_t value)
     {
-        glUniform1i(GetUniformLocation(name), value);
+        SetUniform(GetUniformHandle(name), value);
     }
     
     void OpenGLShader::SetIntArray(const std::string& name, int32_t* values, uint32_t count)
     {
-        m_TextureArraySlotData = new int32_t[count];
-        memcpy(m_TextureArraySlotData, values, count * sizeof(int32_t));
-        Renderer::Submit([name, values, count, this]() { glUniform1iv(GetUniformLocation(name), count, m_TextureArraySlotData); });
+        Renderer::Submit([name, slots = std::vector<int32_t>(values, values + count), this]() { glUniform1iv(GetUniformLocation(name), (GLsizei)slots.size(), slots.data()); });
     }
     
     void OpenGLShader::SetUniformMat4(const std::string& name, const glm::mat4& value)
     {
-        Renderer::Submit([name, value, this]() { glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value)); });
+        SetUniform(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::SetUniformMat3(const std::string& name, const glm::mat3& value)
     {
-        Renderer::Submit([name, value, this]() { glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value)); });
+        SetUniform(GetUniformHandle(name), value);
     }
     
     void OpenGLShader::SetUniformFloat1(const std::string& name, float value)
     {
-        Renderer::Submit([name, value, this]() { glUniform1f(GetUniformLocation(name), value); });
+        SetUniform(GetUniformHandle(name), value);
     }
     
     void OpenGLShader::SetUniformFloat2(const std::string& name, const glm::vec2& value)
     {
-        Renderer::Submit([name, value, this]() { glUniform2f(GetUniformLocation(name), value.x, value.y); });
+        SetUniform(GetUniformHandle(name), value);
     }
     
     void OpenGLShader::SetUniformFloat3(const std::string& name, const glm::vec3& value)
     {
-        Renderer::Submit([name, value, this]() { glUniform3f(GetUniformLocation(name), value.x, value.y, value.z); });
+        SetUniform(GetUniformHandle(name), value);
     }
     
     void OpenGLShader::SetUniformFloat4(const std::string& name, const glm::vec4& value)
     {
-        Renderer::Submit([name, value, this]() { glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w); });
+        SetUniform(GetUniformHandle(name), value);
     }
     
     // ******************************************************************************
@@ -11,10 +11,15 @@
 
 #include <iKan/Renderer/Shader.h>
 #include <iKan/Platform/OpenGL/OpenGLShaderUniform.h>
+#include <iKan/Renderer/Renderer.h>
 #include <glad/glad.h>
+#include <future>
+#include <deque>
 
 namespace iKan {
     
+    class OpenGLShaderLexer;
+    
     // ******************************************************************************
     // Implementation of Open GL Shader
     // ******************************************************************************
@@ -22,7 +27,7 @@ namespace iKan {
     {
     public:
         OpenGLShader(const std::string& vertexSrc, const std::string& fragmantSrc);
-        OpenGLShader(const std::string& path);
+        OpenGLShader(const std::string& path, const std::vector<std::string>& defines = {});
         
         virtual ~OpenGLShader();
         
@@ -33,6 +38,16 @@ namespace iKan {
         
         virtual const std::string& GetName() override { return m_Name; }
         
+        virtual UniformHandle GetUniformHandle(const std::string& name) override;
+        
+        virtual void SetUniform(UniformHandle handle, int32_t value) override;
+        virtual void SetUniform(UniformHandle handle, float value) override;
+        virtual void SetUniform(UniformHandle handle, const glm::vec2& value) override;
+        virtual void SetUniform(UniformHandle handle, const glm::vec3& value) override;
+        virtual void SetUniform(UniformHandle handle, const glm::vec4& value) override;
+        virtual void SetUniform(UniformHandle handle, const glm::mat3& value) override;
+        virtual void SetUniform(UniformHandle handle, const glm::mat4& value) override;
+        
         virtual void SetUniformInt1(const std::string& name, int32_t value) override;
         virtual void SetIntArray(const std::string& name, int32_t* values, uint32_t count) override;
         
@@ -45,43 +60,155 @@ namespace iKan {
         virtual void SetUniformFloat4(const std::string& name, const glm::vec4& value) override;
 
         virtual uint32_t GetRendererID() const override { return m_RendererId; }
+        virtual bool IsReady() const override { return m_Ready; }
+        
+        virtual const ShaderUniformBufferDeclaration* FindRendererUniformBuffer(const std::string& name) const override;
+        virtual const ShaderResourceList& GetResources() const override { return m_Resources; }
+        
+        // Upload the staged uniforms of bound shader. Called from Render Command Queue
+        // just before draw call
+        static void FlushBoundUniforms();
+        static void PollPendingCompiles();
 
     private:
+        // ******************************************************************************
+        // Storage of reflection declarations. Deque keeps the addresses stable while
+        // growing, all the declarations are released together on next parse
+        // ******************************************************************************
+        struct ReflectionStorage
+        {
+            std::deque<OpenGLShaderUniformDeclaration>       Uniforms;
+            std::deque<OpenGLShaderUniformBufferDeclaration> Buffers;
+            std::deque<OpenGLShaderResourceDeclaration>      Resources;
+            std::deque<ShaderStruct>                         Structs;
+            
+            void Clear()
+            {
+                Uniforms.clear();
+                Buffers.clear();
+                Resources.clear();
+                Structs.clear();
+            }
+        };
+        
+        // ******************************************************************************
+        // Program whose compile and link are issued to driver but not checked yet
+        // ******************************************************************************
+        struct PendingProgram
+        {
+            uint32_t Program = 0;
+            uint64_t SourceHash = 0;
+            bool Reloading = false;
+            std::array<uint32_t, 3> Shaders = {};
+            std::array<GLenum, 3> Types = {};
+        };
+        
+        // ******************************************************************************
+        // Uniform resolved from declarations. Value is staged in m_UniformStorage
+        // ******************************************************************************
+        struct UniformSlot
+        {
+            std::string Name;
+            OpenGLShaderUniformDeclaration::Type Type = OpenGLShaderUniformDeclaration::Type::NONE;
+            uint32_t Offset = 0, Size = 0, Count = 1;
+            int32_t Location = -1;
+            bool Written = false, Dirty = false;
+        };
+        
+        void BuildUniformSlots();
+        void AddUniformSlot(const std::string& name, const OpenGLShaderUniformDeclaration& declaration);
+        void ResolveUniformSlots();
+        void BindRendererBlock(const std::string& name);
+        void FlushUniforms();
+        
+        template<typename T>
+        void StageUniform(UniformHandle handle, const T& value)
+        {
+            if (handle == 0)
+                return;
+            
+            // Value is copied in to the command, staging is done in order with other commands
+            Renderer::Submit([this, handle, value]()
+                             {
+                UniformSlot& slot = m_UniformSlots[handle];
+                memcpy(m_UniformStorage.data() + slot.Offset, &value, std::min((uint32_t)sizeof(T), slot.Size));
+                slot.Written = true;
+                if (!slot.Dirty)
+                {
+                    slot.Dirty = true;
+                    m_DirtyUniforms.push_back(handle);
+                }
+            });
+        }
+        
+
+        void Load();
+        void Reload();
+        void ApplyReloadIfReady();
         void Parse();
         void Compile();
+        void IssueCompile(uint32_t program, uint64_t sourceHash, bool reloading);
+        bool PollCompile();
+        void OnProgramLinked(uint32_t program, bool reloading);
+        bool LoadProgramBinary(uint32_t program, uint64_t sourceHash);
+        void SaveProgramBinary(uint32_t program, uint64_t sourceHash);
+        uint64_t GetSourceHash() const;
+        std::string GetCachePath() const;
         void ResolveUniforms();
-        void ParseUniformStruct(const std::string& block, ShaderDomain domain);
-        void ParseUniform(const std::string& statement, ShaderDomain domain);
+        void ParseSource(const std::string& source, ShaderDomain domain);
+        void ParseUniformStruct(OpenGLShaderLexer& lexer, ShaderDomain domain);
+        void ParseUniform(OpenGLShaderLexer& lexer, ShaderDomain domain);
+        void ParseUniformBlock(std::string_view name, OpenGLShaderLexer& lexer, ShaderDomain domain);
 
         int32_t GetUniformLocation(const std::string& name);
-        std::unordered_map<GLenum, std::string> PreprocessFile(const std::string& path);
-        ShaderStruct* FindStruct(const std::string& name);
-        std::string ReadFromFile(const std::string& path);
+        std::unordered_map<GLenum, std::string> PreprocessFile(const std::string& source);
+        std::string ExpandIncludes(const std::string& source, const std::string& path, std::vector<std::string>* includedFiles = nullptr, uint32_t depth = 0) const;
+        ShaderStruct* FindStruct(std::string_view name);
+        std::string ReadFromFile(const std::string& path) const;
 
         static GLenum ShaderTypeFromString(const std::string& type);
 
     private:
         bool m_Loaded    = false;
         bool m_IsCompute = false;
+        
+        // Set once first program is linked, program is replaced later on reload
+        bool m_Ready = false;
 
-        uint32_t    m_RendererId;
+        uint32_t    m_RendererId = 0;
+        std::vector<std::string> m_Defines;
+        PendingProgram m_Pending;
         std::string m_Name, m_AssetPath;
 
         std::unordered_map<std::string, int32_t> m_LocationMap;
         std::unordered_map<GLenum, std::string>  m_Source;
         std::vector<ShaderReloadedCallback>      m_ShaderReloadedCallbacks;
 
-        // to store the texture slot array from local argument so that it can be passed to Lambda
-        int32_t* m_TextureArraySlotData;
-
         ShaderUniformBufferList m_VSRendererUniformBuffers;
         ShaderUniformBufferList m_PSRendererUniformBuffers;
 
-        Ref<OpenGLShaderUniformBufferDeclaration> m_VSMaterialUniformBuffer;
-        Ref<OpenGLShaderUniformBufferDeclaration> m_PSMaterialUniformBuffer;
+        OpenGLShaderUniformBufferDeclaration* m_VSMaterialUniformBuffer = nullptr;
+        OpenGLShaderUniformBufferDeclaration* m_PSMaterialUniformBuffer = nullptr;
 
         ShaderResourceList m_Resources;
         ShaderStructList   m_Structs;
+        
+        // Owns all the declarations referred by above lists
+        ReflectionStorage m_Reflection;
+        
+        // Index 0 is reserved for invalid handle. Slots are never removed so that
+        // handles remain valid after reload
+        std::vector<UniformSlot> m_UniformSlots;
+        std::unordered_map<std::string, UniformHandle> m_UniformHandles;
+        std::vector<uint8_t> m_UniformStorage;
+        std::vector<UniformHandle> m_DirtyUniforms;
+        
+        // Shader bound in Render Command Queue
+        static OpenGLShader* s_BoundShader;
+        static std::vector<OpenGLShader*> s_PendingShaders;
+        
+        // Shader file read and preprocessed on worker thread when it is changed on disk
+        std::future<std::unordered_map<GLenum, std::string>> m_Reloading;
     };
     
 }
@@ -0,0 +1,265 @@
+// ******************************************************************************
+// File         : OpenGLShaderLexer.cpp
+// Description  : Single pass lexer of GLSL source used for shader reflection
+// Project      : iKan : Platform
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "OpenGLShaderLexer.h"
+#include <cctype>
+
+namespace iKan {
+
+    static bool IsIdentifierStart(char c) { return isalpha((unsigned char)c) || c == '_'; }
+    static bool IsIdentifierChar(char c)  { return isalnum((unsigned char)c) || c == '_'; }
+
+    // ******************************************************************************
+    // Get the next word of directive line starting from pos, pos moves after word
+    // ******************************************************************************
+    static std::string_view NextWord(std::string_view line, size_t& pos)
+    {
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+            pos++;
+
+        size_t begin = pos;
+        while (pos < line.size() && IsIdentifierChar(line[pos]))
+            pos++;
+
+        return line.substr(begin, pos - begin);
+    }
+
+    // ******************************************************************************
+    // Lexer constructor
+    // ******************************************************************************
+    OpenGLShaderLexer::OpenGLShaderLexer(std::string_view source)
+    : m_Source(source)
+    {
+    }
+
+    // ******************************************************************************
+    // Split the shader file at "#type" lines. Type is the rest of "#type" line and
+    // source of stage starts at the end of that line
+    // ******************************************************************************
+    std::vector<OpenGLShaderLexer::Stage> OpenGLShaderLexer::SplitStages(std::string_view source)
+    {
+        static constexpr std::string_view token = "#type";
+
+        std::vector<Stage> stages;
+        size_t pos = source.find(token);
+        while (pos != std::string_view::npos)
+        {
+            size_t eol = source.find_first_of("\r\n", pos);
+            if (eol == std::string_view::npos)
+                eol = source.size();
+
+            size_t typePos = pos + token.size();
+            std::string_view type = NextWord(source.substr(0, eol), typePos);
+
+            pos = source.find(token, eol);
+            size_t end = pos == std::string_view::npos ? source.size() : pos;
+            stages.push_back({ type, source.substr(eol, end - eol) });
+        }
+        return stages;
+    }
+
+    // ******************************************************************************
+    // Get the next token and consume it
+    // ******************************************************************************
+    OpenGLShaderLexer::Token OpenGLShaderLexer::Next()
+    {
+        if (m_HasPeeked)
+        {
+            m_HasPeeked = false;
+            return m_Peeked;
+        }
+        return Lex();
+    }
+
+    // ******************************************************************************
+    // Get the next token without consuming it
+    // ******************************************************************************
+    const OpenGLShaderLexer::Token& OpenGLShaderLexer::Peek()
+    {
+        if (!m_HasPeeked)
+        {
+            m_Peeked    = Lex();
+            m_HasPeeked = true;
+        }
+        return m_Peeked;
+    }
+
+    // ******************************************************************************
+    // Consume the next token if it is the symbol
+    // ******************************************************************************
+    bool OpenGLShaderLexer::Accept(char symbol)
+    {
+        if (!Peek().Is(symbol))
+            return false;
+
+        m_HasPeeked = false;
+        return true;
+    }
+
+    // ******************************************************************************
+    // Skip the tokens till symbol, block inside "{ }" is skipped as a whole
+    // ******************************************************************************
+    void OpenGLShaderLexer::SkipPast(char symbol)
+    {
+        int32_t depth = 0;
+        for (Token token = Next(); token.Kind != Token::Type::End; token = Next())
+        {
+            if (depth == 0 && token.Is(symbol))
+                return;
+
+            if (token.Is('{'))
+                depth++;
+            else if (token.Is('}') && depth > 0)
+                depth--;
+        }
+    }
+
+    // ******************************************************************************
+    // Lex the next token from source
+    // ******************************************************************************
+    OpenGLShaderLexer::Token OpenGLShaderLexer::Lex()
+    {
+        while (true)
+        {
+            SkipSpaceAndComments();
+            if (m_Pos >= m_Source.size())
+                return {};
+
+            // GLSL uses '#' only for directives, they start the line
+            if (m_Source[m_Pos] == '#')
+            {
+                ProcessDirective();
+                continue;
+            }
+
+            // Skip the line of code removed by conditional directive
+            if (!IsActive())
+            {
+                size_t eol = m_Source.find('\n', m_Pos);
+                m_Pos = eol == std::string_view::npos ? m_Source.size() : eol + 1;
+                continue;
+            }
+            break;
+        }
+
+        Token token;
+        size_t begin = m_Pos;
+        char c = m_Source[m_Pos];
+        if (IsIdentifierStart(c))
+        {
+            while (m_Pos < m_Source.size() && IsIdentifierChar(m_Source[m_Pos]))
+                m_Pos++;
+            token.Kind = Token::Type::Identifier;
+        }
+        else if (isdigit((unsigned char)c))
+        {
+            while (m_Pos < m_Source.size() && (IsIdentifierChar(m_Source[m_Pos]) || m_Source[m_Pos] == '.'))
+                m_Pos++;
+            token.Kind = Token::Type::Number;
+        }
+        else
+        {
+            m_Pos++;
+            token.Kind = Token::Type::Symbol;
+        }
+
+        token.Text = m_Source.substr(begin, m_Pos - begin);
+        return token;
+    }
+
+    // ******************************************************************************
+    // Skip the white spaces, "// ..." and "/* ... */" comments
+    // ******************************************************************************
+    void OpenGLShaderLexer::SkipSpaceAndComments()
+    {
+        while (m_Pos < m_Source.size())
+        {
+            char c = m_Source[m_Pos];
+            if (isspace((unsigned char)c))
+            {
+                m_Pos++;
+            }
+            else if (c == '/' && m_Pos + 1 < m_Source.size() && m_Source[m_Pos + 1] == '/')
+            {
+                size_t eol = m_Source.find('\n', m_Pos);
+                m_Pos = eol == std::string_view::npos ? m_Source.size() : eol + 1;
+            }
+            else if (c == '/' && m_Pos + 1 < m_Source.size() && m_Source[m_Pos + 1] == '*')
+            {
+                size_t end = m_Source.find("*/", m_Pos + 2);
+                m_Pos = end == std::string_view::npos ? m_Source.size() : end + 2;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    // ******************************************************************************
+    // Process the directive line starting at '#'
+    // ******************************************************************************
+    void OpenGLShaderLexer::ProcessDirective()
+    {
+        size_t eol = m_Source.find('\n', m_Pos);
+        if (eol == std::string_view::npos)
+            eol = m_Source.size();
+
+        std::string_view line = m_Source.substr(m_Pos + 1, eol - m_Pos - 1);
+        m_Pos = eol;
+
+        size_t pos = 0;
+        std::string_view directive = NextWord(line, pos);
+        std::string_view name      = NextWord(line, pos);
+
+        bool active = IsActive();
+        if (directive == "ifdef")
+        {
+            m_Conditions.push_back({ active, active && IsDefined(name) });
+        }
+        else if (directive == "ifndef")
+        {
+            m_Conditions.push_back({ active, active && !IsDefined(name) });
+        }
+        else if (directive == "if")
+        {
+            m_Conditions.push_back({ active, active });
+        }
+        else if (directive == "else" || directive == "elif")
+        {
+            if (!m_Conditions.empty())
+            {
+                Condition& condition = m_Conditions.back();
+                condition.Active = condition.ParentActive && !condition.Active;
+            }
+        }
+        else if (directive == "endif")
+        {
+            if (!m_Conditions.empty())
+                m_Conditions.pop_back();
+        }
+        else if (directive == "define" && active && !name.empty())
+        {
+            m_Defines.push_back(name);
+        }
+    }
+
+    // ******************************************************************************
+    // Check if name is defined by "#define" seen so far
+    // ******************************************************************************
+    bool OpenGLShaderLexer::IsDefined(std::string_view name) const
+    {
+        for (const auto& define : m_Defines)
+            if (define == name)
+                return true;
+
+        return false;
+    }
+
+}
@@ -0,0 +1,95 @@
+// ******************************************************************************
+// File         : OpenGLShaderLexer.h
+// Description  : Single pass lexer of GLSL source used for shader reflection
+// Project      : iKan : Platform
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Breaks the GLSL source in tokens without copying it. Comments are skipped and
+    // preprocessor directives are consumed: "#define NAME" is recorded and the code
+    // in "#ifdef", "#ifndef", "#else" and "#endif" blocks is skipped when condition is
+    // false. Other directives are ignored and "#if" / "#elif" are not evaluated, code of
+    // "#if" is kept and "#elif" behaves as "#else".
+    // NOTE: Tokens are views in to source, source must outlive the lexer
+    // ******************************************************************************
+    class OpenGLShaderLexer
+    {
+    public:
+        // ******************************************************************************
+        // Token of GLSL source
+        // ******************************************************************************
+        struct Token
+        {
+            enum class Type { End, Identifier, Number, Symbol };
+
+            Type             Kind = Type::End;
+            std::string_view Text;
+
+            bool Is(char symbol) const { return Kind == Type::Symbol && Text[0] == symbol; }
+            bool Is(std::string_view word) const { return Kind == Type::Identifier && Text == word; }
+        };
+
+        // ******************************************************************************
+        // Stage of shader file, code after "#type <Type>" line till next "#type"
+        // ******************************************************************************
+        struct Stage
+        {
+            std::string_view Type;
+            std::string_view Source;
+        };
+
+    public:
+        OpenGLShaderLexer(std::string_view source);
+        ~OpenGLShaderLexer() = default;
+
+        // Split the shader file in stages. Stage of "#type" at end of file is empty
+        static std::vector<Stage> SplitStages(std::string_view source);
+
+        Token Next();
+        const Token& Peek();
+
+        // Consume the next token if it is symbol
+        bool Accept(char symbol);
+
+        // Skip the tokens till symbol (inclusive), nested "{ }" are skipped as a whole
+        void SkipPast(char symbol);
+
+    private:
+        Token Lex();
+        void SkipSpaceAndComments();
+        void ProcessDirective();
+        bool IsDefined(std::string_view name) const;
+        bool IsActive() const { return m_Conditions.empty() || m_Conditions.back().Active; }
+
+    private:
+        std::string_view m_Source;
+        size_t m_Pos = 0;
+
+        Token m_Peeked;
+        bool  m_HasPeeked = false;
+
+        // "#define" names seen so far
+        std::vector<std::string_view> m_Defines;
+
+        // ******************************************************************************
+        // Open conditional directive. Code is active only if parent is active too
+        // ******************************************************************************
+        struct Condition
+        {
+            bool ParentActive;
+            bool Active;
+        };
+        std::vector<Condition> m_Conditions;
+    };
+
+}
@@ -73,6 +73,7 @@ namespace iKan {
         uint32_t GetOffset() const override { return m_Offset; }
 
         ShaderDomain GetDomain() const override { return m_Domain; }
+        const ShaderStruct* GetStruct() const override { return m_Struct; }
 
         uint32_t GetAbsoluteOffset() const { return m_Struct ? m_Struct->GetOffset() + m_Offset : m_Offset; }
         int32_t GetLocation() const { return m_Location; }
@@ -9,77 +9,213 @@
 
 #include "OpenGLTexture.h"
 #include <iKan/Renderer/Renderer.h>
+#include <iKan/Renderer/TextureMemory.h>
+#include <iKan/Core/FileWatcher.h>
 #include <stb_image.h>
 
 namespace iKan {
  
+    // Bound in place of evicted texture till it is decoded again. Created from
+    // Render Command Queue on first use
+    static uint32_t s_PlaceholderRendererId = 0;
+    
+    // ******************************************************************************
+    // Bind the placeholder texture (1 x 1 transparent), so that quads of texture are
+    // not drawn while its pixels are not on GPU
+    // ******************************************************************************
+    static void BindPlaceholder(uint32_t slot)
+    {
+        Renderer::Submit([slot]()
+                         {
+            if (s_PlaceholderRendererId == 0)
+            {
+                uint32_t transparent = 0;
+                glGenTextures(1, &s_PlaceholderRendererId);
+                glBindTexture(GL_TEXTURE_2D, s_PlaceholderRendererId);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &transparent);
+            }
+            glActiveTexture(GL_TEXTURE0 + slot);
+            glBindTexture(GL_TEXTURE_2D, s_PlaceholderRendererId);
+        });
+    }
+    
+    // ******************************************************************************
+    // Get the Open GL format from number of channels
+    // ******************************************************************************
+    static void GetFormatFromChannels(int32_t channels, GLenum& internalFormat, GLenum& dataFormat)
+    {
+        if (4 == channels)
+        {
+            internalFormat = GL_RGBA8;
+            dataFormat     = GL_RGBA;
+        }
+        else if (3 == channels)
+        {
+            internalFormat = GL_RGB8;
+            dataFormat     = GL_RGB;
+        }
+        else
+        {
+            IK_CORE_ASSERT(false, "Invalid Format ");
+        }
+    }
+
     // ******************************************************************************
     // Open GL Texture Constructor
     // ******************************************************************************
     OpenGLTexture::OpenGLTexture(const std::string& path)
+    : OpenGLTexture(path, DecodeFile(path))
+    {
+    }
+    
+    // ******************************************************************************
+    // Open GL Texture Constructor from image decoded before
+    // ******************************************************************************
+    OpenGLTexture::OpenGLTexture(const std::string& path, const Image& image)
     : m_Filepath(path)
     {
         IK_CORE_INFO("Creating Open GL Texture from file : {0}", m_Filepath.c_str());
 
-        stbi_set_flip_vertically_on_load(1);
-
-        int32_t height, width, channel;
-        m_TextureData = stbi_load(m_Filepath.c_str(), &width, &height, &channel, 0);
-
-        if (!m_TextureData)
-            IK_CORE_CRITICAL("Failed to load stbi Image {0}", m_Filepath.c_str());
-
-        else
+        if (image.Data)
         {
+            SetImage(image);
             m_Uploaded = true;
-
-            m_Width   = width;
-            m_Height  = height;
-            m_Channel = channel;
-
-            if (4 == m_Channel)
-            {
-                m_InternalFormat = GL_RGBA8;
-                m_DataFormat     = GL_RGBA;
-            }
-            else if (3 == channel)
-            {
-                m_InternalFormat = GL_RGB8;
-                m_DataFormat     = GL_RGB;
-            }
-            else
-            {
-                IK_CORE_ASSERT(false, "Invalid Format ");
-            }
-
-            Renderer::Submit([this]()
-                                 {
-                glGenTextures(1, &m_RendererId);
-                glBindTexture(GL_TEXTURE_2D, m_RendererId);
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, m_TextureData);
-
-            });
+            Upload();
         }
+        TextureMemory::Register(this);
+        
+        // Reload the pixels in same texture instance so all the references stay valid
+        FileWatcher::Watch(m_Filepath, this, [this](const std::string&) { Reload(); });
     }
     
     // ******************************************************************************
     // Open GL Texture Constructor with white texture
     // ******************************************************************************
     OpenGLTexture::OpenGLTexture(uint32_t width, uint32_t height, void* data, uint32_t size)
-    : m_Width(width), m_Height(height), m_InternalFormat(GL_RGBA8), m_DataFormat(GL_RGBA), m_Size(size)
+    : m_Width(width), m_Height(height), m_Size(size), m_InternalFormat(GL_RGBA8), m_DataFormat(GL_RGBA)
     {
-        m_WhiteTextureData.Clear();
+        IK_CORE_INFO("Creating Open GL Texture with white data ");
+
+        uint16_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
+        IK_CORE_ASSERT((m_Size == m_Width * m_Height * bpp), "Data must be entire texture");
+        
         m_WhiteTextureData = Buffer::Copy(data, size);
+        m_Uploaded = true;
+        
+        Upload();
+        TextureMemory::Register(this);
+    }
+    
+    // ******************************************************************************
+    // Open GL Destructor
+    // ******************************************************************************
+    OpenGLTexture::~OpenGLTexture()
+    {
+        FileWatcher::Unwatch(this);
+        TextureMemory::Unregister(this);
+        m_WhiteTextureData.Clear();
+        
+        if (m_Reloading.valid())
+            stbi_image_free(m_Reloading.get().Data);
+
+        // Texture is already destroyed when command executes so capture by value
+        Renderer::Submit([rendererId = m_RendererId, textureData = m_TextureData]()
+                         {
+            IK_CORE_WARN("Destroying Open GL Texture");
+            glDeleteTextures(1, &rendererId);
+            if (textureData)
+                stbi_image_free(textureData);
+        });
+    }
+    
+    // ******************************************************************************
+    // Decode the image file. Can be called from any thread
+    // ******************************************************************************
+    OpenGLTexture::Image OpenGLTexture::DecodeFile(const std::string& path)
+    {
+        // Flip flag is thread local so that it does not affect other texture loading
+        stbi_set_flip_vertically_on_load_thread(1);
+        
+        int32_t height, width, channel;
+        Image image;
+        image.Data = stbi_load(path.c_str(), &width, &height, &channel, 0);
+        
+        if (!image.Data)
+        {
+            IK_CORE_CRITICAL("Failed to load stbi Image {0}", path.c_str());
+            return image;
+        }
+        
+        image.Width   = width;
+        image.Height  = height;
+        image.Channel = channel;
+        return image;
+    }
+    
+    // ******************************************************************************
+    // Store the decoded image to be uploaded
+    // ******************************************************************************
+    void OpenGLTexture::SetImage(const Image& image) const
+    {
+        m_TextureData = image.Data;
+        m_Width       = image.Width;
+        m_Height      = image.Height;
+        m_Channel     = image.Channel;
+        m_Size        = image.Width * image.Height * image.Channel;
+        GetFormatFromChannels(image.Channel, m_InternalFormat, m_DataFormat);
+    }
+    
+    // ******************************************************************************
+    // File is changed on disk, decode it again on worker thread
+    // ******************************************************************************
+    void OpenGLTexture::Reload()
+    {
+        // Drop the older reload if file is changed again before that got applied
+        if (m_Reloading.valid())
+            stbi_image_free(m_Reloading.get().Data);
+        
+        m_Reloading = std::async(std::launch::async, DecodeFile, m_Filepath);
+    }
+    
+    // ******************************************************************************
+    // Replace the GL texture with reloaded pixels once decoding is done. Texture
+    // instance is same so all the references to it get new pixels. Evicted texture
+    // is uploaded again here too
+    // ******************************************************************************
+    void OpenGLTexture::ApplyReloadIfReady() const
+    {
+        if (!m_Reloading.valid() || m_Reloading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        
+        Image image = m_Reloading.get();
+        if (!image.Data)
+        {
+            // Evicted texture can not be restored, stop decoding it on every bind
+            if (!m_Resident)
+                m_Uploaded = false;
+            return;
+        }
+        
+        IK_CORE_INFO("Reloading Open GL Texture {0}", m_Filepath.c_str());
+        
+        if (m_Resident)
+            Renderer::Submit([rendererId = m_RendererId]() { glDeleteTextures(1, &rendererId); });
+        
+        SetImage(image);
+        m_Uploaded = true;
+        Upload();
+    }
+    
+    // ******************************************************************************
+    // Upload the pixels to GPU from Render Command Queue
+    // ******************************************************************************
+    void OpenGLTexture::Upload() const
+    {
+        m_Resident = true;
         Renderer::Submit([this]()
                          {
-            IK_CORE_INFO("Creating Open GL Texture with white data ");
-
             glGenTextures(1, &m_RendererId);
             glBindTexture(GL_TEXTURE_2D, m_RendererId);
 
@@ -88,24 +224,31 @@ namespace iKan {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-            uint16_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
-            IK_CORE_ASSERT((m_Size == m_Width * m_Height * bpp), "Data must be entire texture");
-            glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, (stbi_uc*)(m_WhiteTextureData.Data));
+            const void* pixels = m_TextureData ? m_TextureData : (void*)m_WhiteTextureData.Data;
+            glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, pixels);
+
+            // GPU has the copy now, file texture can be decoded again if evicted
+            if (m_TextureData)
+            {
+                stbi_image_free(m_TextureData);
+                m_TextureData = nullptr;
+            }
         });
     }
     
     // ******************************************************************************
-    // Open GL Destructor
+    // Release the GPU memory of texture. Texture reloads itself after next bind
     // ******************************************************************************
-    OpenGLTexture::~OpenGLTexture()
+    void OpenGLTexture::Evict()
     {
-        Renderer::Submit([this]()
-                         {
-            IK_CORE_WARN("Destroying Open GL Texture");
-            glDeleteTextures(1, &m_RendererId);
-            if (m_TextureData)
-                stbi_image_free(m_TextureData);
-        });
+        if (!m_Resident)
+            return;
+        
+        IK_CORE_INFO("Evicting Open GL Texture {0} ({1} bytes)", m_Filepath.c_str(), m_Size);
+
+        m_Resident = false;
+        Renderer::Submit([rendererId = m_RendererId]() { glDeleteTextures(1, &rendererId); });
+        m_RendererId = 0;
     }
     
     // ******************************************************************************
@@ -113,6 +256,31 @@ namespace iKan {
     // ******************************************************************************
     void OpenGLTexture::Bind(uint32_t slot) const
     {
+        ApplyReloadIfReady();
+        
+        // Evicted texture with its own pixels is uploaded again. File texture is
+        // decoded on worker thread and uploaded by a later bind, placeholder is
+        // bound till then so that bind never waits for decoding
+        if (!m_Resident && m_Uploaded)
+        {
+            if (m_Filepath.empty())
+            {
+                Upload();
+            }
+            else if (!m_Reloading.valid())
+            {
+                IK_CORE_INFO("Decoding evicted Open GL Texture {0}", m_Filepath.c_str());
+                m_Reloading = std::async(std::launch::async, DecodeFile, m_Filepath);
+            }
+        }
+        TextureMemory::OnBind(this);
+
+        if (!m_Resident)
+        {
+            BindPlaceholder(slot);
+            return;
+        }
+
         Renderer::Submit([this, slot]()
                          {
             glActiveTexture(GL_TEXTURE0 + slot);
@@ -129,163 +297,159 @@ namespace iKan {
     }
 
     // ******************************************************************************
-    // Open GL Cubemap Constructor
+    // Decode each face from seperate file. Runs on worker thread and decode all the
+    // files in parallel
     // ******************************************************************************
-    OpenGLCubeMapTexture::OpenGLCubeMapTexture(std::vector<std::string> paths)
+    OpenGLCubeMapTexture::Faces OpenGLCubeMapTexture::LoadFaces(const std::vector<std::string>& paths)
     {
-        Renderer::Submit([this, paths]()
-                         {
-            IK_CORE_INFO("Creating Open GL Cubemap from paths");
+        Faces faces;
 
-            stbi_set_flip_vertically_on_load(0);
-
-            glGenTextures(1, &m_RendererId);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererId);
+        std::vector<std::future<void>> decoding;
+        for (size_t i = 0; i < paths.size() && i < faces.size(); i++)
+        {
+            decoding.emplace_back(std::async(std::launch::async, [&face = faces[i], &path = paths[i]]()
+                                             {
+                // Flip flag is thread local so that it does not affect other texture loading
+                stbi_set_flip_vertically_on_load_thread(0);
+
+                int32_t width, height, channels;
+                uint8_t* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+                if (!data)
+                {
+                    IK_CORE_ERROR("Cubemap texture failed to load at path: {0}",  path);
+                    return;
+                }
 
-            int32_t width, height, nrChannels;
-            int32_t i = 0;
-            for (auto path : paths)
-            {
-                IK_CORE_INFO("{0}", path.c_str());
+                face.Width  = width;
+                face.Height = height;
+                GetFormatFromChannels(channels, face.InternalFormat, face.DataFormat);
 
-                uint8_t *data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-                GLenum internalFormat = GL_RGB8, dataFormat = GL_RGB;
+                face.Pixels.assign(data, data + (size_t)width * height * channels);
+                stbi_image_free(data);
+            }));
+        }
 
-                if (4 == nrChannels)
-                {
-                    internalFormat = GL_RGBA8;
-                    dataFormat     = GL_RGBA;
-                }
-                else if (3 == nrChannels)
-                {
-                    internalFormat = GL_RGB8;
-                    dataFormat     = GL_RGB;
-                }
-                else
-                {
-                    IK_CORE_ASSERT(false, "Invalid Format ");
-                }
+        for (auto& decode : decoding)
+            decode.wait();
 
-                if (data)
-                {
-                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-                    stbi_image_free(data);
-                }
-                else
-                {
-                    IK_CORE_ERROR("Cubemap texture failed to load at path: {0}",  path);
-                    stbi_image_free(data);
-                }
-                i++;
-            }
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-        });
+        return faces;
     }
-    
+
     // ******************************************************************************
-    // Open GL Cubemap Constructor
+    // Decode the single horizontal cross image and slice it in to 6 faces. Runs on
+    // worker thread and each face is copied row wise on its own thread
     // ******************************************************************************
-    OpenGLCubeMapTexture::OpenGLCubeMapTexture(const std::string& path)
+    OpenGLCubeMapTexture::Faces OpenGLCubeMapTexture::LoadCrossFaces(const std::string& path)
     {
-        Renderer::Submit([this, path]()
-                         {
-            IK_CORE_INFO("Constructing Open GL Cubemaps from path : {0}", path.c_str());
+        Faces faces;
 
-            int32_t width, height, channels;
-            stbi_set_flip_vertically_on_load(false);
-            uint8_t* imageData = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb);
+        // Flip flag is thread local so that it does not affect other texture loading
+        stbi_set_flip_vertically_on_load_thread(0);
 
-            if (!imageData)
-            {
-                IK_CORE_ERROR("Cubemap texture failed to load at path: {0}",  path);
-                stbi_image_free(imageData);
-            }
+        int32_t width, height, channels;
+        uint8_t* imageData = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb);
+        if (!imageData)
+        {
+            IK_CORE_ERROR("Cubemap texture failed to load at path: {0}",  path);
+            return faces;
+        }
 
-            uint32_t faceWidth  = width / 4;
-            uint32_t faceHeight = height / 3;
+        const uint32_t bpp        = 3;
+        const uint32_t faceWidth  = width / 4;
+        const uint32_t faceHeight = height / 3;
 
-            IK_CORE_ASSERT((faceWidth == faceHeight), "Non-square faces!");
+        IK_CORE_ASSERT((faceWidth == faceHeight), "Non-square faces!");
 
-            std::array<uint8_t*, 6> faces;
-            for (size_t i = 0; i < faces.size(); i++)
-            {
-                faces[i] = new uint8_t[faceWidth * faceHeight * 3]; // 3 BPP
-            }
+        // Column and row of each face in the cross, in order of GL_TEXTURE_CUBE_MAP_POSITIVE_X + i
+        //          +Y
+        //      -X  +Z  +X  -Z
+        //          -Y
+        constexpr uint32_t crossCell[6][2] = { { 2, 1 }, { 0, 1 }, { 1, 0 }, { 1, 2 }, { 1, 1 }, { 3, 1 } };
 
-            int32_t faceIndex = 0;
+        std::array<std::future<void>, 6> slicing;
+        for (size_t i = 0; i < faces.size(); i++)
+        {
+            slicing[i] = std::async(std::launch::async, [&face = faces[i], &cell = crossCell[i], imageData, width, faceWidth, faceHeight, bpp]()
+                                    {
+                face.Width  = faceWidth;
+                face.Height = faceHeight;
+                face.Pixels.resize((size_t)faceWidth * faceHeight * bpp);
 
-            for (size_t i = 0; i < 4; i++)
-            {
+                const size_t rowSize = (size_t)faceWidth * bpp;
                 for (size_t y = 0; y < faceHeight; y++)
                 {
-                    size_t yOffset = y + faceHeight;
-                    for (size_t x = 0; x < faceWidth; x++)
-                    {
-                        size_t xOffset = x + i * faceWidth;
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 0] = imageData[(xOffset + yOffset * width) * 3 + 0];
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 1] = imageData[(xOffset + yOffset * width) * 3 + 1];
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 2] = imageData[(xOffset + yOffset * width) * 3 + 2];
-                    }
+                    const uint8_t* srcRow = imageData + ((cell[1] * faceHeight + y) * width + cell[0] * faceWidth) * bpp;
+                    memcpy(face.Pixels.data() + y * rowSize, srcRow, rowSize);
                 }
-                faceIndex++;
-            }
+            });
+        }
 
-            for (size_t i = 0; i < 3; i++)
-            {
-                // Skip the middle one
-                if (i == 1)
-                {
-                    continue;
-                }
+        for (auto& slice : slicing)
+            slice.wait();
 
-                for (size_t y = 0; y < faceHeight; y++)
-                {
-                    size_t yOffset = y + i * faceHeight;
-                    for (size_t x = 0; x < faceWidth; x++)
-                    {
-                        size_t xOffset = x + faceWidth;
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 0] = imageData[(xOffset + yOffset * width) * 3 + 0];
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 1] = imageData[(xOffset + yOffset * width) * 3 + 1];
-                        faces[faceIndex][(x + y * faceWidth) * 3 + 2] = imageData[(xOffset + yOffset * width) * 3 + 2];
-                    }
-                }
-                faceIndex++;
-            }
+        stbi_image_free(imageData);
+        return faces;
+    }
 
-            glGenTextures(1, &m_RendererId);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererId);
+    // ******************************************************************************
+    // Open GL Cubemap Constructor
+    // ******************************************************************************
+    OpenGLCubeMapTexture::OpenGLCubeMapTexture(std::vector<std::string> paths)
+    {
+        IK_CORE_INFO("Creating Open GL Cubemap from paths");
+        m_LoadingFaces = std::async(std::launch::async, &OpenGLCubeMapTexture::LoadFaces, std::move(paths));
+    }
+    
+    // ******************************************************************************
+    // Open GL Cubemap Constructor
+    // ******************************************************************************
+    OpenGLCubeMapTexture::OpenGLCubeMapTexture(const std::string& path)
+    : m_GenerateMipmap(true)
+    {
+        IK_CORE_INFO("Constructing Open GL Cubemaps from path : {0}", path.c_str());
+        m_LoadingFaces = std::async(std::launch::async, &OpenGLCubeMapTexture::LoadCrossFaces, path);
+    }
+
+    // ******************************************************************************
+    // Upload the faces if worker threads are done with decoding. Should be called
+    // from Render Command Queue. Never blocks
+    // ******************************************************************************
+    void OpenGLCubeMapTexture::UploadIfReady() const
+    {
+        if (m_Uploaded || !m_LoadingFaces.valid())
+            return;
 
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        if (m_LoadingFaces.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
 
-            auto format = GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[2]);
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[0]);
+        Faces faces = m_LoadingFaces.get();
 
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[4]);
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[5]);
+        glGenTextures(1, &m_RendererId);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererId);
 
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[1]);
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0, format, faceWidth, faceHeight, 0, format, GL_UNSIGNED_BYTE, faces[3]);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, m_GenerateMipmap ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        // Rows of faces are tightly packed
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t i = 0; i < faces.size(); i++)
+        {
+            const auto& face = faces[i];
+            if (face.Pixels.empty())
+                continue;
 
-            glBindTexture(GL_TEXTURE_2D, 0);
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, face.InternalFormat, face.Width, face.Height, 0, face.DataFormat, GL_UNSIGNED_BYTE, face.Pixels.data());
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-            for (size_t i = 0; i < faces.size(); i++)
-            {
-                delete[] faces[i];
-            }
+        if (m_GenerateMipmap)
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
-            stbi_image_free(imageData);
-        });
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        m_Uploaded = true;
     }
 
     // ******************************************************************************
@@ -293,24 +457,30 @@ namespace iKan {
     // ******************************************************************************
     OpenGLCubeMapTexture::~OpenGLCubeMapTexture()
     {
-        Renderer::Submit([this]()
+        // Wait for the worker threads as they are writing in to the faces
+        if (m_LoadingFaces.valid())
+            m_LoadingFaces.wait();
+
+        uint32_t rendererId = m_RendererId;
+        Renderer::Submit([rendererId]()
                          {
             IK_CORE_WARN("Destroying OpenGL Cubemap");
-            glDeleteTextures(1, &m_RendererId);
+            glDeleteTextures(1, &rendererId);
         });
     }
     
     // ******************************************************************************
-    // Bind Open GL Cubemap
+    // Bind Open GL Cubemap. Faces are uploaded at first bind after loading is done
     // ******************************************************************************
     void OpenGLCubeMapTexture::Bind(uint32_t slot) const
     {
         Renderer::Submit([this, slot]()
                          {
+            UploadIfReady();
+
             glActiveTexture(GL_TEXTURE0 + slot);
-            glBindTexture(GL_TEXTURE_2D, m_RendererId);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererId);
         });
     }
 
 }
-    
@@ -11,6 +11,7 @@
 
 #include <iKan/Renderer/Texture.h>
 #include <glad/glad.h>
+#include <future>
 
 namespace iKan {
     
@@ -21,55 +22,105 @@ namespace iKan {
     {
     public:
         OpenGLTexture(const std::string& path);
+        OpenGLTexture(const std::string& path, const Image& image);
         OpenGLTexture(uint32_t width, uint32_t height, void* data, uint32_t size);
         
         virtual ~OpenGLTexture();
 
         virtual bool Uploaded() const override { return m_Uploaded; }
+        virtual bool Resident() const override { return m_Resident; }
         
         virtual uint32_t GetWidth() const override { return m_Width;  }
         virtual uint32_t GetHeight() const override { return m_Height; }
         virtual uint32_t GetRendererID() const override { return m_RendererId; }
+        
+        virtual uint64_t GetGpuMemory() const override { return m_Resident ? m_Size : 0; }
+        virtual uint64_t GetCpuMemory() const override { return (m_TextureData ? m_Size : 0) + m_WhiteTextureData.Size; }
 
         virtual void Bind(uint32_t slot = 0) const override;
         virtual void Unbind() const override;
+        virtual void Evict() override;
 
         virtual std::string GetfilePath() const override { return m_Filepath; }
 
-        virtual bool operator==(const Texture& other) const override
-        {
-            return m_RendererId == ((OpenGLTexture&)other).m_RendererId;
-        }
+        // Renderer ID changes when texture is reloaded after eviction, so compare the instance
+        virtual bool operator==(const Texture& other) const override { return this == &other; }
+        
+        static Image DecodeFile(const std::string& path);
+        
+    private:
+        void SetImage(const Image& image) const;
+        void Upload() const;
+        void Reload();
+        void ApplyReloadIfReady() const;
         
     private:
-        bool m_Uploaded = false;
+        mutable bool m_Uploaded = false;
+
+        // Texture is resident from upload submission till eviction
+        mutable bool m_Resident = false;
+        mutable uint32_t m_RendererId = 0;
 
-        uint32_t m_RendererId;
-        uint32_t m_Width, m_Height;
-        uint32_t m_Channel;
-        uint32_t m_Size;
+        // Updated when file is decoded again on reload
+        mutable uint32_t m_Width = 0, m_Height = 0;
+        mutable uint32_t m_Channel = 4;
+        mutable uint32_t m_Size = 0;
 
-        void*  m_TextureData;
+        // Decoded pixels of file texture. Freed once uploaded and decoded again
+        // from file if texture is reloaded after eviction
+        mutable void* m_TextureData = nullptr;
         Buffer m_WhiteTextureData;
-        GLenum m_InternalFormat = GL_RGBA8, m_DataFormat = GL_RGBA;
+        mutable GLenum m_InternalFormat = GL_RGBA8, m_DataFormat = GL_RGBA;
         
         std::string m_Filepath;
+        
+        // File decoded on worker thread when it is changed on disk, or when evicted
+        // texture is bound again
+        mutable std::future<Image> m_Reloading;
     };
     
     // ******************************************************************************
-    // Implementation for OpenGL Cubemap
+    // Implementation for OpenGL Cubemap. Images are decoded and sliced in to faces
+    // on worker threads, only the final upload is done from Render Command Queue
+    // once faces are ready
     // ******************************************************************************
     class OpenGLCubeMapTexture : public CubeMapTexture
     {
+    public:
+        // ******************************************************************************
+        // Decoded pixels of one face
+        // ******************************************************************************
+        struct FaceData
+        {
+            uint32_t Width = 0, Height = 0;
+            GLenum InternalFormat = GL_RGB8, DataFormat = GL_RGB;
+            std::vector<uint8_t> Pixels;
+        };
+        
+        // Faces are in order of GL_TEXTURE_CUBE_MAP_POSITIVE_X + i
+        using Faces = std::array<FaceData, 6>;
+        
     public:
         OpenGLCubeMapTexture(std::vector<std::string> paths);
         OpenGLCubeMapTexture(const std::string& path);
         
         virtual ~OpenGLCubeMapTexture();
         virtual void Bind(uint32_t slot = 0) const override;
+        virtual bool Uploaded() const override { return m_Uploaded; }
         
     private:
-        uint32_t m_RendererId;
+        void UploadIfReady() const;
+        
+        static Faces LoadFaces(const std::vector<std::string>& paths);
+        static Faces LoadCrossFaces(const std::string& path);
+        
+    private:
+        bool m_GenerateMipmap = false;
+        
+        // Updated from Render Command Queue when faces gets ready
+        mutable bool m_Uploaded = false;
+        mutable uint32_t m_RendererId = 0;
+        mutable std::future<Faces> m_LoadingFaces;
     };
     
 }
@@ -100,8 +100,10 @@ namespace iKan {
             glBindVertexArray(m_RendererId);
             m_VertexBuffers.push_back(vertexBuffer);
 
-            uint32_t index = 0;
+            // Attributes of next buffer continue after the previous buffers
+            uint32_t& index = m_VertexAttribIndex;
             const auto& layout = vertexBuffer->GetLayout();
+            GLuint divisor = layout.IsInstanced() ? 1 : 0;
             for (const auto& element : layout.GetElements())
             {
                 switch (element.Type)
@@ -118,6 +120,7 @@ namespace iKan {
                                               ShaderDataTypeToOpenGLBaseType(element.Type),
                                               layout.GetStride(),
                                               (const void*)element.Offset);
+                        glVertexAttribDivisor(index, divisor);
                         index++;
                         break;
                     }
@@ -134,6 +137,7 @@ namespace iKan {
                                               element.Normalized ? GL_TRUE : GL_FALSE,
                                               layout.GetStride(),
                                               (const void*)element.Offset);
+                        glVertexAttribDivisor(index, divisor);
                         index++;
                         break;
                     }
@@ -35,6 +35,7 @@ namespace iKan {
         
     private:
         uint32_t m_RendererId;
+        uint32_t m_VertexAttribIndex = 0;
         std::vector<Ref<VertexBuffer>> m_VertexBuffers;
         Ref<IndexBuffer> m_IndexBuffer;
     };
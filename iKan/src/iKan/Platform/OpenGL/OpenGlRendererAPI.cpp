@@ -9,6 +9,7 @@
 
 #include <iKan/Platform/OpenGL/OpenGlRendererAPI.h>
 #include <iKan/Renderer/Renderer.h>
+#include <iKan/Platform/OpenGL/OpenGLShader.h>
 #include <glad/glad.h>
 
 namespace iKan {
@@ -30,6 +31,16 @@ namespace iKan {
         caps.Vendor   = (const char*)glGetString(GL_VENDOR);
         caps.Renderer = (const char*)glGetString(GL_RENDERER);
         caps.Version  = (const char*)glGetString(GL_VERSION);
+        
+        GLint numExtensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+        for (GLint i = 0; i < numExtensions; i++)
+        {
+            std::string extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (extension == "GL_KHR_parallel_shader_compile" || extension == "GL_ARB_parallel_shader_compile")
+                caps.ParallelShaderCompile = true;
+        }
+        IK_CORE_INFO("Parallel shader compile is {0}", caps.ParallelShaderCompile ? "supported" : "not supported");
     }
     
     // ******************************************************************************
@@ -99,6 +110,7 @@ namespace iKan {
     {
         uint32_t numIndices = count == 0 ? vertexArray->GetIndexBuffer()->GetCount() : count;
         vertexArray->Bind();
+        OpenGLShader::FlushBoundUniforms();
         glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, nullptr);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
@@ -108,10 +120,22 @@ namespace iKan {
     // ******************************************************************************
     void OpenGlRendererAPI::DrawIndexed(uint32_t count)
     {
+        OpenGLShader::FlushBoundUniforms();
         glDrawArrays(GL_TRIANGLES, 0, count);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
+    // ******************************************************************************
+    // Draw the instances of Vertex Array
+    // ******************************************************************************
+    void OpenGlRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount)
+    {
+        vertexArray->Bind();
+        OpenGLShader::FlushBoundUniforms();
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
     // ******************************************************************************
     // Get the pixel from scene
     // mx -> Mouse position X
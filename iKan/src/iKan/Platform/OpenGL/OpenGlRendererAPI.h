@@ -27,6 +27,7 @@ namespace iKan {
         virtual void SetViewPort(uint32_t widht, uint32_t height) override;
         virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0) override;
         virtual void DrawIndexed(uint32_t count) override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount) override;
         virtual void GetEntityIdFromPixels(int32_t mx, int32_t my, int32_t& pixelData) override;
     };
     
@@ -56,4 +56,18 @@ namespace iKan {
         return nullptr;
     }
     
+    // ******************************************************************************
+    // Creating instance of Uniform Buffer
+    // ******************************************************************************
+    Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None   : IK_CORE_ASSERT(false, "Render API not Supporting");
+            case RendererAPI::API::OpenGL : return CreateRef<OpenGLUniformBuffer>(size, binding); break;
+        }
+        IK_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+    
 }
@@ -100,6 +100,10 @@ namespace iKan {
         
         uint32_t GetStride() const { return m_Stride; }
         
+        // Instanced layout advances once per instance instead of once per vertex
+        void SetInstanced(bool instanced) { m_Instanced = instanced; }
+        bool IsInstanced() const { return m_Instanced; }
+        
         std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
         std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
         std::vector<BufferElement>::const_iterator begin() const { return m_Elements.begin(); }
@@ -124,6 +128,7 @@ namespace iKan {
     private:
         std::vector<BufferElement> m_Elements;
         uint32_t                   m_Stride = 0;
+        bool                       m_Instanced = false;
     };
     
     // ******************************************************************************
@@ -165,4 +170,21 @@ namespace iKan {
         static Ref<IndexBuffer> Create(uint32_t count, uint32_t* data);
     };
     
+    // ******************************************************************************
+    // Interface of Uniform Buffer class. Buffer is bound to fixed binding point so
+    // all the shaders declaring the block share the same data
+    // ******************************************************************************
+    class UniformBuffer
+    {
+    public:
+        virtual ~UniformBuffer() = default;
+        
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+        
+        virtual uint32_t GetBinding() const = 0;
+        virtual uint32_t GetRendererID() const = 0;
+        
+        static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+    };
+    
 }
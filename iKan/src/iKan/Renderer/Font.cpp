@@ -0,0 +1,327 @@
+// ******************************************************************************
+// File         : Font.cpp
+// Description  : Signed distance field font atlas and text layout
+// Project      : i-Kan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "Font.h"
+#include <filesystem>
+
+// Imgui ships stb truetype, implementation is kept private to this file
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include <imstb_truetype.h>
+
+namespace iKan {
+
+    static const std::string s_FontCacheDirectory = "../../../Cache/Fonts/";
+
+    // Update when layout of cache file changes
+    static constexpr uint32_t s_CacheMagic   = 0x4453464B; // "KFSD"
+    static constexpr uint32_t s_CacheVersion = 1;
+
+    // Width of atlas, height grows with the glyphs till maximum height
+    static constexpr uint32_t s_AtlasWidth     = 512;
+    static constexpr uint32_t s_MaxAtlasHeight = 8192;
+
+    // ******************************************************************************
+    // Next power of 2 of value
+    // ******************************************************************************
+    static uint32_t NextPowerOf2(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    // ******************************************************************************
+    // Create the font. Fonts are shared by path and size, so font is baked or loaded
+    // once even if many entities use it
+    // ******************************************************************************
+    Ref<Font> Font::Create(const std::string& path, uint32_t pixelHeight)
+    {
+        static std::unordered_map<std::string, std::weak_ptr<Font>> s_Fonts;
+
+        pixelHeight = std::clamp(pixelHeight, s_MinPixelHeight, s_MaxPixelHeight);
+        std::string key = path + ":" + std::to_string(pixelHeight);
+        if (Ref<Font> font = s_Fonts[key].lock())
+            return font;
+
+        // Drop the fonts that are destroyed
+        for (auto it = s_Fonts.begin(); it != s_Fonts.end();)
+            it = it->second.expired() && it->first != key ? s_Fonts.erase(it) : std::next(it);
+
+        Ref<Font> font = CreateRef<Font>(path, pixelHeight);
+        s_Fonts[key] = font;
+        return font;
+    }
+
+    // ******************************************************************************
+    // Font constructor. Load the atlas from cache or bake it from TTF
+    // ******************************************************************************
+    Font::Font(const std::string& path, uint32_t pixelHeight)
+    : m_Path(path), m_PixelHeight(std::clamp(pixelHeight, s_MinPixelHeight, s_MaxPixelHeight))
+    {
+        IK_CORE_INFO("Creating Font {0} of size {1}", path, m_PixelHeight);
+
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in)
+        {
+            IK_CORE_ERROR("Could not open font file '{0}'", path);
+            return;
+        }
+        std::vector<uint8_t> ttf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        uint64_t ttfHash = Utils::Hash(ttf.data(), ttf.size());
+
+        std::string cachePath = s_FontCacheDirectory + std::filesystem::path(path).stem().string() + "_" + std::to_string(m_PixelHeight) + ".sdf";
+
+        // Distance of each texel of atlas
+        std::vector<uint8_t> distances;
+        if (!LoadCache(cachePath, ttfHash, distances))
+        {
+            if (!Bake(ttf, distances))
+                return;
+            SaveCache(cachePath, ttfHash, distances);
+        }
+
+        // Atlas is white, distance is in alpha so it can be tinted like sprites
+        std::vector<uint8_t> pixels((size_t)m_AtlasWidth * m_AtlasHeight * 4, 255);
+        for (size_t i = 0; i < distances.size(); i++)
+            pixels[i * 4 + 3] = distances[i];
+
+        m_Atlas = Texture::Create(m_AtlasWidth, m_AtlasHeight, pixels.data(), (uint32_t)pixels.size());
+    }
+
+    // ******************************************************************************
+    // Bake the distance field of glyphs in atlas
+    // ******************************************************************************
+    bool Font::Bake(const std::vector<uint8_t>& ttf, std::vector<uint8_t>& distances)
+    {
+        IK_CORE_INFO("Baking signed distance field atlas of Font {0}", m_Path);
+
+        stbtt_fontinfo info;
+        if (!stbtt_InitFont(&info, ttf.data(), stbtt_GetFontOffsetForIndex(ttf.data(), 0)))
+        {
+            IK_CORE_ERROR("Invalid font file '{0}'", m_Path);
+            return false;
+        }
+
+        float scale = stbtt_ScaleForPixelHeight(&info, (float)m_PixelHeight);
+
+        int32_t ascent, descent, lineGap;
+        stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+        float lineHeight = (float)(ascent - descent + lineGap) * scale;
+        if (lineHeight <= 0.0f)
+        {
+            IK_CORE_ERROR("Invalid line height of font '{0}'", m_Path);
+            return false;
+        }
+
+        // Distance is 0.5 (128) on edge and fades to 0 at padding pixels outside
+        int32_t padding = std::max(4, (int32_t)m_PixelHeight / 8);
+        float distanceScale = 128.0f / (float)padding;
+
+        // ******************************************************************************
+        // Distance field of one glyph, freed after copying in atlas
+        // ******************************************************************************
+        struct GlyphBitmap
+        {
+            uint8_t* Data = nullptr;
+            int32_t Width = 0, Height = 0, XOffset = 0, YOffset = 0;
+            uint32_t X = 0, Y = 0;
+        };
+        GlyphBitmap bitmaps[s_NumGlyphs];
+        std::fill(std::begin(m_Glyphs), std::end(m_Glyphs), Glyph());
+
+        // Pack the glyphs in rows with 1 texel gap
+        uint32_t x = 1, y = 1, rowHeight = 0;
+        for (uint32_t i = 0; i < s_NumGlyphs; i++)
+        {
+            int32_t codepoint = s_FirstCharacter + (int32_t)i;
+            GlyphBitmap& bitmap = bitmaps[i];
+            bitmap.Data = stbtt_GetCodepointSDF(&info, scale, codepoint, padding, 128, distanceScale, &bitmap.Width, &bitmap.Height, &bitmap.XOffset, &bitmap.YOffset);
+
+            int32_t advance, leftSideBearing;
+            stbtt_GetCodepointHMetrics(&info, codepoint, &advance, &leftSideBearing);
+            m_Glyphs[i].Advance = (float)advance * scale / lineHeight;
+
+            // Space has no bitmap
+            if (!bitmap.Data)
+                continue;
+
+            if (x + bitmap.Width + 1 > s_AtlasWidth)
+            {
+                x  = 1;
+                y += rowHeight + 1;
+                rowHeight = 0;
+            }
+
+            // Glyph that does not fit in atlas is not drawn
+            if (bitmap.Width + 2 > (int32_t)s_AtlasWidth || y + bitmap.Height + 1 > s_MaxAtlasHeight)
+            {
+                IK_CORE_WARN("Glyph '{0}' of Font {1} does not fit in atlas", (char)codepoint, m_Path);
+                stbtt_FreeSDF(bitmap.Data, nullptr);
+                bitmap.Data = nullptr;
+                continue;
+            }
+            bitmap.X = x;
+            bitmap.Y = y;
+
+            x += bitmap.Width + 1;
+            rowHeight = std::max(rowHeight, (uint32_t)bitmap.Height);
+        }
+
+        m_AtlasWidth  = s_AtlasWidth;
+        m_AtlasHeight = NextPowerOf2(y + rowHeight + 1);
+        distances.assign((size_t)m_AtlasWidth * m_AtlasHeight, 0);
+
+        for (uint32_t i = 0; i < s_NumGlyphs; i++)
+        {
+            GlyphBitmap& bitmap = bitmaps[i];
+            if (!bitmap.Data)
+                continue;
+
+            for (int32_t row = 0; row < bitmap.Height; row++)
+                memcpy(&distances[(size_t)(bitmap.Y + row) * m_AtlasWidth + bitmap.X], bitmap.Data + row * bitmap.Width, bitmap.Width);
+
+            // Bitmap is top to bottom, y of quad is up
+            Glyph& glyph = m_Glyphs[i];
+            glyph.QuadMin = glm::vec2(bitmap.XOffset, -(bitmap.YOffset + bitmap.Height)) / lineHeight;
+            glyph.QuadMax = glm::vec2(bitmap.XOffset + bitmap.Width, -bitmap.YOffset) / lineHeight;
+            glyph.UVMin   = { (float)bitmap.X / m_AtlasWidth, (float)(bitmap.Y + bitmap.Height) / m_AtlasHeight };
+            glyph.UVMax   = { (float)(bitmap.X + bitmap.Width) / m_AtlasWidth, (float)bitmap.Y / m_AtlasHeight };
+
+            stbtt_FreeSDF(bitmap.Data, nullptr);
+        }
+
+        return true;
+    }
+
+    // ******************************************************************************
+    // Load the atlas from cache. Returns false if there is no cache or it is of other
+    // TTF file or version
+    // ******************************************************************************
+    bool Font::LoadCache(const std::string& cachePath, uint64_t ttfHash, std::vector<uint8_t>& distances)
+    {
+        std::ifstream in(cachePath, std::ios::in | std::ios::binary);
+        if (!in)
+            return false;
+
+        uint32_t magic = 0, version = 0, pixelHeight = 0;
+        uint64_t hash = 0;
+        in.read((char*)&magic, sizeof(magic));
+        in.read((char*)&version, sizeof(version));
+        in.read((char*)&hash, sizeof(hash));
+        in.read((char*)&pixelHeight, sizeof(pixelHeight));
+        in.read((char*)&m_AtlasWidth, sizeof(m_AtlasWidth));
+        in.read((char*)&m_AtlasHeight, sizeof(m_AtlasHeight));
+
+        if (!in || magic != s_CacheMagic || version != s_CacheVersion || hash != ttfHash || pixelHeight != m_PixelHeight)
+        {
+            IK_CORE_INFO("Cached atlas of Font {0} is out of date", m_Path);
+            return false;
+        }
+
+        // Size of atlas should be the one that is baked, and match the rest of file
+        std::streamoff headerEnd = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streamoff payloadSize = in.tellg() - headerEnd;
+        in.seekg(headerEnd);
+
+        size_t atlasSize = (size_t)m_AtlasWidth * m_AtlasHeight;
+        if (m_AtlasWidth != s_AtlasWidth || m_AtlasHeight == 0 || m_AtlasHeight > s_MaxAtlasHeight || payloadSize != (std::streamoff)(sizeof(m_Glyphs) + atlasSize))
+        {
+            IK_CORE_WARN("Cached atlas of Font {0} is corrupted", m_Path);
+            return false;
+        }
+
+        distances.resize(atlasSize);
+        in.read((char*)m_Glyphs, sizeof(m_Glyphs));
+        in.read((char*)distances.data(), distances.size());
+        if (!in)
+            return false;
+
+        IK_CORE_INFO("Loaded atlas of Font {0} from cache", m_Path);
+        return true;
+    }
+
+    // ******************************************************************************
+    // Store the atlas in cache. Only distance is stored
+    // ******************************************************************************
+    void Font::SaveCache(const std::string& cachePath, uint64_t ttfHash, const std::vector<uint8_t>& distances) const
+    {
+        std::error_code error;
+        std::filesystem::create_directories(s_FontCacheDirectory, error);
+
+        std::ofstream out(cachePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            IK_CORE_WARN("Could not write Font cache '{0}'", cachePath);
+            return;
+        }
+
+        out.write((const char*)&s_CacheMagic, sizeof(s_CacheMagic));
+        out.write((const char*)&s_CacheVersion, sizeof(s_CacheVersion));
+        out.write((const char*)&ttfHash, sizeof(ttfHash));
+        out.write((const char*)&m_PixelHeight, sizeof(m_PixelHeight));
+        out.write((const char*)&m_AtlasWidth, sizeof(m_AtlasWidth));
+        out.write((const char*)&m_AtlasHeight, sizeof(m_AtlasHeight));
+        out.write((const char*)m_Glyphs, sizeof(m_Glyphs));
+        out.write((const char*)distances.data(), distances.size());
+    }
+
+    // ******************************************************************************
+    // Glyph of character
+    // ******************************************************************************
+    const Font::Glyph& Font::GetGlyph(char character) const
+    {
+        if (character < s_FirstCharacter || character > s_LastCharacter)
+            character = '?';
+        return m_Glyphs[character - s_FirstCharacter];
+    }
+
+    // ******************************************************************************
+    // Layout of string. Lines are split at '\n', each line is one unit below the
+    // previous. Layouts are cached by string, cache is cleared when it is full
+    // ******************************************************************************
+    const Font::Layout& Font::GetLayout(const std::string& text)
+    {
+        if (auto it = m_Layouts.find(text); it != m_Layouts.end())
+            return it->second;
+
+        if (m_Layouts.size() >= s_MaxCachedLayouts)
+            m_Layouts.clear();
+
+        Layout& layout = m_Layouts[text];
+        layout.Quads.reserve(text.size());
+
+        glm::vec2 pen = { 0.0f, 0.0f };
+        float width = 0.0f;
+        for (char character : text)
+        {
+            if (character == '\n')
+            {
+                width = std::max(width, pen.x);
+                pen   = { 0.0f, pen.y - 1.0f };
+                continue;
+            }
+
+            const Glyph& glyph = GetGlyph(character);
+            if (glyph.QuadMax.x > glyph.QuadMin.x)
+            {
+                Glyph& quad  = layout.Quads.emplace_back(glyph);
+                quad.QuadMin += pen;
+                quad.QuadMax += pen;
+            }
+            pen.x += glyph.Advance;
+        }
+
+        layout.Size = { std::max(width, pen.x), 1.0f - pen.y };
+        return layout;
+    }
+
+}
@@ -0,0 +1,95 @@
+// ******************************************************************************
+// File         : Font.h
+// Description  : Signed distance field font atlas and text layout
+// Project      : i-Kan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <iKan/Renderer/Texture.h>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Font baked in a signed distance field atlas. Glyphs of printable ASCII are
+    // baked from TTF file on first use and atlas is cached on disk, next time atlas
+    // is loaded from cache if TTF is not changed. Distance is stored in alpha of
+    // atlas (0.5 is edge) so text stays sharp at any scale.
+    // All the metrics are in units of line height, so text of one line is one unit
+    // high when transform of text is not scaled
+    // ******************************************************************************
+    class Font
+    {
+    public:
+        // ******************************************************************************
+        // Glyph of atlas. Quad is relative to the pen position on base line
+        // ******************************************************************************
+        struct Glyph
+        {
+            glm::vec2 QuadMin = { 0.0f, 0.0f }, QuadMax = { 0.0f, 0.0f };
+            glm::vec2 UVMin   = { 0.0f, 0.0f }, UVMax   = { 0.0f, 0.0f };
+            float     Advance = 0.0f;
+        };
+
+        // ******************************************************************************
+        // Quads of laid out string. Origin is the pen position of first line
+        // ******************************************************************************
+        struct Layout
+        {
+            std::vector<Glyph> Quads;
+            glm::vec2 Size = { 0.0f, 0.0f };
+        };
+
+    public:
+        Font(const std::string& path, uint32_t pixelHeight);
+        ~Font() = default;
+
+        Font(const Font&) = delete;
+        Font& operator=(const Font&) = delete;
+
+        // Layout of string, cached so unchanged text is not laid out every frame
+        // NOTE: Reference is valid only till next GetLayout call of new string
+        const Layout& GetLayout(const std::string& text);
+
+        // Glyph of character, fallback glyph '?' for characters that are not baked
+        const Glyph& GetGlyph(char character) const;
+
+        const Ref<Texture>& GetAtlas() const { return m_Atlas; }
+        const std::string& GetPath() const { return m_Path; }
+        uint32_t GetPixelHeight() const { return m_PixelHeight; }
+
+        // Size is clamped to [s_MinPixelHeight, s_MaxPixelHeight]
+        static Ref<Font> Create(const std::string& path, uint32_t pixelHeight = 48);
+
+    private:
+        bool LoadCache(const std::string& cachePath, uint64_t ttfHash, std::vector<uint8_t>& pixels);
+        void SaveCache(const std::string& cachePath, uint64_t ttfHash, const std::vector<uint8_t>& pixels) const;
+        bool Bake(const std::vector<uint8_t>& ttf, std::vector<uint8_t>& pixels);
+
+    private:
+        // Printable ASCII
+        static constexpr char s_FirstCharacter = ' ';
+        static constexpr char s_LastCharacter  = '~';
+        static constexpr uint32_t s_NumGlyphs  = s_LastCharacter - s_FirstCharacter + 1;
+
+        // Number of strings whose layout is cached
+        static constexpr uint32_t s_MaxCachedLayouts = 256;
+
+        // Size of font is clamped in this range, so that glyphs fit in atlas
+        static constexpr uint32_t s_MinPixelHeight = 8;
+        static constexpr uint32_t s_MaxPixelHeight = 128;
+
+        std::string m_Path;
+        uint32_t m_PixelHeight = 48;
+        uint32_t m_AtlasWidth = 0, m_AtlasHeight = 0;
+
+        Glyph m_Glyphs[s_NumGlyphs];
+        Ref<Texture> m_Atlas;
+
+        std::unordered_map<std::string, Layout> m_Layouts;
+    };
+
+}
@@ -0,0 +1,190 @@
+// ******************************************************************************
+// File         : Material.cpp
+// Description  : Material, parameters and textures used to draw with a shader
+// Project      : i-Kan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "Material.h"
+
+namespace iKan {
+
+    // ******************************************************************************
+    // std140 base alignment and size of a member from its element size. Elements of
+    // arrays and matrix columns are aligned to vec4
+    // ******************************************************************************
+    static void GetStd140Layout(uint32_t elementSize, uint32_t count, uint32_t& alignment, uint32_t& size)
+    {
+        if (count > 1)
+        {
+            uint32_t stride = (elementSize + 15) & ~15u;
+            alignment = 16;
+            size      = stride * count;
+            return;
+        }
+
+        switch (elementSize)
+        {
+            case 4  : alignment = 4;  size = 4;  break;
+            case 8  : alignment = 8;  size = 8;  break;
+            case 12 : alignment = 16; size = 12; break;
+            case 36 : alignment = 16; size = 48; break; // mat3 : 3 columns of vec4
+            default : alignment = 16; size = (elementSize + 15) & ~15u; break;
+        }
+    }
+
+    // ******************************************************************************
+    // Create the material. Material is laid out again when its shader is reloaded
+    // ******************************************************************************
+    Ref<Material> Material::Create(const Ref<Shader>& shader)
+    {
+        Ref<Material> material = CreateRef<Material>(shader);
+
+        // Callback can not be removed from shader, so it does not keep material alive
+        std::weak_ptr<Material> weakMaterial = material;
+        shader->AddShaderReloadedCallback([weakMaterial]() {
+            if (Ref<Material> reloaded = weakMaterial.lock())
+                reloaded->Layout();
+        });
+        return material;
+    }
+
+    // ******************************************************************************
+    // Material constructor
+    // ******************************************************************************
+    Material::Material(const Ref<Shader>& shader)
+    : m_Shader(shader)
+    {
+        IK_CORE_INFO("Creating Material of shader {0}", shader->GetName());
+        Layout();
+    }
+
+    // ******************************************************************************
+    // Layout the parameter block from reflection of shader. Values of parameters and
+    // textures of previous layout are copied if shader still has them
+    // ******************************************************************************
+    void Material::Layout()
+    {
+        std::vector<Parameter> oldLayout = std::move(m_ParameterLayout);
+        Buffer oldParameters = Buffer::Copy(m_Parameters.Data, m_Parameters.Size);
+        auto oldTextures = std::move(m_Textures);
+
+        m_ParameterLayout.clear();
+        m_Textures.clear();
+        m_Parameters.Clear();
+        m_MaxInstances = 0;
+
+        uint32_t offset = 0;
+        const ShaderUniformBufferDeclaration* block = m_Shader->FindRendererUniformBuffer("r_Materials");
+        const ShaderStruct* materialStruct = nullptr;
+        if (block && !block->GetUniformDeclarations().empty())
+        {
+            const ShaderUniformDeclaration* instances = block->GetUniformDeclarations().front();
+            materialStruct = instances->GetStruct();
+            m_MaxInstances = instances->GetCount();
+        }
+
+        if (materialStruct)
+        {
+            for (const ShaderUniformDeclaration* field : materialStruct->GetFields())
+            {
+                uint32_t alignment, size;
+                GetStd140Layout(field->GetSize() / std::max(field->GetCount(), 1u), field->GetCount(), alignment, size);
+
+                offset = (offset + alignment - 1) & ~(alignment - 1);
+                m_ParameterLayout.push_back({ field->GetName(), offset, size });
+                offset += size;
+            }
+        }
+        else
+        {
+            IK_CORE_WARN("Shader {0} do not declare material instances in 'r_Materials' block", m_Shader->GetName());
+        }
+
+        // Struct in std140 array is rounded up to vec4
+        m_Parameters.Allocate((offset + 15) & ~15u);
+        m_Parameters.ZeroInitialize();
+
+        for (const Parameter& oldParameter : oldLayout)
+        {
+            const Parameter* parameter = FindParameter(oldParameter.Name);
+            if (parameter && parameter->Size == oldParameter.Size)
+                m_Parameters.Write(oldParameters.Data + oldParameter.Offset, oldParameter.Size, parameter->Offset);
+        }
+        oldParameters.Clear();
+
+        for (const ShaderResourceDeclaration* resource : m_Shader->GetResources())
+        {
+            auto it = std::find_if(oldTextures.begin(), oldTextures.end(), [&](const auto& texture) { return texture.first == resource->GetName(); });
+            m_Textures.emplace_back(resource->GetName(), it != oldTextures.end() ? it->second : nullptr);
+        }
+
+        if (m_Textures.size() > 1)
+            IK_CORE_ERROR("Shader {0} declares {1} samplers, material quads bind only one texture. Material will not be drawn", m_Shader->GetName(), m_Textures.size());
+    }
+
+    // ******************************************************************************
+    // Material destructor
+    // ******************************************************************************
+    Material::~Material()
+    {
+        m_Parameters.Clear();
+    }
+
+    // ******************************************************************************
+    // Find the parameter by name
+    // ******************************************************************************
+    const Material::Parameter* Material::FindParameter(const std::string& name) const
+    {
+        for (const auto& parameter : m_ParameterLayout)
+            if (parameter.Name == name)
+                return &parameter;
+
+        return nullptr;
+    }
+
+    // ******************************************************************************
+    // Set the texture of sampler
+    // ******************************************************************************
+    void Material::SetTexture(const std::string& name, const Ref<Texture>& texture)
+    {
+        for (auto& [samplerName, samplerTexture] : m_Textures)
+        {
+            if (samplerName == name)
+            {
+                samplerTexture = texture;
+                return;
+            }
+        }
+        IK_CORE_WARN("Sampler {0} not found in material of shader {1}", name, m_Shader->GetName());
+    }
+
+    // ******************************************************************************
+    // Get the texture of sampler
+    // ******************************************************************************
+    const Ref<Texture>& Material::GetTexture(const std::string& name) const
+    {
+        static const Ref<Texture> s_NoTexture;
+        for (const auto& [samplerName, samplerTexture] : m_Textures)
+            if (samplerName == name)
+                return samplerTexture;
+
+        return s_NoTexture;
+    }
+
+    // ******************************************************************************
+    // Get the texture of the only sampler. Material with more samplers has no main
+    // texture
+    // ******************************************************************************
+    const Ref<Texture>& Material::GetMainTexture() const
+    {
+        static const Ref<Texture> s_NoTexture;
+        if (m_Textures.size() != 1)
+            return s_NoTexture;
+
+        return m_Textures.front().second;
+    }
+
+}
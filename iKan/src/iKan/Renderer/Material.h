@@ -0,0 +1,117 @@
+// ******************************************************************************
+// File         : Material.h
+// Description  : Material, parameters and textures used to draw with a shader
+// Project      : i-Kan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <iKan/Core/Buffer.h>
+#include <iKan/Renderer/Shader.h>
+#include <iKan/Renderer/Texture.h>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Material of a shader. Parameters are laid out from the reflection of struct
+    // "Material" that the shader declares as array in renderer uniform block (see
+    // MaterialShader.glsl):
+    //
+    //     struct Material { vec4 Tint; vec2 UVOffset; float TilingFactor; };
+    //     layout(std140) uniform r_Materials { Material r_MaterialInstances[64]; };
+    //
+    // Parameter block is packed with std140 rules so that Renderer2D copies the
+    // blocks of all the materials of a batch in one uniform buffer upload, and the
+    // shader picks its block with per vertex material index. Texture is stored by
+    // the name of sampler declared in shader. Quads of batch sample the shared
+    // texture slots with per vertex slot index, so material has at most one
+    // sampler, materials of shaders with more samplers are not drawn.
+    // Layout is built again when shader is reloaded, values of parameters and
+    // textures that are still in shader are kept
+    // ******************************************************************************
+    class Material
+    {
+    public:
+        // ******************************************************************************
+        // Parameter of material block
+        // ******************************************************************************
+        struct Parameter
+        {
+            std::string Name;
+            uint32_t    Offset = 0;
+            uint32_t    Size   = 0;
+        };
+
+    public:
+        Material(const Ref<Shader>& shader);
+        ~Material();
+
+        Material(const Material&) = delete;
+        Material& operator=(const Material&) = delete;
+
+        // ******************************************************************************
+        // Set the value of parameter. Value is written in the packed block at offset
+        // of parameter
+        // ******************************************************************************
+        template<typename T>
+        void Set(const std::string& name, const T& value)
+        {
+            const Parameter* parameter = FindParameter(name);
+            if (!parameter)
+            {
+                IK_CORE_WARN("Parameter {0} not found in material of shader {1}", name, m_Shader->GetName());
+                return;
+            }
+            IK_CORE_ASSERT((sizeof(T) <= parameter->Size), "Parameter type mismatch");
+            m_Parameters.Write((void*)&value, sizeof(T), parameter->Offset);
+        }
+
+        // ******************************************************************************
+        // Get the value of parameter
+        // ******************************************************************************
+        template<typename T>
+        T& Get(const std::string& name)
+        {
+            const Parameter* parameter = FindParameter(name);
+            IK_CORE_ASSERT(parameter, "Parameter not found");
+            return m_Parameters.Read<T>(parameter->Offset);
+        }
+
+        void SetTexture(const std::string& name, const Ref<Texture>& texture);
+        const Ref<Texture>& GetTexture(const std::string& name) const;
+
+        // Texture of the only sampler, bound to texture slot of quad
+        const Ref<Texture>& GetMainTexture() const;
+        uint32_t GetNumSamplers() const { return (uint32_t)m_Textures.size(); }
+
+        const Ref<Shader>& GetShader() const { return m_Shader; }
+        const std::vector<Parameter>& GetParameters() const { return m_ParameterLayout; }
+
+        // Size of block is std140 stride of one element of instance array
+        const Buffer& GetParameterBlock() const { return m_Parameters; }
+        uint32_t GetParameterStride() const { return m_Parameters.Size; }
+
+        // Number of instances declared by shader in "r_Materials" block
+        uint32_t GetMaxInstances() const { return m_MaxInstances; }
+
+        static Ref<Material> Create(const Ref<Shader>& shader);
+
+    private:
+        const Parameter* FindParameter(const std::string& name) const;
+        void Layout();
+
+    private:
+        Ref<Shader> m_Shader;
+
+        std::vector<Parameter> m_ParameterLayout;
+        Buffer m_Parameters;
+        uint32_t m_MaxInstances = 0;
+
+        // One texture per sampler of shader, in order of declaration
+        std::vector<std::pair<std::string, Ref<Texture>>> m_Textures;
+    };
+
+}
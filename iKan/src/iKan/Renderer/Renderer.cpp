@@ -10,6 +10,8 @@
 #include "Renderer.h"
 #include <iKan/Renderer/SceneRenderer.h>
 #include <iKan/Renderer/RendererStats.h>
+#include <iKan/Renderer/TextureMemory.h>
+#include <iKan/Renderer/Shader.h>
 
 namespace iKan {
  
@@ -70,6 +72,15 @@ namespace iKan {
         Renderer::Submit([vertexArray, count]() { s_RendererAPI->DrawIndexed(vertexArray, count); });
     }
     
+    // ******************************************************************************
+    // Draw command for instances, each instance draws first indexCount indices
+    // ******************************************************************************
+    void Renderer::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount)
+    {
+        RendererStatistics::DrawCalls++;
+        Renderer::Submit([vertexArray, indexCount, instanceCount]() { s_RendererAPI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount); });
+    }
+    
     // ******************************************************************************
     // Shutdown all renderer
     // ******************************************************************************
@@ -87,11 +98,14 @@ namespace iKan {
     }
 
     // ******************************************************************************
-    // Run all the commands
+    // Run all the commands, check the shaders being compiled and evict the textures
+    // if over the memory budget
     // ******************************************************************************
     void Renderer::WaitAndRender()
     {
         s_Data.m_CommandQueue.Execute();
+        Shader::PollPendingCompiles();
+        TextureMemory::OnFrameEnd();
     }
 
 
@@ -25,6 +25,7 @@ namespace iKan {
         static void SetViewport(float width, float height);
         static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0);
         static void DrawIndexed(uint32_t count);
+        static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount);
         static void Shutdown();
         static void WaitAndRender();
 
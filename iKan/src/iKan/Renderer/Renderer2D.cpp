@@ -9,6 +9,7 @@
 
 #include "Renderer2D.h"
 #include <iKan/Renderer/VertexArray.h>
+#include <iKan/Renderer/Buffers.h>
 #include <iKan/Renderer/Shader.h>
 #include <iKan/Renderer/Renderer.h>
 #include <iKan/Renderer/RendererStats.h>
@@ -20,6 +21,34 @@ namespace iKan {
     // ******************************************************************************
     struct RendererQuadData
     {
+        // ******************************************************************************
+        // Options of Quad shader variants. Order is same as options passed to variants
+        // ******************************************************************************
+        enum QuadShaderOption : ShaderVariants::Key
+        {
+            Textured  = BIT(0),
+            IDBuffer  = BIT(1),
+            AlphaTest = BIT(2)
+        };
+        
+        // ******************************************************************************
+        // Options of SDF Shape shader variants
+        // ******************************************************************************
+        enum ShapeShaderOption : ShaderVariants::Key
+        {
+            ShapeIDBuffer = BIT(0)
+        };
+        
+        // ******************************************************************************
+        // Type of SDF Shape, same as constants in SDF Shape shader
+        // ******************************************************************************
+        enum ShapeType : int32_t
+        {
+            Circle      = 0,
+            RoundedRect = 1,
+            Capsule     = 2
+        };
+        
         // ******************************************************************************
         // Stores the vertex information of a Quad
         // ******************************************************************************
@@ -36,17 +65,68 @@ namespace iKan {
         };
         
         // ******************************************************************************
-        // Stores the vertex information of a Quad
+        // Stores the vertex information of a Quad drawn with Material
         // ******************************************************************************
-        struct CircleVertex
+        struct MaterialVertex
         {
             glm::vec3 Position;
             glm::vec4 Color;
             glm::vec2 TexCoord;
             
-            float Thickness;
-            float Fade;
+            float TexIndex;
+            float TilingFactor;
+            
+            int32_t ObjectID;
+            
+            // Index of material block in "r_Materials"
+            float MaterialIndex;
+        };
+        
+        // ******************************************************************************
+        // Stores one SDF Shape. Drawn as instance of unit quad, corners are computed
+        // in shader from axes and center of transform
+        // ******************************************************************************
+        struct ShapeInstance
+        {
+            glm::vec3 AxisX;
+            glm::vec3 AxisY;
+            glm::vec3 Center;
+            glm::vec4 Color;
             
+            // x = Thickness, y = Fade, z = Corner radius
+            glm::vec4 Params;
+            
+            int32_t Shape;
+            int32_t ObjectID;
+        };
+        
+        // ******************************************************************************
+        // Stores one line segment. Segment is expanded to quad of thickness (pixels)
+        // in shader
+        // ******************************************************************************
+        struct LineInstance
+        {
+            glm::vec3 Start;
+            glm::vec3 End;
+            glm::vec4 Color;
+            
+            float   Thickness;
+            int32_t ObjectID;
+        };
+        
+        // ******************************************************************************
+        // Stores one glyph of text. Position is bottom left corner of glyph quad and
+        // TexRect is UV of bottom left (xy) and top right (zw) corner in font atlas
+        // ******************************************************************************
+        struct GlyphInstance
+        {
+            glm::vec3 Position;
+            glm::vec3 AxisX;
+            glm::vec3 AxisY;
+            glm::vec4 TexRect;
+            glm::vec4 Color;
+            
+            float   TexIndex;
             int32_t ObjectID;
         };
 
@@ -55,11 +135,14 @@ namespace iKan {
         static const uint32_t MaxVertices     = MaxQuads * 4;
         static const uint32_t MaxIndices      = MaxQuads * 6;
         static const uint32_t MaxTextureSlots = 16;
+        
+        // Minimum size of uniform block guaranteed by Open GL
+        static const uint32_t MaxMaterialBufferSize = 16384;
 
         // Data storage for Rendering
         Ref<VertexArray>  QuadVertexArray;
         Ref<VertexBuffer> QuadVertexBuffer;
-        Ref<Shader>       TextureShader;
+        Scope<ShaderVariants> TextureShader;
 
         uint32_t QuadIndexCount = 0;
 
@@ -68,30 +151,82 @@ namespace iKan {
         Vertex* QuadVertexBufferPtr  = nullptr;
         
         
-        // Data storage for Rendering
-        Ref<VertexArray>  CircleQuadVertexArray;
-        Ref<VertexBuffer> CircleQuadVertexBuffer;
-        Ref<Shader>       CircleTextureShader;
+        // Corners of unit quad, per vertex buffer of instanced primitives
+        Ref<VertexBuffer> QuadCornerBuffer;
         
-        uint32_t CircleQuadIndexCount = 0;
+        // Data storage for SDF Shapes. Corner buffer is per vertex and instance
+        // buffer is per shape, indices are shared with quads
+        Ref<VertexArray>  ShapeVertexArray;
+        Ref<VertexBuffer> ShapeInstanceBuffer;
+        Scope<ShaderVariants> ShapeShader;
         
-        // Pointer attribute of vertexes
-        CircleVertex* CircleQuadVertexBufferBase = nullptr;
-        CircleVertex* CircleQuadVertexBufferPtr  = nullptr;
+        uint32_t ShapeCount = 0;
+        
+        // Pointer attribute of instances
+        ShapeInstance* ShapeInstanceBufferBase = nullptr;
+        ShapeInstance* ShapeInstanceBufferPtr  = nullptr;
         
 
+        // Data storage for Lines, drawn as instances like shapes
+        Ref<VertexArray>  LineVertexArray;
+        Ref<VertexBuffer> LineInstanceBuffer;
+        Scope<ShaderVariants> LineShader;
+        
+        uint32_t LineCount = 0;
+        
+        LineInstance* LineInstanceBufferBase = nullptr;
+        LineInstance* LineInstanceBufferPtr  = nullptr;
+        
+        // Data storage for Text, glyphs are instances like shapes and sample font
+        // atlas from texture slots shared with quads
+        Ref<VertexArray>  GlyphVertexArray;
+        Ref<VertexBuffer> GlyphInstanceBuffer;
+        Scope<ShaderVariants> TextShader;
+        
+        uint32_t GlyphCount = 0;
+        
+        GlyphInstance* GlyphInstanceBufferBase = nullptr;
+        GlyphInstance* GlyphInstanceBufferPtr  = nullptr;
+        
+        // Data storage for Material quads, batch is broken when shader changes
+        Ref<VertexArray>   MaterialVertexArray;
+        Ref<VertexBuffer>  MaterialVertexBuffer;
+        Ref<UniformBuffer> MaterialUniformBuffer;
+        Ref<Shader>        MaterialShader;
+        
+        // Shader of materials created by renderer, declares "r_Materials" block
+        Scope<ShaderVariants> DefaultMaterialShader;
+        
+        uint32_t MaterialIndexCount = 0;
+        
+        MaterialVertex* MaterialVertexBufferBase = nullptr;
+        MaterialVertex* MaterialVertexBufferPtr  = nullptr;
+        
+        // Materials of current batch and their index in uniform block
+        std::vector<Ref<Material>> MaterialSlots;
+        std::unordered_map<const Material*, uint32_t> MaterialSlotMap;
+        Buffer MaterialData;
+
         // array of textures for now 16 slots are possible
         std::array<Ref<Texture>, MaxTextureSlots> TextureSlots;
         uint32_t TextureSlotIndex = 1; /* 0 = white texture */
 
         // Basic vertex of quad
         glm::vec4 QuadVertexPositions[4];
+        
+        // Entity ID is needed only for mouse picking in editor
+        bool WriteIDBuffer = true;
 
         RendererQuadData() = default;
         ~RendererQuadData()
         {
             IK_CORE_WARN("Renderer2D Data instance Destryoyed and cleared the data");
             delete [] QuadVertexBufferBase;
+            delete [] ShapeInstanceBufferBase;
+            delete [] LineInstanceBufferBase;
+            delete [] GlyphInstanceBufferBase;
+            delete [] MaterialVertexBufferBase;
+            MaterialData.Clear();
         }
     };
     static RendererQuadData* s_Data = new RendererQuadData();
@@ -143,24 +278,114 @@ namespace iKan {
         
         /////////////////////////////////////////////////////////////////////////////
         {
-            s_Data->CircleQuadVertexArray  = VertexArray::Create();
+            s_Data->ShapeVertexArray = VertexArray::Create();
+            
+            // Corners of unit quad, same order as quad vertex positions
+            float corners[] = { -0.5f, -0.5f,   0.5f, -0.5f,   0.5f, 0.5f,   -0.5f, 0.5f };
+            s_Data->QuadCornerBuffer = VertexBuffer::Create(sizeof(corners), corners);
+            s_Data->QuadCornerBuffer->AddLayout ({
+                { ShaderDataType::Float2, "a_Corner" }
+            });
+            s_Data->ShapeVertexArray->AddVertexBuffer(s_Data->QuadCornerBuffer);
+            
+            // Instance Buffer and adding the layput
+            BufferLayout instanceLayout = {
+                { ShaderDataType::Float3, "a_AxisX" },
+                { ShaderDataType::Float3, "a_AxisY" },
+                { ShaderDataType::Float3, "a_Center" },
+                { ShaderDataType::Float4, "a_Color" },
+                { ShaderDataType::Float4, "a_Params" },
+                { ShaderDataType::Int,    "a_Shape" },
+                { ShaderDataType::Int,    "a_ObjectID" }
+            };
+            instanceLayout.SetInstanced(true);
+            
+            s_Data->ShapeInstanceBuffer = VertexBuffer::Create(s_Data->MaxQuads * sizeof(RendererQuadData::ShapeInstance));
+            s_Data->ShapeInstanceBuffer->AddLayout(instanceLayout);
+            s_Data->ShapeVertexArray->AddVertexBuffer(s_Data->ShapeInstanceBuffer);
+            s_Data->ShapeVertexArray->SetIndexBuffer(quadIB);
+            
+            // Allocating the memory for instance Buffer Pointer
+            s_Data->ShapeInstanceBufferBase = new RendererQuadData::ShapeInstance[s_Data->MaxQuads];
+        }
+        
+        /////////////////////////////////////////////////////////////////////////////
+        {
+            s_Data->LineVertexArray = VertexArray::Create();
+            s_Data->LineVertexArray->AddVertexBuffer(s_Data->QuadCornerBuffer);
+            
+            // Instance Buffer and adding the layput
+            BufferLayout instanceLayout = {
+                { ShaderDataType::Float3, "a_Start" },
+                { ShaderDataType::Float3, "a_End" },
+                { ShaderDataType::Float4, "a_Color" },
+                { ShaderDataType::Float,  "a_Thickness" },
+                { ShaderDataType::Int,    "a_ObjectID" }
+            };
+            instanceLayout.SetInstanced(true);
+            
+            s_Data->LineInstanceBuffer = VertexBuffer::Create(s_Data->MaxQuads * sizeof(RendererQuadData::LineInstance));
+            s_Data->LineInstanceBuffer->AddLayout(instanceLayout);
+            s_Data->LineVertexArray->AddVertexBuffer(s_Data->LineInstanceBuffer);
+            s_Data->LineVertexArray->SetIndexBuffer(quadIB);
+            
+            // Allocating the memory for instance Buffer Pointer
+            s_Data->LineInstanceBufferBase = new RendererQuadData::LineInstance[s_Data->MaxQuads];
+        }
+        
+        /////////////////////////////////////////////////////////////////////////////
+        {
+            s_Data->GlyphVertexArray = VertexArray::Create();
+            s_Data->GlyphVertexArray->AddVertexBuffer(s_Data->QuadCornerBuffer);
+            
+            // Instance Buffer and adding the layput
+            BufferLayout instanceLayout = {
+                { ShaderDataType::Float3, "a_Position" },
+                { ShaderDataType::Float3, "a_AxisX" },
+                { ShaderDataType::Float3, "a_AxisY" },
+                { ShaderDataType::Float4, "a_TexRect" },
+                { ShaderDataType::Float4, "a_Color" },
+                { ShaderDataType::Float,  "a_TexIndex" },
+                { ShaderDataType::Int,    "a_ObjectID" }
+            };
+            instanceLayout.SetInstanced(true);
+            
+            s_Data->GlyphInstanceBuffer = VertexBuffer::Create(s_Data->MaxQuads * sizeof(RendererQuadData::GlyphInstance));
+            s_Data->GlyphInstanceBuffer->AddLayout(instanceLayout);
+            s_Data->GlyphVertexArray->AddVertexBuffer(s_Data->GlyphInstanceBuffer);
+            s_Data->GlyphVertexArray->SetIndexBuffer(quadIB);
+            
+            // Allocating the memory for instance Buffer Pointer
+            s_Data->GlyphInstanceBufferBase = new RendererQuadData::GlyphInstance[s_Data->MaxQuads];
+        }
+        
+
+        /////////////////////////////////////////////////////////////////////////////
+        {
+            s_Data->MaterialVertexArray  = VertexArray::Create();
             
             // Vertex Buffer and adding the layput
-            s_Data->CircleQuadVertexBuffer = VertexBuffer::Create(s_Data->MaxVertices * sizeof(RendererQuadData::CircleVertex));
-            s_Data->CircleQuadVertexBuffer->AddLayout ({
+            s_Data->MaterialVertexBuffer = VertexBuffer::Create(s_Data->MaxVertices * sizeof(RendererQuadData::MaterialVertex));
+            s_Data->MaterialVertexBuffer->AddLayout ({
                 { ShaderDataType::Float3, "a_Position" },
                 { ShaderDataType::Float4, "a_Color" },
                 { ShaderDataType::Float2, "a_TexCoord" },
-                { ShaderDataType::Float,  "a_Thickness" },
-                { ShaderDataType::Float,  "a_Fade" },
-                { ShaderDataType::Int,    "a_ObjectID" }
+                { ShaderDataType::Float,  "a_TexIndex" },
+                { ShaderDataType::Float,  "a_TilingFactor" },
+                { ShaderDataType::Int,    "a_ObjectID" },
+                { ShaderDataType::Float,  "a_MaterialIndex" }
             });
-            s_Data->CircleQuadVertexArray->AddVertexBuffer(s_Data->CircleQuadVertexBuffer);
+            s_Data->MaterialVertexArray->AddVertexBuffer(s_Data->MaterialVertexBuffer);
+            s_Data->MaterialVertexArray->SetIndexBuffer(quadIB);
             
             // Allocating the memory for vertex Buffer Pointer
-            s_Data->CircleQuadVertexBufferBase = new RendererQuadData::CircleVertex[s_Data->MaxVertices];
+            s_Data->MaterialVertexBufferBase = new RendererQuadData::MaterialVertex[s_Data->MaxVertices];
+            
+            // Parameter blocks of all materials in batch are uploaded at once
+            s_Data->MaterialUniformBuffer = UniformBuffer::Create(RendererQuadData::MaxMaterialBufferSize, (uint32_t)RendererUniformBlock::Materials);
+            s_Data->MaterialData.Allocate(RendererQuadData::MaxMaterialBufferSize);
+            s_Data->MaterialData.ZeroInitialize();
         }
-        
 
         // Creating white texture for colorful quads witout any texture or sprite
         uint32_t whiteTextureData = 0xffffffff;
@@ -174,27 +399,43 @@ namespace iKan {
 
         SetShaader("../../../iKan/assets/shaders/BatchRenderer2DShader.glsl");
         
-        s_Data->CircleTextureShader = Shader::Create("../../../iKan/assets/shaders/CircleShader.glsl");
-        s_Data->CircleTextureShader->Bind();
-
+        // Full variant is used while cheaper variant is being compiled
+        s_Data->ShapeShader = CreateScope<ShaderVariants>("../../../iKan/assets/shaders/SDFShapeShader.glsl", std::vector<std::string>{ "ID_BUFFER" });
+        s_Data->ShapeShader->Get(s_Data->ShapeShader->GetFullKey());
+        
+        s_Data->LineShader = CreateScope<ShaderVariants>("../../../iKan/assets/shaders/LineShader.glsl", std::vector<std::string>{ "ID_BUFFER" });
+        s_Data->LineShader->Get(s_Data->LineShader->GetFullKey());
+        
+        s_Data->TextShader = CreateScope<ShaderVariants>("../../../iKan/assets/shaders/TextShader.glsl", std::vector<std::string>{ "ID_BUFFER" });
+        s_Data->TextShader->Get(s_Data->TextShader->GetFullKey());
+        
+        s_Data->DefaultMaterialShader = CreateScope<ShaderVariants>("../../../iKan/assets/shaders/MaterialShader.glsl", std::vector<std::string>{ "ID_BUFFER" });
+        s_Data->DefaultMaterialShader->Get(s_Data->DefaultMaterialShader->GetFullKey());
     }
 
     // ******************************************************************************
-    // Set the 2DD shader
+    // Set the 2DD shader. Shader must have the options "TEXTURED", "ID_BUFFER" and
+    // "ALPHA_TEST". Texture slots are bound to samplers when program is linked
     // ******************************************************************************
     void Renderer2D::SetShaader(const std::string &path)
     {
         IK_CORE_INFO("Set the 2D Renderer Shader {0}", path.c_str());
 
-        // Creating array of Slots to store hem in shader
-        int32_t samplers[s_Data->MaxTextureSlots];
-        for (uint32_t i = 0; i < s_Data->MaxTextureSlots; i++)
-            samplers[i] = i;
-
-        // Creating Shader and storing all the slots
-        s_Data->TextureShader = Shader::Create(path);
-        s_Data->TextureShader->Bind();
-        s_Data->TextureShader->SetIntArray("u_Textures", samplers, s_Data->MaxTextureSlots);
+        // Full variant is used while cheaper variant is being compiled
+        s_Data->TextureShader = CreateScope<ShaderVariants>(path, std::vector<std::string>{ "TEXTURED", "ID_BUFFER", "ALPHA_TEST" });
+        s_Data->TextureShader->Get(s_Data->TextureShader->GetFullKey());
+    }
+    
+    // ******************************************************************************
+    // Get the cheapest ready variant having the options. Fall back to full variant
+    // if the variant is still being compiled
+    // ******************************************************************************
+    static const Ref<Shader>& GetReadyVariant(ShaderVariants& variants, ShaderVariants::Key key)
+    {
+        const Ref<Shader>& shader = variants.Get(key);
+        if (shader->IsReady())
+            return shader;
+        return variants.Get(variants.GetFullKey());
     }
 
     // ******************************************************************************
@@ -204,19 +445,18 @@ namespace iKan {
     {
         IK_CORE_WARN("Shutting down the Renderer 2D");
         delete s_Data;
+
+        // Interned SubTextures keep their textures alive so release them with renderer
+        SubTexture::ClearInterned();
     }
 
     // ******************************************************************************
     // Begin the 2D Scene
     // ******************************************************************************
-    void Renderer2D::BeginScene(const glm::mat4& viewProj)
+    void Renderer2D::BeginScene(bool writeIDBuffer)
     {
-        s_Data->TextureShader->Bind();
-        s_Data->TextureShader->SetUniformMat4("u_ViewProjection", viewProj);
-        
-        s_Data->CircleTextureShader->Bind();
-        s_Data->CircleTextureShader->SetUniformMat4("u_ViewProjection", viewProj);
-
+        // Camera is taken from "r_Camera" uniform block updated by Scene Renderer
+        s_Data->WriteIDBuffer = writeIDBuffer;
         StartBatch();
     }
 
@@ -229,10 +469,20 @@ namespace iKan {
         s_Data->QuadVertexBufferPtr = s_Data->QuadVertexBufferBase;
         
         
-        s_Data->CircleQuadIndexCount = 0;
-        s_Data->CircleQuadVertexBufferPtr = s_Data->CircleQuadVertexBufferBase;
-
+        s_Data->ShapeCount = 0;
+        s_Data->ShapeInstanceBufferPtr = s_Data->ShapeInstanceBufferBase;
+        
+        s_Data->LineCount = 0;
+        s_Data->LineInstanceBufferPtr = s_Data->LineInstanceBufferBase;
+        
+        s_Data->GlyphCount = 0;
+        s_Data->GlyphInstanceBufferPtr = s_Data->GlyphInstanceBufferBase;
         
+        s_Data->MaterialIndexCount = 0;
+        s_Data->MaterialVertexBufferPtr = s_Data->MaterialVertexBufferBase;
+        s_Data->MaterialSlots.clear();
+        s_Data->MaterialSlotMap.clear();
+        s_Data->MaterialShader = nullptr;
         
         s_Data->TextureSlotIndex = 1;
     }
@@ -250,37 +500,89 @@ namespace iKan {
     // ******************************************************************************
     void Renderer2D::Flush()
     {
-        // Nothing to draw
-        if (s_Data->QuadIndexCount)
+        // Slot 0 is white texture, batch with only that do not sample any texture
+        ShaderVariants::Key quadKey = RendererQuadData::AlphaTest;
+        if (s_Data->TextureSlotIndex > 1)
+            quadKey |= RendererQuadData::Textured;
+        if (s_Data->WriteIDBuffer)
+            quadKey |= RendererQuadData::IDBuffer;
+        
+        // Textures slots are shared by quads, glyphs and material quads of batch
+        if (s_Data->QuadIndexCount || s_Data->GlyphCount || s_Data->MaterialIndexCount)
         {
-
-            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->QuadVertexBufferPtr - (uint8_t*)s_Data->QuadVertexBufferBase);
-            s_Data->QuadVertexBuffer->SetData(s_Data->QuadVertexBufferBase, dataSize);
-
-            // Bind textures
             for (uint32_t i = 0; i < s_Data->TextureSlotIndex; i++)
             {
                 // Skipping i = 0 as 0 is slot for white texture
                 if (i > 0)
                     RendererStatistics::TextureCount++;
-
+                
                 s_Data->TextureSlots[i]->Bind(i);
             }
+        }
+        
+        // Nothing to draw, or shader is still being compiled
+        const Ref<Shader>& quadShader = GetReadyVariant(*s_Data->TextureShader, quadKey);
+        if (s_Data->QuadIndexCount && quadShader->IsReady())
+        {
+
+            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->QuadVertexBufferPtr - (uint8_t*)s_Data->QuadVertexBufferBase);
+            s_Data->QuadVertexBuffer->SetData(s_Data->QuadVertexBufferBase, dataSize);
 
             // Render the Scene
-            s_Data->TextureShader->Bind();
+            quadShader->Bind();
             Renderer::DrawIndexed(s_Data->QuadVertexArray, s_Data->QuadIndexCount);
         }
         
-        if (s_Data->CircleQuadIndexCount)
+        ShaderVariants::Key shapeKey = s_Data->WriteIDBuffer ? RendererQuadData::ShapeIDBuffer : 0;
+        const Ref<Shader>& shapeShader = GetReadyVariant(*s_Data->ShapeShader, shapeKey);
+        if (s_Data->ShapeCount && shapeShader->IsReady())
         {
+            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->ShapeInstanceBufferPtr - (uint8_t*)s_Data->ShapeInstanceBufferBase);
+            s_Data->ShapeInstanceBuffer->SetData(s_Data->ShapeInstanceBufferBase, dataSize);
             
-            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->CircleQuadVertexBufferPtr - (uint8_t*)s_Data->CircleQuadVertexBufferBase);
-            s_Data->CircleQuadVertexBuffer->SetData(s_Data->CircleQuadVertexBufferBase, dataSize);
+            // Render all the shapes as instances of one quad
+            shapeShader->Bind();
+            Renderer::DrawIndexedInstanced(s_Data->ShapeVertexArray, 6, s_Data->ShapeCount);
+        }
+        
+        if (s_Data->MaterialIndexCount && s_Data->MaterialShader->IsReady())
+        {
+            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->MaterialVertexBufferPtr - (uint8_t*)s_Data->MaterialVertexBufferBase);
+            s_Data->MaterialVertexBuffer->SetData(s_Data->MaterialVertexBufferBase, dataSize);
             
-            // Render the Scene
-            s_Data->CircleTextureShader->Bind();
-            Renderer::DrawIndexed(s_Data->CircleQuadVertexArray, s_Data->CircleQuadIndexCount);
+            // Pack parameter blocks of all the materials and upload them once
+            uint32_t stride = s_Data->MaterialSlots.front()->GetParameterStride();
+            for (uint32_t i = 0; i < (uint32_t)s_Data->MaterialSlots.size(); i++)
+            {
+                const Buffer& block = s_Data->MaterialSlots[i]->GetParameterBlock();
+                s_Data->MaterialData.Write(block.Data, block.Size, i * stride);
+            }
+            s_Data->MaterialUniformBuffer->SetData(s_Data->MaterialData.Data, stride * (uint32_t)s_Data->MaterialSlots.size());
+            
+            s_Data->MaterialShader->Bind();
+            Renderer::DrawIndexed(s_Data->MaterialVertexArray, s_Data->MaterialIndexCount);
+        }
+        
+        // All the text of batch, with any number of fonts, is one instanced draw
+        const Ref<Shader>& textShader = GetReadyVariant(*s_Data->TextShader, shapeKey);
+        if (s_Data->GlyphCount && textShader->IsReady())
+        {
+            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->GlyphInstanceBufferPtr - (uint8_t*)s_Data->GlyphInstanceBufferBase);
+            s_Data->GlyphInstanceBuffer->SetData(s_Data->GlyphInstanceBufferBase, dataSize);
+            
+            textShader->Bind();
+            Renderer::DrawIndexedInstanced(s_Data->GlyphVertexArray, 6, s_Data->GlyphCount);
+        }
+        
+        // Lines are drawn at last so that debug lines are on top
+        const Ref<Shader>& lineShader = GetReadyVariant(*s_Data->LineShader, shapeKey);
+        if (s_Data->LineCount && lineShader->IsReady())
+        {
+            uint32_t dataSize = (uint32_t)((uint8_t*)s_Data->LineInstanceBufferPtr - (uint8_t*)s_Data->LineInstanceBufferBase);
+            s_Data->LineInstanceBuffer->SetData(s_Data->LineInstanceBufferBase, dataSize);
+            
+            lineShader->Bind();
+            Renderer::DrawIndexedInstanced(s_Data->LineVertexArray, 6, s_Data->LineCount);
         }
     }
 
@@ -295,8 +597,20 @@ namespace iKan {
         s_Data->QuadIndexCount = 0;
         s_Data->QuadVertexBufferPtr = s_Data->QuadVertexBufferBase;
         
-        s_Data->CircleQuadIndexCount = 0;
-        s_Data->CircleQuadVertexBufferPtr = s_Data->CircleQuadVertexBufferBase;
+        s_Data->ShapeCount = 0;
+        s_Data->ShapeInstanceBufferPtr = s_Data->ShapeInstanceBufferBase;
+        
+        s_Data->LineCount = 0;
+        s_Data->LineInstanceBufferPtr = s_Data->LineInstanceBufferBase;
+        
+        s_Data->GlyphCount = 0;
+        s_Data->GlyphInstanceBufferPtr = s_Data->GlyphInstanceBufferBase;
+        
+        s_Data->MaterialIndexCount = 0;
+        s_Data->MaterialVertexBufferPtr = s_Data->MaterialVertexBufferBase;
+        s_Data->MaterialSlots.clear();
+        s_Data->MaterialSlotMap.clear();
+        s_Data->MaterialShader = nullptr;
 
         s_Data->TextureSlotIndex = 1;
     }
@@ -322,10 +636,9 @@ namespace iKan {
     // ******************************************************************************
     // Draq Subtexutre Quad
     // ******************************************************************************
-    void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture>& subTexture, int32_t entID, float tilingFactor, const glm::vec4& tintColor)
+    void Renderer2D::DrawQuad(const glm::mat4& transform, const SubTexture& subTexture, int32_t entID, float tilingFactor, const glm::vec4& tintColor)
     {
-        const glm::vec2* textureCoords = subTexture->GetTexCoord();
-        DrawTextureQuad(transform, subTexture->GetTexture(), entID, textureCoords, tilingFactor, tintColor);
+        DrawTextureQuad(transform, subTexture.GetTexture(), entID, subTexture.GetTexCoord(), tilingFactor, tintColor);
     }
 
     void Renderer2D::DrawTextureQuad(const glm::mat4& transform, const Ref<Texture>& texture, int32_t entID, const glm::vec2* textureCoords, float tilingFactor, const glm::vec4& tintColor)
@@ -333,40 +646,11 @@ namespace iKan {
         // If number of indices increase in batch then start new batch
         if (s_Data->QuadIndexCount >= RendererQuadData::MaxIndices)
         {
-            IK_CORE_WARN("Starts the new batch as number of indices ({0}) increases in the previous batch", s_Data->QuadIndexCount);
+            IK_CORE_TRACE("Starts the new batch as number of indices ({0}) increases in the previous batch", s_Data->QuadIndexCount);
             NextBatch();
         }
 
-        float textureIndex = 0.0f;
-        if (texture)
-        {
-            // Find if texture is already loaded in current batch
-            for (int8_t i = 1; i < s_Data->TextureSlotIndex; i++)
-            {
-                if (*s_Data->TextureSlots[i] == *texture)
-                {
-                    // Found the current textue in the batch
-                    textureIndex = (float)i;
-                    break;
-                }
-            }
-
-            // If current texture slot is not pre loaded then load the texture in proper slot
-            if (textureIndex == 0.0f)
-            {
-                // If number of slots increases max then start new batch
-                if (s_Data->TextureSlotIndex >= RendererQuadData::MaxTextureSlots)
-                {
-                    IK_CORE_WARN("Starts the new batch as number of texture slot ({0}) increases in the previous batch", s_Data->TextureSlotIndex);
-                    NextBatch();
-                }
-
-                // Loading the current texture in the first free slot slot
-                textureIndex = (float)s_Data->TextureSlotIndex;
-                s_Data->TextureSlots[s_Data->TextureSlotIndex] = texture;
-                s_Data->TextureSlotIndex++;
-            }
-        }
+        float textureIndex = GetTextureSlot(texture);
 
         constexpr size_t quadVertexCount = 4;
         for (size_t i = 0; i < quadVertexCount; i++)
@@ -386,32 +670,266 @@ namespace iKan {
         RendererStatistics::IndexCount += 6;
     }
     
-    void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int32_t entID)
+    // ******************************************************************************
+    // Get the slot of texture in current batch, load the texture in free slot if not
+    // present. Starts new batch if all slots are used. Slot 0 (white) if no texture
+    // ******************************************************************************
+    float Renderer2D::GetTextureSlot(const Ref<Texture>& texture)
     {
+        if (!texture)
+            return 0.0f;
+        
+        // Find if texture is already loaded in current batch
+        for (int8_t i = 1; i < s_Data->TextureSlotIndex; i++)
+        {
+            // Found the current textue in the batch
+            if (*s_Data->TextureSlots[i] == *texture)
+                return (float)i;
+        }
+        
+        // If number of slots increases max then start new batch
+        if (s_Data->TextureSlotIndex >= RendererQuadData::MaxTextureSlots)
+        {
+            IK_CORE_TRACE("Starts the new batch as number of texture slot ({0}) increases in the previous batch", s_Data->TextureSlotIndex);
+            NextBatch();
+        }
+        
+        // Loading the current texture in the first free slot slot
+        float textureIndex = (float)s_Data->TextureSlotIndex;
+        s_Data->TextureSlots[s_Data->TextureSlotIndex] = texture;
+        s_Data->TextureSlotIndex++;
+        return textureIndex;
+    }
+    
+    // ******************************************************************************
+    // Get the index of material block in current batch. Starts new batch if shader
+    // of material is different or uniform block is full
+    // ******************************************************************************
+    float Renderer2D::GetMaterialSlot(const Ref<Material>& material)
+    {
+        if (s_Data->MaterialShader && s_Data->MaterialShader != material->GetShader())
+            NextBatch();
+        
+        auto it = s_Data->MaterialSlotMap.find(material.get());
+        if (it != s_Data->MaterialSlotMap.end())
+            return (float)it->second;
+        
+        uint32_t maxMaterials = std::min(material->GetMaxInstances(), RendererQuadData::MaxMaterialBufferSize / std::max(material->GetParameterStride(), 16u));
+        if (s_Data->MaterialSlots.size() >= maxMaterials)
+        {
+            IK_CORE_TRACE("Starts the new batch as number of materials ({0}) increases in the previous batch", s_Data->MaterialSlots.size());
+            NextBatch();
+        }
+        
+        uint32_t index = (uint32_t)s_Data->MaterialSlots.size();
+        s_Data->MaterialShader = material->GetShader();
+        s_Data->MaterialSlots.push_back(material);
+        s_Data->MaterialSlotMap[material.get()] = index;
+        return (float)index;
+    }
+    
+    // ******************************************************************************
+    // Create the material of renderer material shader. Material draws the quad as it
+    // is, till its parameters are changed
+    // ******************************************************************************
+    Ref<Material> Renderer2D::CreateMaterial()
+    {
+        Ref<Material> material = Material::Create(s_Data->DefaultMaterialShader->Get(s_Data->DefaultMaterialShader->GetFullKey()));
+        material->Set("Tint", glm::vec4(1.0f));
+        material->Set("TilingFactor", 1.0f);
+        return material;
+    }
+    
+    // ******************************************************************************
+    // Draw Quad with Material. Material parameters are read by shader from material
+    // block at per vertex material index. Quad has one texture slot, so material
+    // with more than one sampler is not drawn (error is logged by its layout)
+    // ******************************************************************************
+    void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Material>& material, int32_t entID, const glm::vec4& color)
+    {
+        if (!material || material->GetMaxInstances() == 0 || material->GetNumSamplers() > 1)
+            return;
+        
         // If number of indices increase in batch then start new batch
-        if (s_Data->CircleQuadIndexCount >= RendererQuadData::MaxIndices)
+        if (s_Data->MaterialIndexCount >= RendererQuadData::MaxIndices)
         {
-            IK_CORE_WARN("Starts the new batch as number of indices ({0}) increases in the previous batch", s_Data->QuadIndexCount);
+            IK_CORE_TRACE("Starts the new batch as number of indices ({0}) increases in the previous batch", s_Data->MaterialIndexCount);
             NextBatch();
         }
-
+        
+        float materialIndex = GetMaterialSlot(material);
+        
+        // New batch for texture clears the materials, so add material again
+        uint32_t textureSlotIndex = s_Data->TextureSlotIndex;
+        float textureIndex = GetTextureSlot(material->GetMainTexture());
+        if (s_Data->TextureSlotIndex < textureSlotIndex)
+            materialIndex = GetMaterialSlot(material);
+        
+        constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
         constexpr size_t quadVertexCount = 4;
         for (size_t i = 0; i < quadVertexCount; i++)
         {
-            s_Data->CircleQuadVertexBufferPtr->Position     = transform * s_Data->QuadVertexPositions[i];
-            s_Data->CircleQuadVertexBufferPtr->Color        = color;
-            s_Data->CircleQuadVertexBufferPtr->TexCoord     = 2.0f * s_Data->QuadVertexPositions[i];
-            s_Data->CircleQuadVertexBufferPtr->Thickness    = thickness;
-            s_Data->CircleQuadVertexBufferPtr->Fade         = fade;
-            s_Data->CircleQuadVertexBufferPtr->ObjectID     = entID;
-            s_Data->CircleQuadVertexBufferPtr++;
+            s_Data->MaterialVertexBufferPtr->Position      = transform * s_Data->QuadVertexPositions[i];
+            s_Data->MaterialVertexBufferPtr->Color         = color;
+            s_Data->MaterialVertexBufferPtr->TexCoord      = textureCoords[i];
+            s_Data->MaterialVertexBufferPtr->TexIndex      = textureIndex;
+            s_Data->MaterialVertexBufferPtr->TilingFactor  = 1.0f;
+            s_Data->MaterialVertexBufferPtr->ObjectID      = entID;
+            s_Data->MaterialVertexBufferPtr->MaterialIndex = materialIndex;
+            s_Data->MaterialVertexBufferPtr++;
         }
         
-        s_Data->CircleQuadIndexCount += 6;
+        s_Data->MaterialIndexCount += 6;
+        
+        RendererStatistics::VertexCount += 4;
+        RendererStatistics::IndexCount += 6;
+    }
+    
+    // ******************************************************************************
+    // Draw Circle. Thickness is fraction of radius, ring if less than 1
+    // ******************************************************************************
+    void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int32_t entID)
+    {
+        DrawShape(RendererQuadData::Circle, transform, color, { thickness, fade, 0.0f, 0.0f }, entID);
+    }
+    
+    // ******************************************************************************
+    // Draw Rounded Rectangle. Corner radius and thickness are fraction of half of
+    // smaller side
+    // ******************************************************************************
+    void Renderer2D::DrawRoundedRect(const glm::mat4& transform, const glm::vec4& color, float cornerRadius, float thickness, float fade, int32_t entID)
+    {
+        DrawShape(RendererQuadData::RoundedRect, transform, color, { thickness, fade, cornerRadius, 0.0f }, entID);
+    }
+    
+    // ******************************************************************************
+    // Draw Capsule along the longer side of transform
+    // ******************************************************************************
+    void Renderer2D::DrawCapsule(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int32_t entID)
+    {
+        DrawShape(RendererQuadData::Capsule, transform, color, { thickness, fade, 0.0f, 0.0f }, entID);
+    }
+    
+    // ******************************************************************************
+    // Store one instance of SDF shape
+    // ******************************************************************************
+    void Renderer2D::DrawShape(int32_t shape, const glm::mat4& transform, const glm::vec4& color, const glm::vec4& params, int32_t entID)
+    {
+        // If number of shapes increase in batch then start new batch
+        if (s_Data->ShapeCount >= RendererQuadData::MaxQuads)
+        {
+            IK_CORE_TRACE("Starts the new batch as number of shapes ({0}) increases in the previous batch", s_Data->ShapeCount);
+            NextBatch();
+        }
+        
+        s_Data->ShapeInstanceBufferPtr->AxisX    = glm::vec3(transform[0]);
+        s_Data->ShapeInstanceBufferPtr->AxisY    = glm::vec3(transform[1]);
+        s_Data->ShapeInstanceBufferPtr->Center   = glm::vec3(transform[3]);
+        s_Data->ShapeInstanceBufferPtr->Color    = color;
+        s_Data->ShapeInstanceBufferPtr->Params   = params;
+        s_Data->ShapeInstanceBufferPtr->Shape    = shape;
+        s_Data->ShapeInstanceBufferPtr->ObjectID = entID;
+        s_Data->ShapeInstanceBufferPtr++;
+        
+        s_Data->ShapeCount++;
         
         RendererStatistics::VertexCount += 4;
         RendererStatistics::IndexCount += 6;
     }
 
+    // ******************************************************************************
+    // Draw Line segment. Thickness is in pixels
+    // ******************************************************************************
+    void Renderer2D::DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float thickness, int32_t entID)
+    {
+        // If number of lines increase in batch then start new batch
+        if (s_Data->LineCount >= RendererQuadData::MaxQuads)
+        {
+            IK_CORE_TRACE("Starts the new batch as number of lines ({0}) increases in the previous batch", s_Data->LineCount);
+            NextBatch();
+        }
+        
+        s_Data->LineInstanceBufferPtr->Start     = start;
+        s_Data->LineInstanceBufferPtr->End       = end;
+        s_Data->LineInstanceBufferPtr->Color     = color;
+        s_Data->LineInstanceBufferPtr->Thickness = thickness;
+        s_Data->LineInstanceBufferPtr->ObjectID  = entID;
+        s_Data->LineInstanceBufferPtr++;
+        
+        s_Data->LineCount++;
+        
+        RendererStatistics::VertexCount += 4;
+        RendererStatistics::IndexCount += 6;
+    }
+    
+    // ******************************************************************************
+    // Draw connected line segments, last point is connected to first if closed
+    // ******************************************************************************
+    void Renderer2D::DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, float thickness, bool closed, int32_t entID)
+    {
+        if (count < 2)
+            return;
+        
+        for (uint32_t i = 0; i + 1 < count; i++)
+            DrawLine(points[i], points[i + 1], color, thickness, entID);
+        
+        if (closed && count > 2)
+            DrawLine(points[count - 1], points[0], color, thickness, entID);
+    }
+    
+    // ******************************************************************************
+    // Draw outline of Quad
+    // ******************************************************************************
+    void Renderer2D::DrawRect(const glm::mat4& transform, const glm::vec4& color, float thickness, int32_t entID)
+    {
+        glm::vec3 points[4];
+        for (size_t i = 0; i < 4; i++)
+            points[i] = transform * s_Data->QuadVertexPositions[i];
+        
+        DrawPolyline(points, 4, color, thickness, true, entID);
+    }
+    
+    // ******************************************************************************
+    // Draw the string. Layout of string is cached by font, transform places the
+    // pen position of first line. All the glyphs of batch are drawn in one call
+    // ******************************************************************************
+    void Renderer2D::DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, int32_t entID)
+    {
+        if (!font || !font->GetAtlas())
+            return;
+        
+        const Font::Layout& layout = font->GetLayout(text);
+        if (layout.Quads.empty())
+            return;
+        
+        float textureIndex = GetTextureSlot(font->GetAtlas());
+        for (const auto& quad : layout.Quads)
+        {
+            // If number of glyphs increase in batch then start new batch, atlas need
+            // to be loaded in slot of new batch
+            if (s_Data->GlyphCount >= RendererQuadData::MaxQuads)
+            {
+                IK_CORE_TRACE("Starts the new batch as number of glyphs ({0}) increases in the previous batch", s_Data->GlyphCount);
+                NextBatch();
+                textureIndex = GetTextureSlot(font->GetAtlas());
+            }
+            
+            glm::vec2 size = quad.QuadMax - quad.QuadMin;
+            
+            s_Data->GlyphInstanceBufferPtr->Position = transform * glm::vec4(quad.QuadMin, 0.0f, 1.0f);
+            s_Data->GlyphInstanceBufferPtr->AxisX    = transform * glm::vec4(size.x, 0.0f, 0.0f, 0.0f);
+            s_Data->GlyphInstanceBufferPtr->AxisY    = transform * glm::vec4(0.0f, size.y, 0.0f, 0.0f);
+            s_Data->GlyphInstanceBufferPtr->TexRect  = glm::vec4(quad.UVMin, quad.UVMax);
+            s_Data->GlyphInstanceBufferPtr->Color    = color;
+            s_Data->GlyphInstanceBufferPtr->TexIndex = textureIndex;
+            s_Data->GlyphInstanceBufferPtr->ObjectID = entID;
+            s_Data->GlyphInstanceBufferPtr++;
+            
+            s_Data->GlyphCount++;
+        }
+        
+        RendererStatistics::VertexCount += 4 * (uint32_t)layout.Quads.size();
+        RendererStatistics::IndexCount += 6 * (uint32_t)layout.Quads.size();
+    }
 
 }
@@ -11,6 +11,8 @@
 
 #include <iKan/Editor/EditorCamera.h>
 #include <iKan/Renderer/Texture.h>
+#include <iKan/Renderer/Material.h>
+#include <iKan/Renderer/Font.h>
 
 namespace iKan {
 
@@ -22,21 +24,46 @@ namespace iKan {
 
         static void SetShaader(const std::string &path);
 
-        static void BeginScene(const glm::mat4& viewProj);
+        // ID buffer is written only when requested (Editor mouse picking), cheaper
+        // shader variant is used otherwise
+        static void BeginScene(bool writeIDBuffer = true);
         static void EndScene();
 
         // Primitives
         static void DrawTextureQuad(const glm::mat4& transform, const Ref<Texture>& texture, int32_t entID, const glm::vec2* textureCoords, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
         static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, int32_t entID);
         static void DrawQuad(const glm::mat4& transform, const Ref<Texture>& texture, int32_t entID, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
-        static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture>& texture, int32_t entID, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+        static void DrawQuad(const glm::mat4& transform, const SubTexture& subTexture, int32_t entID, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 
+        // Quads of same shader are drawn in one call even with different materials
+        static void DrawQuad(const glm::mat4& transform, const Ref<Material>& material, int32_t entID, const glm::vec4& color = glm::vec4(1.0f));
+
+        // Material of renderer material shader (MaterialShader.glsl). Parameters are
+        // "Tint", "UVOffset" and "TilingFactor", texture is "u_Textures"
+        static Ref<Material> CreateMaterial();
+
+        // SDF Shapes, drawn as instances. Thickness is fraction of radius (half of
+        // smaller side), 1 is filled and less than 1 draws outline (ring)
         static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005, int32_t entID = -1);
+        static void DrawRoundedRect(const glm::mat4& transform, const glm::vec4& color, float cornerRadius = 0.25f, float thickness = 1.0f, float fade = 0.0f, int32_t entID = -1);
+        static void DrawCapsule(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.0f, int32_t entID = -1);
+        
+        // Lines, drawn as instances. Thickness is in pixels and line is expanded to
+        // quad in shader
+        static void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float thickness = 2.0f, int32_t entID = -1);
+        static void DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, float thickness = 2.0f, bool closed = false, int32_t entID = -1);
+        static void DrawRect(const glm::mat4& transform, const glm::vec4& color, float thickness = 2.0f, int32_t entID = -1);
+        
+        // Text, glyphs are drawn as instances. One unit of transform is line height
+        static void DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f), int32_t entID = -1);
 
     private:
         static void Flush();
         static void StartBatch();
         static void NextBatch();
+        static float GetTextureSlot(const Ref<Texture>& texture);
+        static void DrawShape(int32_t shape, const glm::mat4& transform, const glm::vec4& color, const glm::vec4& params, int32_t entID);
+        static float GetMaterialSlot(const Ref<Material>& material);
 
     };
 
@@ -28,6 +28,9 @@ namespace iKan {
             std::string Vendor;
             std::string Renderer;
             std::string Version;
+            
+            // Driver compiles shaders in background and reports completion status
+            bool ParallelShaderCompile = false;
         };
         
         // ******************************************************************************
@@ -46,6 +49,7 @@ namespace iKan {
         virtual void SetViewPort(uint32_t widht, uint32_t height) = 0;
         virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0) = 0;
         virtual void DrawIndexed(uint32_t count) = 0;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount) = 0;
         virtual void GetEntityIdFromPixels(int32_t mx, int32_t my, int32_t& pixelData) = 0;
         
         // NOTE: This API should be set before creating Windown instance as
@@ -10,8 +10,35 @@
 #include "SceneRenderer.h"
 #include <iKan/Renderer/Renderer2D.h>
 #include <iKan/Renderer/MeshScene.h>
+#include <iKan/Renderer/Buffers.h>
+#include <iKan/Renderer/Shader.h>
+#include <chrono>
 
 namespace iKan {
+    
+    // ******************************************************************************
+    // Stores the per frame data shared by all the shaders
+    // ******************************************************************************
+    struct SceneRendererData
+    {
+        // ******************************************************************************
+        // Layout of "r_Camera" uniform block (std140)
+        // ******************************************************************************
+        struct CameraData
+        {
+            glm::mat4 View;
+            glm::mat4 Projection;
+            glm::mat4 ViewProjection;
+            float     Time;
+            float     Padding;
+            glm::vec2 ViewportSize;
+        };
+        
+        Ref<UniformBuffer> CameraUniformBuffer;
+        glm::vec2 ViewportSize = { 1280.0f, 720.0f };
+        std::chrono::steady_clock::time_point StartTime;
+    };
+    static SceneRendererData* s_Data = nullptr;
 
     // ******************************************************************************
     // Initialise the Scene Renderer
@@ -19,6 +46,11 @@ namespace iKan {
     void SceneRenderer::Init()
     {
         IK_CORE_INFO("Initialising the Scene RendererS");
+        
+        s_Data = new SceneRendererData();
+        s_Data->CameraUniformBuffer = UniformBuffer::Create(sizeof(SceneRendererData::CameraData), (uint32_t)RendererUniformBlock::Camera);
+        s_Data->StartTime = std::chrono::steady_clock::now();
+        
         Renderer2D::Init();
         MeshScene::Init();
     }
@@ -31,14 +63,29 @@ namespace iKan {
         IK_CORE_WARN("Shutting down the Scene Renderer");
         Renderer2D::Shutdown();
         MeshScene::Shutdown();
+        
+        delete s_Data;
     }
     
     // ******************************************************************************
-    // Begin the Scene
+    // Begin the Scene. Camera data is uploaded once in uniform buffer for all the
+    // shaders of this scene
     // ******************************************************************************
     void SceneRenderer::BeginScene(const Scene* scene, const SceneRendererCamera& camera)
     {
-        Renderer2D::BeginScene(camera.ViewMatrix);
+        std::chrono::duration<float> time = std::chrono::steady_clock::now() - s_Data->StartTime;
+        
+        // Camera ViewMatrix is view projection of camera
+        SceneRendererData::CameraData cameraData;
+        cameraData.Projection     = camera.Camera.GetProjection();
+        cameraData.ViewProjection = camera.ViewMatrix;
+        cameraData.View           = glm::inverse(cameraData.Projection) * cameraData.ViewProjection;
+        cameraData.Time           = time.count();
+        cameraData.Padding        = 0.0f;
+        cameraData.ViewportSize   = s_Data->ViewportSize;
+        s_Data->CameraUniformBuffer->SetData(&cameraData, sizeof(cameraData));
+        
+        Renderer2D::BeginScene(scene ? scene->IsEditing() : true);
         MeshScene::BeginScene();
     }
     
@@ -56,6 +103,7 @@ namespace iKan {
     // ******************************************************************************
     void SceneRenderer::SetViewportSize(uint32_t width, uint32_t height)
     {
+        s_Data->ViewportSize = { (float)width, (float)height };
         MeshScene::SetViewportSize(width, height);
     }
 
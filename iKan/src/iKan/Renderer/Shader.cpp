@@ -30,17 +30,39 @@ namespace iKan {
     // ******************************************************************************
     // Creating instance for Shader depending on graphics API
     // ******************************************************************************
-    Ref<Shader> Shader::Create(const std::string& path)
+    Ref<Shader> Shader::Create(const std::string& path, const std::vector<std::string>& defines)
     {
         switch (Renderer::GetAPI())
         {
             case RendererAPI::API::None   : IK_CORE_ASSERT(false, "Render API not Supporting");
-            case RendererAPI::API::OpenGL : return CreateRef<OpenGLShader>(path); break;
+            case RendererAPI::API::OpenGL : return CreateRef<OpenGLShader>(path, defines); break;
         }
         IK_CORE_ASSERT(false, "Invalid Render API ");
         return nullptr;
     }
 
+    // ******************************************************************************
+    // Get the binding point of renderer uniform block from its name
+    // ******************************************************************************
+    int32_t Shader::GetRendererBlockBinding(const std::string& blockName)
+    {
+        if (blockName == "r_Camera")    return (int32_t)RendererUniformBlock::Camera;
+        if (blockName == "r_Materials") return (int32_t)RendererUniformBlock::Materials;
+        return -1;
+    }
+
+    // ******************************************************************************
+    // Check the shaders being compiled depending on graphics API
+    // ******************************************************************************
+    void Shader::PollPendingCompiles()
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None   : break;
+            case RendererAPI::API::OpenGL : OpenGLShader::PollPendingCompiles(); break;
+        }
+    }
+
     // ******************************************************************************
     // Loading shader into library
     // ******************************************************************************
@@ -81,5 +103,34 @@ namespace iKan {
     {
         return m_Shaders.find(name) != m_Shaders.end();
     }
+    
+    // ******************************************************************************
+    // Shader variants constructor
+    // ******************************************************************************
+    ShaderVariants::ShaderVariants(const std::string& path, const std::vector<std::string>& options)
+    : m_Path(path), m_Options(options)
+    {
+        IK_CORE_ASSERT((m_Options.size() < 32), "Too many shader options");
+    }
+    
+    // ******************************************************************************
+    // Get the variant of shader, compile it if not created yet
+    // ******************************************************************************
+    const Ref<Shader>& ShaderVariants::Get(Key key)
+    {
+        auto it = m_Variants.find(key);
+        if (it != m_Variants.end())
+            return it->second;
+        
+        std::vector<std::string> defines;
+        for (size_t i = 0; i < m_Options.size(); i++)
+        {
+            if (key & BIT(i))
+                defines.push_back(m_Options[i]);
+        }
+        
+        IK_CORE_INFO("Creating variant {0} of shader {1}", key, m_Path.c_str());
+        return m_Variants[key] = Shader::Create(m_Path, defines);
+    }
 
 }
@@ -9,8 +9,27 @@
 
 #pragma once
 
+#include <iKan/Renderer/ShaderUniform.h>
+
 namespace iKan {
     
+    // ******************************************************************************
+    // Index of a uniform resolved once from shader declarations. Handle 0 is reserved
+    // and means "No Uniform", setting it is ignored. Handle stays valid when shader
+    // is reloaded
+    // ******************************************************************************
+    using UniformHandle = uint32_t;
+    
+    // ******************************************************************************
+    // Fixed binding points of renderer uniform blocks. Uniform block declared in
+    // shader as "r_<Name>" is bound to binding point of <Name> after link
+    // ******************************************************************************
+    enum class RendererUniformBlock : uint32_t
+    {
+        Camera    = 0,
+        Materials = 1
+    };
+    
     // ******************************************************************************
     // Interface for Graphics Shader
     // ******************************************************************************
@@ -26,6 +45,20 @@ namespace iKan {
         
         virtual const std::string& GetName() = 0;
         
+        // Resolve the handle once and use it every frame. Setting uniform with handle
+        // only stage the value in shader, all the changed values are uploaded in one
+        // pass before draw call
+        virtual UniformHandle GetUniformHandle(const std::string& name) = 0;
+        
+        virtual void SetUniform(UniformHandle handle, int32_t value) = 0;
+        virtual void SetUniform(UniformHandle handle, float value) = 0;
+        virtual void SetUniform(UniformHandle handle, const glm::vec2& value) = 0;
+        virtual void SetUniform(UniformHandle handle, const glm::vec3& value) = 0;
+        virtual void SetUniform(UniformHandle handle, const glm::vec4& value) = 0;
+        virtual void SetUniform(UniformHandle handle, const glm::mat3& value) = 0;
+        virtual void SetUniform(UniformHandle handle, const glm::mat4& value) = 0;
+        
+        // NOTE: Setters by name resolve the handle on each call, prefer handles
         virtual void SetUniformInt1(const std::string& name, int32_t value) = 0;
         virtual void SetIntArray(const std::string& name, int32_t* values, uint32_t count) = 0;
         
@@ -41,8 +74,24 @@ namespace iKan {
 
         virtual uint32_t GetRendererID() const = 0;
         
+        // Reflection of shader declarations. Pointers are valid till shader is reloaded
+        virtual const ShaderUniformBufferDeclaration* FindRendererUniformBuffer(const std::string& name) const = 0;
+        virtual const ShaderResourceList& GetResources() const = 0;
+        
+        // Shader is compiled in background by driver. Draw with shader only once
+        // it is ready
+        virtual bool IsReady() const = 0;
+        
         static Ref<Shader> Create(const std::string& vertexSrc, const std::string& fragmentSrc);
-        static Ref<Shader> Create(const std::string& path);
+        // Each define is injected as "#define <define>" after "#version" of all the
+        // stages, used to create the variants of same shader file
+        static Ref<Shader> Create(const std::string& path, const std::vector<std::string>& defines = {});
+        
+        // Returns -1 if block is not a renderer block
+        static int32_t GetRendererBlockBinding(const std::string& blockName);
+        
+        // Check the shaders being compiled. Called once per frame
+        static void PollPendingCompiles();
     };
     
     // ******************************************************************************
@@ -68,4 +117,30 @@ namespace iKan {
         std::unordered_map<std::string, Ref<Shader>> m_Shaders;
     };
     
+    // ******************************************************************************
+    // Variants of a shader file. Key of variant is bitmask of the options, bit i
+    // defines the option i. Variants are compiled only when requested first time
+    // and then cached
+    // ******************************************************************************
+    class ShaderVariants
+    {
+    public:
+        using Key = uint32_t;
+        
+        ShaderVariants(const std::string& path, const std::vector<std::string>& options);
+        ~ShaderVariants() = default;
+        
+        const Ref<Shader>& Get(Key key);
+        
+        // Returns the key having all the options
+        Key GetFullKey() const { return (Key)((1ull << m_Options.size()) - 1); }
+        
+        const std::string& GetPath() const { return m_Path; }
+        
+    private:
+        std::string m_Path;
+        std::vector<std::string> m_Options;
+        std::unordered_map<Key, Ref<Shader>> m_Variants;
+    };
+    
 }
@@ -18,6 +18,8 @@ namespace iKan {
         None = 0, Vertex = 0, Pixel = 1
     };
 
+    class ShaderStruct;
+
     // ******************************************************************************
     // ******************************************************************************
     class ShaderUniformDeclaration
@@ -33,6 +35,9 @@ namespace iKan {
         virtual uint32_t GetCount() const = 0;
         virtual uint32_t GetOffset() const = 0;
         virtual ShaderDomain GetDomain() const = 0;
+        
+        // Returns nullptr if uniform is not a struct
+        virtual const ShaderStruct* GetStruct() const = 0;
 
     protected:
         virtual void SetOffset(uint32_t offset) = 0;
@@ -10,6 +10,7 @@
 #include "Texture.h"
 #include <iKan/Renderer/Renderer.h>
 #include <iKan/Platform/OpenGL/OpenGLTexture.h>
+#include <iKan/Core/RefCountedSlots.h>
 
 namespace iKan {
     
@@ -27,6 +28,34 @@ namespace iKan {
         return nullptr;
     }
     
+    // ******************************************************************************
+    // Creating Texture from image decoded before
+    // ******************************************************************************
+    Ref<Texture> Texture::Create(const std::string& path, const Image& image)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None   : IK_CORE_ASSERT(false, "Render API not Supporting");
+            case RendererAPI::API::OpenGL : return CreateRef<OpenGLTexture>(path, image); break;
+        }
+        IK_CORE_ASSERT(false, "Invalid Render API ");
+        return nullptr;
+    }
+
+    // ******************************************************************************
+    // Decode the image file
+    // ******************************************************************************
+    Texture::Image Texture::Decode(const std::string& path)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None   : IK_CORE_ASSERT(false, "Render API not Supporting");
+            case RendererAPI::API::OpenGL : return OpenGLTexture::DecodeFile(path); break;
+        }
+        IK_CORE_ASSERT(false, "Invalid Render API ");
+        return {};
+    }
+    
     // ******************************************************************************
     // Creating Texture
     // ******************************************************************************
@@ -41,6 +70,52 @@ namespace iKan {
         return nullptr;
     }
     
+    // ******************************************************************************
+    // Key of the interned SubTexture table. Texture pointer along with rect of tile
+    // in cell units identify a unique SubTexture
+    // ******************************************************************************
+    struct SubTextureKey
+    {
+        const Texture* Tex;
+        glm::vec2 Coords;
+        glm::vec2 SpriteSize;
+        glm::vec2 CellSize;
+        
+        bool operator==(const SubTextureKey& other) const
+        {
+            return Tex == other.Tex && Coords == other.Coords && SpriteSize == other.SpriteSize && CellSize == other.CellSize;
+        }
+    };
+    
+    // ******************************************************************************
+    // Hash of SubTexture key
+    // ******************************************************************************
+    struct SubTextureKeyHash
+    {
+        size_t operator()(const SubTextureKey& key) const
+        {
+            size_t hash = std::hash<const Texture*>()(key.Tex);
+            const float values[] = { key.Coords.x, key.Coords.y, key.SpriteSize.x, key.SpriteSize.y, key.CellSize.x, key.CellSize.y };
+            for (float value : values)
+                hash ^= std::hash<float>()(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+    
+    // ******************************************************************************
+    // Stores the interned SubTextures at the slot index of their handle. Entry 0 is
+    // the empty SubTexture. Slots of released entries are reused by next entries
+    // ******************************************************************************
+    struct SubTextureTableData
+    {
+        std::vector<SubTexture> Entries = { SubTexture() };
+        RefCountedSlots Slots;
+        std::unordered_map<SubTextureKey, SubTextureHandle, SubTextureKeyHash> HandleMap;
+    };
+    // Never deleted, as static SubTextureRefs of client might be released after
+    // this translation unit is destroyed
+    static SubTextureTableData& s_SubTextureTable = *new SubTextureTableData();
+    
     // ******************************************************************************
     // Creating SubTexture
     // ******************************************************************************
@@ -54,27 +129,86 @@ namespace iKan {
     }
     
     // ******************************************************************************
-    // Creating SubTexture
+    // Creating SubTexture. Returns the handle of already interned SubTexture if
+    // same texture and rect is created before
     // ******************************************************************************
-    Ref<SubTexture> SubTexture::CreateFromCoords(const Ref<Texture>& texture, const glm::vec2& coords, const glm::vec2& spriteSize, const glm::vec2& cellSize)
+    SubTextureHandle SubTexture::CreateFromCoords(const Ref<Texture>& texture, const glm::vec2& coords, const glm::vec2& spriteSize, const glm::vec2& cellSize)
     {
+        SubTextureKey key = { texture.get(), coords, spriteSize, cellSize };
+        if (auto it = s_SubTextureTable.HandleMap.find(key); it != s_SubTextureTable.HandleMap.end())
+            return it->second;
+        
         glm::vec2 min = { (coords.x * cellSize.x) / texture->GetWidth(), (coords.y * cellSize.y) / texture->GetHeight() };
         glm::vec2 max = { ((coords.x + spriteSize.x) * cellSize.x) / texture->GetWidth(), ((coords.y + spriteSize.y) * cellSize.y) / texture->GetHeight() };
-        return CreateRef<SubTexture>(texture, min, max, spriteSize, cellSize, coords);
+        
+        // Create the entry before pushing as texture might be the reference of other
+        // entry of the table
+        SubTexture subTexture(texture, min, max, spriteSize, cellSize, coords);
+        
+        SubTextureHandle handle = s_SubTextureTable.Slots.Allocate();
+        IK_CORE_ASSERT(handle, "Too many interned SubTextures");
+        
+        s_SubTextureTable.Entries.resize(s_SubTextureTable.Slots.GetCapacity());
+        s_SubTextureTable.Entries[RefCountedSlots::IndexOf(handle)] = std::move(subTexture);
+        s_SubTextureTable.HandleMap[key] = handle;
+        
+        return handle;
     }
-
+    
     // ******************************************************************************
-    // Update the subtexture if any of the property gets changed
+    // Get the interned SubTexture from handle. Stale handle gets the empty entry
     // ******************************************************************************
-    void SubTexture::UpdateTexcoords()
+    const SubTexture& SubTexture::Get(SubTextureHandle handle)
     {
-        glm::vec2 min = { (m_Coords.x * m_CellSize.x) / m_Texture->GetWidth(), (m_Coords.y * m_CellSize.y) / m_Texture->GetHeight() };
-        glm::vec2 max = { ((m_Coords.x + m_SpriteSize.x) * m_CellSize.x) / m_Texture->GetWidth(), ((m_Coords.y + m_SpriteSize.y) * m_CellSize.y) / m_Texture->GetHeight() };
-
-        m_TexCoord[0] = {min.x, min.y};
-        m_TexCoord[1] = {max.x, min.y};
-        m_TexCoord[2] = {max.x, max.y};
-        m_TexCoord[3] = {min.x, max.y};
+        if (!s_SubTextureTable.Slots.IsValid(handle))
+        {
+            IK_CORE_ASSERT((handle == 0), "Stale SubTexture handle");
+            return s_SubTextureTable.Entries[0];
+        }
+        return s_SubTextureTable.Entries[RefCountedSlots::IndexOf(handle)];
+    }
+    
+    // ******************************************************************************
+    // Number of interned SubTextures (excluding the empty entry and free slots)
+    // ******************************************************************************
+    uint32_t SubTexture::GetNumInterned()
+    {
+        return s_SubTextureTable.Slots.GetNumLive();
+    }
+    
+    // ******************************************************************************
+    // Clear all the interned SubTextures. All the handles becomes stale
+    // ******************************************************************************
+    void SubTexture::ClearInterned()
+    {
+        IK_CORE_WARN("Clearing {0} interned SubTextures", GetNumInterned());
+        s_SubTextureTable.Slots.Clear();
+        s_SubTextureTable.Entries.assign(s_SubTextureTable.Slots.GetCapacity(), SubTexture());
+        s_SubTextureTable.HandleMap.clear();
+    }
+    
+    // ******************************************************************************
+    // Add reference to interned SubTexture. Released entries can not be retained
+    // again, their handles are stale
+    // ******************************************************************************
+    void SubTexture::Retain(SubTextureHandle handle)
+    {
+        [[maybe_unused]] bool retained = s_SubTextureTable.Slots.Retain(handle);
+        IK_CORE_ASSERT((retained || handle == 0), "Retaining stale SubTexture handle");
+    }
+    
+    // ******************************************************************************
+    // Remove reference of interned SubTexture. Entry is removed from table with its
+    // last reference, and texture is released
+    // ******************************************************************************
+    void SubTexture::Release(SubTextureHandle handle)
+    {
+        if (!s_SubTextureTable.Slots.Release(handle))
+            return;
+        
+        SubTexture& entry = s_SubTextureTable.Entries[RefCountedSlots::IndexOf(handle)];
+        s_SubTextureTable.HandleMap.erase({ entry.m_Texture.get(), entry.m_Coords, entry.m_SpriteSize, entry.m_CellSize });
+        entry = SubTexture();
     }
     
     // ******************************************************************************
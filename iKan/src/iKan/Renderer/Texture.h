@@ -16,57 +16,122 @@ namespace iKan {
     // ******************************************************************************
     class Texture
     {
+    public:
+        // ******************************************************************************
+        // Decoded pixels of image file. Image can be decoded on any thread and texture
+        // is created from it later, texture owns the pixels after that
+        // ******************************************************************************
+        struct Image
+        {
+            uint32_t Width = 0, Height = 0, Channel = 0;
+            void* Data = nullptr;
+        };
+
     public:
         virtual ~Texture() = default;
 
         virtual bool Uploaded() const = 0;
+        
+        // False once texture is evicted by TextureMemory, till it is bound again
+        virtual bool Resident() const = 0;
 
         virtual uint32_t GetWidth() const = 0;
         virtual uint32_t GetHeight() const = 0;
         virtual uint32_t GetRendererID() const = 0;
+        
+        virtual uint64_t GetGpuMemory() const = 0;
+        virtual uint64_t GetCpuMemory() const = 0;
 
         virtual void Bind(uint32_t slot = 0) const = 0;
         virtual void Unbind() const = 0;
+        virtual void Evict() = 0;
         
         virtual std::string GetfilePath() const = 0;
         
         virtual bool operator==(const Texture& other) const = 0;
         
         static Ref<Texture> Create(const std::string& path);
+        static Ref<Texture> Create(const std::string& path, const Image& image);
         static Ref<Texture> Create(uint32_t width, uint32_t height, void* data, uint32_t size);
+
+        // Decode the image file, can be called from any thread
+        static Image Decode(const std::string& path);
     };
     
     // ******************************************************************************
-    // Implementation for storung Subtexture for tiles
+    // Handle of a SubTexture in the interned SubTexture table: slot index and its
+    // generation (see RefCountedSlots), so handle of released entry is stale even
+    // if its slot is reused. Handle 0 is reserved and means "No Sub Texture", so
+    // handle can be checked like a pointer
+    // ******************************************************************************
+    using SubTextureHandle = uint32_t;
+
+    // ******************************************************************************
+    // Implementation for storung Subtexture for tiles. SubTextures are immutable and
+    // interned in a flat table keyed by texture and rect, so same tile created
+    // multiple times shares one entry. Client stores only the SubTextureHandle.
+    // Entries are reference counted (see SubTextureRef), entry is released once its
+    // last reference is dropped and its slot is reused by next CreateFromCoords
     // ******************************************************************************
     class SubTexture
     {
     public:
+        SubTexture() = default;
         SubTexture(const Ref<Texture>& texture, const glm::vec2& min, const glm::vec2& max, const glm::vec2& spriteSize = {1.0f, 1.0f}, const glm::vec2& cellSize = {16.0f, 16.0f}, const glm::vec2& coords = {0.0f, 0.0f});
         
-        const Ref<Texture> GetTexture() const { return m_Texture; }
+        const Ref<Texture>& GetTexture() const { return m_Texture; }
         const glm::vec2* GetTexCoord() const { return m_TexCoord; }
 
-        void UpdateCoords(const glm::vec2& coords) { m_Coords = coords; UpdateTexcoords(); }
-        void UpdateSpriteSize(const glm::vec2& spriteSize) { m_SpriteSize = spriteSize; }
-        void UpdateCellSize(const glm::vec2& cellSize) { m_CellSize = cellSize; }
-
-        glm::vec2& GetSpriteSize() { return m_SpriteSize; }
-        glm::vec2& GetCellSize() { return m_CellSize; }
-        glm::vec2& GetCoords() { return m_Coords; }
+        const glm::vec2& GetSpriteSize() const { return m_SpriteSize; }
+        const glm::vec2& GetCellSize() const { return m_CellSize; }
+        const glm::vec2& GetCoords() const { return m_Coords; }
 
         // By Default Tile size is 16 x 16
-        static Ref<SubTexture> CreateFromCoords(const Ref<Texture>& texture, const glm::vec2& coords, const glm::vec2& spriteSize = {1.0f, 1.0f}, const glm::vec2& cellSize = {16.0f, 16.0f});
+        static SubTextureHandle CreateFromCoords(const Ref<Texture>& texture, const glm::vec2& coords, const glm::vec2& spriteSize = {1.0f, 1.0f}, const glm::vec2& cellSize = {16.0f, 16.0f});
 
-    private:
-        void UpdateTexcoords();
+        // NOTE: Reference is valid only till next CreateFromCoords call. Stale handle
+        // gets the empty SubTexture
+        static const SubTexture& Get(SubTextureHandle handle);
+        static uint32_t GetNumInterned();
+        static void ClearInterned();
+
+        // Reference count of interned entry. Handle 0 and stale handles (entry already
+        // released) are ignored
+        static void Retain(SubTextureHandle handle);
+        static void Release(SubTextureHandle handle);
 
     private:
         Ref<Texture> m_Texture;
         glm::vec2 m_TexCoord[4];
-        glm::vec2 m_SpriteSize;
-        glm::vec2 m_CellSize;
-        glm::vec2 m_Coords;
+        glm::vec2 m_SpriteSize = { 1.0f, 1.0f };
+        glm::vec2 m_CellSize = { 16.0f, 16.0f };
+        glm::vec2 m_Coords = { 0.0f, 0.0f };
+    };
+
+    // ******************************************************************************
+    // Owning SubTextureHandle. Retains the interned entry while it is alive, so that
+    // entries not used by any component are released. Converts to and from handle
+    // so it can be used in place of SubTextureHandle
+    // ******************************************************************************
+    class SubTextureRef
+    {
+    public:
+        SubTextureRef() = default;
+        SubTextureRef(SubTextureHandle handle) : m_Handle(handle) { SubTexture::Retain(m_Handle); }
+        SubTextureRef(const SubTextureRef& other) : SubTextureRef(other.m_Handle) {}
+        SubTextureRef(SubTextureRef&& other) noexcept : m_Handle(other.m_Handle) { other.m_Handle = 0; }
+        ~SubTextureRef() { SubTexture::Release(m_Handle); }
+
+        SubTextureRef& operator=(SubTextureRef other) noexcept
+        {
+            std::swap(m_Handle, other.m_Handle);
+            return *this;
+        }
+
+        operator SubTextureHandle() const { return m_Handle; }
+
+    private:
+        SubTextureHandle m_Handle = 0;
     };
 
     // ******************************************************************************
@@ -78,6 +143,9 @@ namespace iKan {
         virtual ~CubeMapTexture() = default;
         virtual void Bind(uint32_t slot = 0) const = 0;
         
+        // Cubemap is loaded asynchronously. Returns false till faces are uploaded
+        virtual bool Uploaded() const = 0;
+        
         static Ref<CubeMapTexture> Create(std::vector<std::string> paths);
         static Ref<CubeMapTexture> Create(const std::string& paths);
         
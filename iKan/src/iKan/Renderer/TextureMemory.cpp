@@ -0,0 +1,172 @@
+// ******************************************************************************
+// File         : TextureMemory.cpp
+// Description  : Tracks memory used by textures and evict them over budget
+// Project      : iKan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "TextureMemory.h"
+#include <iKan/Renderer/Texture.h>
+#include <list>
+
+namespace iKan {
+    
+    // ******************************************************************************
+    // Stores the tracked textures in order of binding
+    // ******************************************************************************
+    struct TextureMemoryData
+    {
+        // ******************************************************************************
+        // Tracking information of a texture
+        // ******************************************************************************
+        struct Entry
+        {
+            Texture* Tex = nullptr;
+            uint64_t LastBoundFrame = 0;
+            std::list<const Texture*>::iterator LruIterator;
+        };
+        
+        uint64_t GpuBudget  = 0;
+        uint64_t FrameIndex = 0;
+        uint32_t NumEvicted = 0;
+        
+        // Front of LRU list is the most recently bound texture
+        std::unordered_map<const Texture*, Entry> Entries;
+        std::list<const Texture*> LruTextures;
+    };
+    
+    // ******************************************************************************
+    // Data is created on first use and never deleted, as textures held in statics
+    // of client unregister themselves while statics are destroyed
+    // ******************************************************************************
+    static TextureMemoryData& GetData()
+    {
+        static TextureMemoryData* s_Data = new TextureMemoryData();
+        return *s_Data;
+    }
+    
+    // ******************************************************************************
+    // Add the memory of texture in usage
+    // ******************************************************************************
+    void TextureMemory::Usage::Add(const Texture& texture)
+    {
+        GpuBytes += texture.GetGpuMemory();
+        CpuBytes += texture.GetCpuMemory();
+        NumTextures++;
+        
+        if (texture.Resident())
+            NumResident++;
+    }
+    
+    // ******************************************************************************
+    // Start tracking the texture
+    // ******************************************************************************
+    void TextureMemory::Register(Texture* texture)
+    {
+        TextureMemoryData& data = GetData();
+
+        auto& entry = data.Entries[texture];
+        entry.Tex            = texture;
+        entry.LastBoundFrame = data.FrameIndex;
+        entry.LruIterator    = data.LruTextures.insert(data.LruTextures.begin(), texture);
+    }
+    
+    // ******************************************************************************
+    // Stop tracking the texture
+    // ******************************************************************************
+    void TextureMemory::Unregister(Texture* texture)
+    {
+        TextureMemoryData& data = GetData();
+
+        if (auto it = data.Entries.find(texture); it != data.Entries.end())
+        {
+            data.LruTextures.erase(it->second.LruIterator);
+            data.Entries.erase(it);
+        }
+    }
+    
+    // ******************************************************************************
+    // Mark the texture as most recently bound
+    // ******************************************************************************
+    void TextureMemory::OnBind(const Texture* texture)
+    {
+        TextureMemoryData& data = GetData();
+
+        if (auto it = data.Entries.find(texture); it != data.Entries.end())
+        {
+            it->second.LastBoundFrame = data.FrameIndex;
+            data.LruTextures.splice(data.LruTextures.begin(), data.LruTextures, it->second.LruIterator);
+        }
+    }
+    
+    // ******************************************************************************
+    // Evict least recently bound textures till GPU memory comes under budget.
+    // Textures bound in the ending frame are never evicted
+    // ******************************************************************************
+    void TextureMemory::OnFrameEnd()
+    {
+        TextureMemoryData& data = GetData();
+
+        if (data.GpuBudget > 0)
+        {
+            uint64_t gpuBytes = GetUsage().GpuBytes;
+            for (auto it = data.LruTextures.rbegin(); it != data.LruTextures.rend() && gpuBytes > data.GpuBudget; it++)
+            {
+                auto& entry = data.Entries[*it];
+                if (entry.LastBoundFrame == data.FrameIndex)
+                    break;
+                
+                if (!entry.Tex->Resident())
+                    continue;
+                
+                gpuBytes -= entry.Tex->GetGpuMemory();
+                entry.Tex->Evict();
+                data.NumEvicted++;
+            }
+        }
+        data.FrameIndex++;
+    }
+    
+    // ******************************************************************************
+    // Set the GPU memory budget in bytes
+    // ******************************************************************************
+    void TextureMemory::SetGpuBudget(uint64_t bytes)
+    {
+        TextureMemoryData& data = GetData();
+
+        IK_CORE_INFO("Texture GPU memory budget is set to {0} bytes", bytes);
+        data.GpuBudget = bytes;
+    }
+    
+    // ******************************************************************************
+    // Get the GPU memory budget in bytes
+    // ******************************************************************************
+    uint64_t TextureMemory::GetGpuBudget()
+    {
+        return GetData().GpuBudget;
+    }
+    
+    // ******************************************************************************
+    // Total number of textures evicted
+    // ******************************************************************************
+    uint32_t TextureMemory::GetNumEvicted()
+    {
+        return GetData().NumEvicted;
+    }
+    
+    // ******************************************************************************
+    // Memory used by all the textures
+    // ******************************************************************************
+    TextureMemory::Usage TextureMemory::GetUsage()
+    {
+        TextureMemoryData& data = GetData();
+
+        Usage usage;
+        for (const auto& [texture, entry] : data.Entries)
+            usage.Add(*entry.Tex);
+        return usage;
+    }
+    
+}
@@ -0,0 +1,51 @@
+// ******************************************************************************
+// File         : TextureMemory.h
+// Description  : Tracks memory used by textures and evict them over budget
+// Project      : iKan : Renderer
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+namespace iKan {
+    
+    class Texture;
+    
+    // ******************************************************************************
+    // Tracks the GPU and CPU memory of all the textures. If GPU memory exceeds the
+    // budget then least recently bound textures are evicted at the end of frame.
+    // Evicted texture reloads itself on next bind
+    // ******************************************************************************
+    class TextureMemory
+    {
+    public:
+        // ******************************************************************************
+        // Memory used by textures
+        // ******************************************************************************
+        struct Usage
+        {
+            uint64_t GpuBytes    = 0;
+            uint64_t CpuBytes    = 0;
+            uint32_t NumTextures = 0;
+            uint32_t NumResident = 0;
+            
+            void Add(const Texture& texture);
+        };
+        
+    public:
+        static void Register(Texture* texture);
+        static void Unregister(Texture* texture);
+        static void OnBind(const Texture* texture);
+        static void OnFrameEnd();
+        
+        // 0 budget means no limit
+        static void SetGpuBudget(uint64_t bytes);
+        static uint64_t GetGpuBudget();
+        static uint32_t GetNumEvicted();
+        
+        static Usage GetUsage();
+    };
+    
+}
@@ -49,10 +49,7 @@ namespace iKan {
             Texture.Component.reset();
         
         // If component is subtexture then overrite it with texture
-        if (SubTexComp)
-            SubTexComp.reset();
-        
-        SubTexComp  = nullptr;
+        SubTexComp = 0;
         
         // Image Texture component
         Texture.Component = texture;
@@ -77,7 +74,7 @@ namespace iKan {
     // ******************************************************************************
     // Addthe subtexture compnent to the current entity
     // ******************************************************************************
-    Ref<SubTexture> SpriteRendererComponent::AddSubTexture()
+    SubTextureHandle SpriteRendererComponent::AddSubTexture()
     {
         SubTexComp = SubTexture::CreateFromCoords(Texture.Component, glm::vec2(1.0f));
         
@@ -97,15 +94,11 @@ namespace iKan {
     // ******************************************************************************
     void SpriteRendererComponent::RemoveSubTexture()
     {
-        Texture.Component = SubTexComp->GetTexture();
+        Texture.Component = SubTexture::Get(SubTexComp).GetTexture();
         Texture.Use = true;
         
-        // If texture is already created then delete the texture
-        // (if shared with other entity then reduce the counter)
-        if (SubTexComp)
-            SubTexComp.reset();
-        
-        SubTexComp = nullptr;
+        // Drop the reference, entry is released from table if no other sprite uses it
+        SubTexComp = 0;
     }
     
     // ******************************************************************************
@@ -121,13 +114,8 @@ namespace iKan {
         Texture.Component = nullptr;
         Texture.Use = false;
         
-        // If texture is already created then delete the texture
-        // (if shared with other entity then reduce the counter)
-        if (SubTexComp)
-        {
-            SubTexComp.reset();
-        }
-        SubTexComp = nullptr;
+        // Drop the reference, entry is released from table if no other sprite uses it
+        SubTexComp = 0;
     }
 
 
@@ -12,7 +12,9 @@
 #include <iKan/Core/UUID.h>
 #include <iKan/Scene/SceneCamera.h>
 #include <iKan/Scene/Scene.h>
+#include <iKan/Scene/Prefab.h>
 #include <iKan/Renderer/Texture.h>
+#include <iKan/Renderer/Font.h>
 
 namespace iKan {
     
@@ -108,14 +110,14 @@ namespace iKan {
 
         // Variables
         glm::vec4       ColorComp  = glm::vec4(1.0f);
-        Ref<SubTexture> SubTexComp = nullptr;
+        SubTextureRef   SubTexComp;
         ImageTexture    Texture;
 
         float TilingFactor = 1.0f;
 
         Ref<iKan::Texture> UploadTexture(const Ref<iKan::Texture>& texture);
         Ref<iKan::Texture> UploadTexture(const std::string& path);
-        Ref<SubTexture> AddSubTexture();
+        SubTextureHandle AddSubTexture();
         void RemoveSubTexture();
         void ResetAllComponents();
 
@@ -125,13 +127,13 @@ namespace iKan {
         SpriteRendererComponent(const SpriteRendererComponent&) = default;
         
         SpriteRendererComponent(const glm::vec4& color)
-        : ColorComp(color), SubTexComp(nullptr) { }
+        : ColorComp(color), SubTexComp(0) { }
         
-        SpriteRendererComponent(const Ref<SubTexture>& subtexture)
+        SpriteRendererComponent(SubTextureHandle subtexture)
         : ColorComp(glm::vec4(1.0f)), SubTexComp(subtexture) { }
         
         SpriteRendererComponent(const Ref<iKan::Texture>& texture)
-        : ColorComp(glm::vec4(1.0f)), SubTexComp(nullptr) { }
+        : ColorComp(glm::vec4(1.0f)), SubTexComp(0) { }
     };
     
     // ******************************************************************************
@@ -149,6 +151,25 @@ namespace iKan {
         CircleRendererComponent() = default;
         CircleRendererComponent(const CircleRendererComponent&) = default;
     };
+    
+    // ******************************************************************************
+    // Stores the Text, font and color. Entire text is rendered by one entity
+    // ******************************************************************************
+    struct TextRendererComponent
+    {
+        // Variables
+        std::string     Text;
+        glm::vec4       ColorComp = glm::vec4(1.0f);
+        Ref<iKan::Font> Font;
+        
+        ~TextRendererComponent() = default;
+        
+        TextRendererComponent() = default;
+        TextRendererComponent(const TextRendererComponent&) = default;
+        
+        TextRendererComponent(const std::string& text, const Ref<iKan::Font>& font, const glm::vec4& color = glm::vec4(1.0f))
+        : Text(text), ColorComp(color), Font(font) { }
+    };
      
     // ******************************************************************************
     // Stores a flag to check if we want to show this entity on Scene Hierarchy
@@ -243,5 +264,22 @@ namespace iKan {
         BoxColloider2DComponent() = default;
         BoxColloider2DComponent(const BoxColloider2DComponent& other) = default;
     };
+
+    // ******************************************************************************
+    // Prefab of instance. Components that instance does not have are shared from
+    // prefab (check Entity::FindComponent). Scene keeps the prefab alive
+    // ******************************************************************************
+    struct PrefabComponent
+    {
+        const Prefab* Source = nullptr;
+
+        ~PrefabComponent() = default;
+
+        PrefabComponent() = default;
+        PrefabComponent(const PrefabComponent& other) = default;
+
+        PrefabComponent(const Prefab* prefab)
+        : Source(prefab) { }
+    };
         
 }
@@ -78,8 +78,39 @@ namespace iKan {
             m_Scene->m_Registry.remove<T>(m_EntityHandle);
         }
         
+        // ******************************************************************************
+        // Component T of entity, or of its prefab if entity does not override it. Null
+        // if both do not have it
+        // ******************************************************************************
+        template<typename T>
+        const T* FindComponent()
+        {
+            if (const T* component = m_Scene->m_Registry.try_get<T>(m_EntityHandle))
+                return component;
+
+            if (const auto* prefab = m_Scene->m_Registry.try_get<PrefabComponent>(m_EntityHandle))
+                return prefab->Source->TryGetComponent<T>();
+            return nullptr;
+        }
+
+        // ******************************************************************************
+        // Add the component T to entity, copied from its prefab if prefab has it. Added
+        // component overrides the one of prefab
+        // ******************************************************************************
+        template<typename T>
+        T& OverrideComponent()
+        {
+            if (HasComponent<T>())
+                return GetComponent<T>();
+
+            if (const T* shared = FindComponent<T>())
+                return AddComponent<T>(*shared);
+            return AddComponent<T>();
+        }
+
         UUID GetUUID() { return GetComponent<IDComponent>().ID; }
         const std::string& GetName() { return GetComponent<TagComponent>().Tag; }
+        Scene* GetScene() const { return m_Scene; }
         
         operator entt::entity() const { return m_EntityHandle; }
         operator bool() const { return m_EntityHandle != entt::null; }
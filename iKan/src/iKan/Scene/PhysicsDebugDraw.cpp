@@ -0,0 +1,108 @@
+// ******************************************************************************
+// File         : PhysicsDebugDraw.cpp
+// Description  : Box2D debug draw implemented with Renderer2D line batch
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "PhysicsDebugDraw.h"
+#include <iKan/Renderer/Renderer2D.h>
+
+#include "box2d/b2_math.h"
+
+#include <glm/gtc/constants.hpp>
+
+namespace iKan {
+    
+    // Number of segments of circle
+    static constexpr int32_t s_CircleSegments = 24;
+    
+    // Max vertices of Box2D polygon
+    static constexpr int32_t s_MaxPolygonVertices = 8;
+    
+    static glm::vec4 ToColor(const b2Color& color) { return { color.r, color.g, color.b, color.a }; }
+    
+    // ******************************************************************************
+    // Draw the outline of polygon
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+    {
+        glm::vec3 points[s_MaxPolygonVertices];
+        
+        uint32_t count = (uint32_t)std::min(vertexCount, s_MaxPolygonVertices);
+        for (uint32_t i = 0; i < count; i++)
+            points[i] = { vertices[i].x, vertices[i].y, m_Depth };
+        
+        Renderer2D::DrawPolyline(points, count, ToColor(color), m_Thickness, true);
+    }
+    
+    // ******************************************************************************
+    // Draw the solid polygon. Only outline is drawn so that all the debug shapes
+    // stay in line batch
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+    {
+        DrawPolygon(vertices, vertexCount, color);
+    }
+    
+    // ******************************************************************************
+    // Draw the outline of circle
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawCircle(const b2Vec2& center, float radius, const b2Color& color)
+    {
+        glm::vec3 points[s_CircleSegments];
+        for (int32_t i = 0; i < s_CircleSegments; i++)
+        {
+            float angle = 2.0f * glm::pi<float>() * (float)i / (float)s_CircleSegments;
+            points[i] = { center.x + radius * cosf(angle), center.y + radius * sinf(angle), m_Depth };
+        }
+        
+        Renderer2D::DrawPolyline(points, s_CircleSegments, ToColor(color), m_Thickness, true);
+    }
+    
+    // ******************************************************************************
+    // Draw the solid circle, outline with the line along the axis to show rotation
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color)
+    {
+        DrawCircle(center, radius, color);
+        
+        b2Vec2 p = center + radius * axis;
+        Renderer2D::DrawLine({ center.x, center.y, m_Depth }, { p.x, p.y, m_Depth }, ToColor(color), m_Thickness);
+    }
+    
+    // ******************************************************************************
+    // Draw the line segment
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
+    {
+        Renderer2D::DrawLine({ p1.x, p1.y, m_Depth }, { p2.x, p2.y, m_Depth }, ToColor(color), m_Thickness);
+    }
+    
+    // ******************************************************************************
+    // Draw the axis of transform. Red is x and green is y
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawTransform(const b2Transform& xf)
+    {
+        const float axisScale = 0.4f;
+        
+        b2Vec2 p = xf.p;
+        b2Vec2 px = p + axisScale * xf.q.GetXAxis();
+        b2Vec2 py = p + axisScale * xf.q.GetYAxis();
+        
+        Renderer2D::DrawLine({ p.x, p.y, m_Depth }, { px.x, px.y, m_Depth }, { 1.0f, 0.0f, 0.0f, 1.0f }, m_Thickness);
+        Renderer2D::DrawLine({ p.x, p.y, m_Depth }, { py.x, py.y, m_Depth }, { 0.0f, 1.0f, 0.0f, 1.0f }, m_Thickness);
+    }
+    
+    // ******************************************************************************
+    // Draw the point. Point is one segment of thickness size (pixels), so it is
+    // still in line batch
+    // ******************************************************************************
+    void PhysicsDebugDraw::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
+    {
+        Renderer2D::DrawLine({ p.x, p.y, m_Depth }, { p.x, p.y, m_Depth }, ToColor(color), size);
+    }
+    
+}
@@ -0,0 +1,47 @@
+// ******************************************************************************
+// File         : PhysicsDebugDraw.h
+// Description  : Box2D debug draw implemented with Renderer2D line batch
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include "box2d/b2_draw.h"
+
+namespace iKan {
+    
+    // ******************************************************************************
+    // Draws the shapes of Box2D world with Renderer2D lines. Every shape is a
+    // polyline (circles are approximated with segments) so the whole world ends up
+    // in the line batch of Renderer2D and costs a single draw call.
+    // NOTE: should be used between Renderer2D Begin and End scene
+    // ******************************************************************************
+    class PhysicsDebugDraw : public b2Draw
+    {
+    public:
+        PhysicsDebugDraw() = default;
+        virtual ~PhysicsDebugDraw() = default;
+        
+        void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+        void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+        void DrawCircle(const b2Vec2& center, float radius, const b2Color& color) override;
+        void DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) override;
+        void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
+        void DrawTransform(const b2Transform& xf) override;
+        void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
+        
+        void SetThickness(float thickness) { m_Thickness = thickness; }
+        void SetDepth(float depth) { m_Depth = depth; }
+        
+    private:
+        // Thickness of lines in pixels
+        float m_Thickness = 2.0f;
+        
+        // Z of the shapes, Box2D world is 2D
+        float m_Depth = 0.0f;
+    };
+    
+}
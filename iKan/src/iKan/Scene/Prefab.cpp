@@ -0,0 +1,31 @@
+// ******************************************************************************
+// File         : Prefab.cpp
+// Description  : Prototype of entities, components are shared by all instances
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "Prefab.h"
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Create the prefab
+    // ******************************************************************************
+    Ref<Prefab> Prefab::Create(const std::string& name)
+    {
+        return CreateRef<Prefab>(name);
+    }
+
+    // ******************************************************************************
+    // Prefab constructor. Creates the entity of prototype
+    // ******************************************************************************
+    Prefab::Prefab(const std::string& name)
+    : m_Name(name), m_Entity(m_Prototype.create())
+    {
+        IK_CORE_INFO("Creating Prefab {0}", name);
+    }
+
+}
@@ -0,0 +1,66 @@
+// ******************************************************************************
+// File         : Prefab.h
+// Description  : Prototype of entities, components are shared by all instances
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <entt.hpp>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Prefab stores the components of its prototype once, all the instances of
+    // prefab share them. Instance only stores its ID, tag, transform and the
+    // components that it overrides (added to the instance itself).
+    // Components of prefab are added before it is instantiated and are read only
+    // after that. Journal and snapshots of scene only store entities, so instance
+    // changes a shared component by overriding it (Entity::OverrideComponent).
+    // Prefab is added to scene with Scene::AddPrefabToScene (done by
+    // Scene::Instantiate) and lives as long as scene keeps it
+    // ******************************************************************************
+    class Prefab
+    {
+    public:
+        Prefab(const std::string& name);
+        ~Prefab() = default;
+
+        Prefab(const Prefab&) = delete;
+        Prefab& operator=(const Prefab&) = delete;
+
+        // ******************************************************************************
+        // Add the component T to prototype
+        // ******************************************************************************
+        template<typename T, typename... Args>
+        T& AddComponent(Args&&... args)
+        {
+            IK_CORE_ASSERT(!HasComponent<T>(), "Prefab already has component!");
+            return m_Prototype.emplace<T>(m_Entity, std::forward<Args>(args)...);
+        }
+
+        // ******************************************************************************
+        // Component T of prototype, null if prototype does not have it
+        // ******************************************************************************
+        template<typename T>
+        const T* TryGetComponent() const { return m_Prototype.try_get<T>(m_Entity); }
+
+        template<typename T>
+        bool HasComponent() const { return m_Prototype.has<T>(m_Entity); }
+
+        const std::string& GetName() const { return m_Name; }
+
+        static Ref<Prefab> Create(const std::string& name);
+
+    private:
+        std::string m_Name;
+
+        // Prototype is the only entity of registry
+        entt::registry m_Prototype;
+        entt::entity   m_Entity;
+    };
+
+}
@@ -12,6 +12,7 @@
 #include <iKan/Scene/Component.h>
 #include <iKan/Scene/Viewport.h>
 #include <iKan/Scene/ScriptableEntity.h>
+#include <iKan/Scene/PhysicsDebugDraw.h>
 #include <iKan/Renderer/SceneRenderer.h>
 #include <iKan/Renderer/Renderer2D.h>
 #include <iKan/Renderer/Renderer.h>
@@ -22,6 +23,7 @@
 #include "box2d/b2_polygon_shape.h"
 
 #include <glad/glad.h>
+#include <unordered_set>
 
 namespace iKan {
     
@@ -43,22 +45,29 @@ namespace iKan {
     }
 
     // ******************************************************************************
-    // Copy the component
+    // Copy the pool of component. Entities are same in both registries, so packed
+    // arrays of pool are copied as they are, in one insert. Array of trivially
+    // copyable components is copied with memcpy (vector range insert), others are
+    // copy constructed one by one
     // ******************************************************************************
     template<typename Component>
-    static void CopyComponent(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap)
+    static void CopyPool(entt::registry& dst, entt::registry& src)
     {
         auto view = src.view<Component>();
-        for (auto e : view)
-        {
-            UUID uuid = src.get<IDComponent>(e).ID;
-            IK_CORE_ASSERT(enttMap.find(uuid) != enttMap.end(), "");
-            entt::entity dstEnttID = enttMap.at(uuid);
-            
-            auto& component = src.get<Component>(e);
-            dst.emplace_or_replace<Component>(dstEnttID, component);
-        }
+        if (view.empty())
+            return;
+
+        dst.insert<Component>(view.data(), view.data() + view.size(), view.raw(), view.raw() + view.size());
     }
+
+    // Components that are copied with memcpy, keep them trivially copyable
+    static_assert(std::is_trivially_copyable_v<TransformComponent>);
+    static_assert(std::is_trivially_copyable_v<CircleRendererComponent>);
+    static_assert(std::is_trivially_copyable_v<BoxColloider2DComponent>);
+    static_assert(std::is_trivially_copyable_v<RigidBody2DComponent>);
+    static_assert(std::is_trivially_copyable_v<AABBColloiderComponent>);
+    static_assert(std::is_trivially_copyable_v<SceneHierarchyPannelProp>);
+    static_assert(std::is_trivially_copyable_v<PrefabComponent>);
     
     // ******************************************************************************
     // Copy the component If exist
@@ -81,35 +90,47 @@ namespace iKan {
         
         for (auto texMap : other->m_Data.TextureMap)
             newScene->m_Data.TextureMap[texMap.first] = texMap.second;
-        
-        std::unordered_map<UUID, entt::entity> enttMap;
+
+        // Prefabs are shared, instances of both scenes point to same prefab
+        newScene->m_Data.PrefabMap = other->m_Data.PrefabMap;
         
         auto& srcSceneRegistry = other->m_Registry;
         auto& dstSceneRegistry = newScene->m_Registry;
         
-        auto idView = srcSceneRegistry.view<IDComponent>();
+        // Entities of new scene have same identifiers (and free list) as the ones of
+        // other scene, so components are copied pool by pool without UUID lookup
+        dstSceneRegistry.assign(srcSceneRegistry.data(), srcSceneRegistry.data() + srcSceneRegistry.size());
         
-        // Create Entities in new scene
-        for (auto e : idView)
+        // Copy Components
+        CopyPool<IDComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<TagComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<TransformComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<CameraComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<SpriteRendererComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<SceneHierarchyPannelProp>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<AABBColloiderComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<RigidBody2DComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<BoxColloider2DComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<NativeScriptComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<CircleRendererComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<TextRendererComponent>(dstSceneRegistry, srcSceneRegistry);
+        CopyPool<PrefabComponent>(dstSceneRegistry, srcSceneRegistry);
+        
+        // Entity of each UUID, same as other scene but pointing to new scene
         {
-            UUID uuid = srcSceneRegistry.get<IDComponent>(e).ID;
-            const std::string name = srcSceneRegistry.get<TagComponent>(e).Tag;
+            auto idView = dstSceneRegistry.view<IDComponent>();
+            const IDComponent* ids        = idView.raw();
+            const entt::entity* entities = idView.data();
+            
+            auto& entityIDMap = newScene->m_Data.EntityIDMap;
+            entityIDMap.Reserve(idView.size());
+            for (size_t i = 0; i < idView.size(); i++)
+                entityIDMap[ids[i].ID] = Entity{ entities[i], newScene.get() };
             
-            Entity entity = newScene->CreateEntity(name, uuid);
-            enttMap[uuid] = entity;
+            newScene->m_Data.NumEntities = (uint32_t)idView.size();
+            newScene->m_Data.MaxEntityId = (uint32_t)idView.size();
         }
         
-        // Copy Components
-        CopyComponent<TransformComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<CameraComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<SpriteRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<SceneHierarchyPannelProp>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<AABBColloiderComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<RigidBody2DComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<BoxColloider2DComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<NativeScriptComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<CircleRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        
         dstSceneRegistry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
                                                       {
             // nsc.Scripts is the Vector to store multiple Scripts for 1 entity
@@ -180,6 +201,45 @@ namespace iKan {
         return m_Data.TextureMap[texturePath];
     }
 
+    // ******************************************************************************
+    // Add the prefab in scene, prefabs are stored by name so prefab of same name
+    // is replaced
+    // ******************************************************************************
+    Ref<Prefab> Scene::AddPrefabToScene(const Ref<Prefab>& prefab)
+    {
+        auto& stored = m_Data.PrefabMap[prefab->GetName()];
+        IK_CORE_ASSERT(!stored || stored == prefab, "Prefab of same name already added");
+        stored = prefab;
+        return stored;
+    }
+
+    // ******************************************************************************
+    // Memory used by the textures of this scene. Texture shared by multiple
+    // sprites is counted once
+    // ******************************************************************************
+    TextureMemory::Usage Scene::GetTextureMemoryUsage()
+    {
+        std::unordered_set<const Texture*> textures;
+        for (const auto& [path, texture] : m_Data.TextureMap)
+            textures.insert(texture.get());
+
+        auto view = m_Registry.view<SpriteRendererComponent>();
+        for (auto entity : view)
+        {
+            const auto& sprite = view.get<SpriteRendererComponent>(entity);
+            if (sprite.Texture.Component)
+                textures.insert(sprite.Texture.Component.get());
+            if (sprite.SubTexComp)
+                textures.insert(SubTexture::Get(sprite.SubTexComp).GetTexture().get());
+        }
+
+        TextureMemory::Usage usage;
+        for (const auto* texture : textures)
+            if (texture)
+                usage.Add(*texture);
+        return usage;
+    }
+
     // ******************************************************************************
     // Delete the Editor camera from the scene
     // ******************************************************************************
@@ -246,15 +306,64 @@ namespace iKan {
         entity.AddComponent<TransformComponent>();
         entity.AddComponent<SceneHierarchyPannelProp>(true);
 
-        IK_CORE_ASSERT((m_Data.EntityIDMap.find(uuid) == m_Data.EntityIDMap.end()), "Entity Already Added");
+        IK_CORE_ASSERT(!m_Data.EntityIDMap.Contains(uuid), "Entity Already Added");
         m_Data.EntityIDMap[uuid] = entity;
         
         IK_CORE_TRACE("Entity {0} with ID: {1} is created in the Active Scene", entity.GetComponent<TagComponent>().Tag.c_str(), entity.GetComponent<IDComponent>().ID);
-        IK_CORE_TRACE("Number of entities Added in Scene : {0}, Maximum ID Given to Entity {0}", m_Data.NumEntities++, m_Data.MaxEntityId++);
+        // Counters are not updated in log as log might be removed at compile time
+        m_Data.NumEntities++;
+        m_Data.MaxEntityId++;
+        IK_CORE_TRACE("Number of entities Added in Scene : {0}, Maximum ID Given to Entity {1}", m_Data.NumEntities, m_Data.MaxEntityId);
         
         return entity;
     }
     
+    // ******************************************************************************
+    // Create count entities with default transform
+    // ******************************************************************************
+    std::vector<Entity> Scene::CreateEntities(uint32_t count, const std::string& name)
+    {
+        return CreateEntities(std::vector<TransformComponent>(count), name);
+    }
+
+    // ******************************************************************************
+    // Create entity for each transform. Entities are created in one call and each
+    // component pool is filled in one insert, no log per entity
+    // ******************************************************************************
+    std::vector<Entity> Scene::CreateEntities(const std::vector<TransformComponent>& transforms, const std::string& name)
+    {
+        const size_t count = transforms.size();
+        m_Registry.reserve(m_Registry.size() + count);
+        m_Registry.reserve<IDComponent, TagComponent, TransformComponent, SceneHierarchyPannelProp>(m_Registry.size<IDComponent>() + count);
+
+        std::vector<entt::entity> handles(count);
+        m_Registry.create(handles.begin(), handles.end());
+
+        std::vector<IDComponent> ids(count);
+        for (auto& id : ids)
+            id.ID = UUID();
+
+        m_Registry.insert<IDComponent>(handles.begin(), handles.end(), ids.begin(), ids.end());
+        m_Registry.insert<TagComponent>(handles.begin(), handles.end(), TagComponent(name));
+        m_Registry.insert<TransformComponent>(handles.begin(), handles.end(), transforms.begin(), transforms.end());
+        m_Registry.insert<SceneHierarchyPannelProp>(handles.begin(), handles.end(), SceneHierarchyPannelProp(true));
+
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        m_Data.EntityIDMap.Reserve(m_Data.EntityIDMap.Size() + count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const Entity& entity = entities.emplace_back(handles[i], this);
+            m_Data.EntityIDMap[ids[i].ID] = entity;
+        }
+
+        m_Data.NumEntities += (uint32_t)count;
+        m_Data.MaxEntityId += (uint32_t)count;
+        IK_CORE_TRACE("{0} Entities {1} are created in the Active Scene", count, name);
+
+        return entities;
+    }
+
     // ******************************************************************************
     // Duplicate the entity
     // ******************************************************************************
@@ -274,9 +383,49 @@ namespace iKan {
         CopyComponentIfExist<RigidBody2DComponent>(newEntity, entity);
         CopyComponentIfExist<BoxColloider2DComponent>(newEntity, entity);
         CopyComponentIfExist<CircleRendererComponent>(newEntity, entity);
+        CopyComponentIfExist<TextRendererComponent>(newEntity, entity);
+        CopyComponentIfExist<PrefabComponent>(newEntity, entity);
         
         return newEntity;
     }
+
+    // ******************************************************************************
+    // Create instance of prefab. Instance only has its ID, tag and transform, rest of
+    // the components are shared from prefab
+    // ******************************************************************************
+    Entity Scene::Instantiate(const Ref<Prefab>& prefab, const TransformComponent& transform, UUID uuid)
+    {
+        AddPrefabToScene(prefab);
+
+        Entity entity = CreateEntity(prefab->GetName(), uuid);
+        entity.GetComponent<TransformComponent>() = transform;
+        entity.AddComponent<PrefabComponent>(prefab.get());
+
+        if (const auto* prop = prefab->TryGetComponent<SceneHierarchyPannelProp>())
+            entity.GetComponent<SceneHierarchyPannelProp>() = *prop;
+        return entity;
+    }
+
+    // ******************************************************************************
+    // Create instance of prefab for each transform
+    // ******************************************************************************
+    std::vector<Entity> Scene::Instantiate(const Ref<Prefab>& prefab, const std::vector<TransformComponent>& transforms)
+    {
+        AddPrefabToScene(prefab);
+
+        std::vector<Entity> entities = CreateEntities(transforms, prefab->GetName());
+        if (const auto* prop = prefab->TryGetComponent<SceneHierarchyPannelProp>())
+        {
+            for (auto& entity : entities)
+                entity.GetComponent<SceneHierarchyPannelProp>() = *prop;
+        }
+
+        std::vector<entt::entity> handles(entities.begin(), entities.end());
+        m_Registry.insert<PrefabComponent>(handles.begin(), handles.end(), PrefabComponent(prefab.get()));
+
+        IK_CORE_INFO("Created {0} instances of Prefab {1}", entities.size(), prefab->GetName());
+        return entities;
+    }
     
     // ******************************************************************************
     // Destroy Entity from Scene
@@ -284,11 +433,33 @@ namespace iKan {
     void Scene::DestroyEntity(Entity entity)
     {
         IK_CORE_WARN("Destrying Entity '{0}' with ID {0} from the scene", entity.GetComponent<TagComponent>().Tag.c_str(), entity.GetComponent<IDComponent>().ID);
-        IK_CORE_TRACE("Number of entities Left in Scene : {0}", m_Data.NumEntities--);
+        m_Data.NumEntities--;
+        IK_CORE_TRACE("Number of entities Left in Scene : {0}", m_Data.NumEntities);
 
+        // Entity destroyed while playing can be brought back by stop or checkpoint
+        if (!IsEditing())
+        {
+            if (auto* nsc = m_Registry.try_get<NativeScriptComponent>(entity))
+            {
+                // Scripts are bound to the new entity in first update after restore
+                for (auto script : nsc->Scripts)
+                    script->m_Created = false;
+                m_Data.DestroyedScripts[entity.GetUUID()] = std::move(nsc->Scripts);
+            }
+        }
+
+        m_Data.EntityIDMap.Erase(entity.GetUUID());
         m_Registry.destroy(entity);
     }
 
+    // ******************************************************************************
+    // Number of entities with native scripts
+    // ******************************************************************************
+    uint32_t Scene::GetNumScriptedEntities() const
+    {
+        return (uint32_t)m_Registry.size<NativeScriptComponent>();
+    }
+
     // ******************************************************************************
     // Get the pixel from scene
     // mx -> Mouse position X
@@ -336,14 +507,10 @@ namespace iKan {
 
                 SceneRenderer::BeginScene(this, { camera, camera.GetViewProjection() });
                 RenderSpriteComponent();
-                {
-                    auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
-                    for (auto entity : view)
-                    {
-                        const auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-                        Renderer2D::DrawCircle(transform.GetTransform(), circle.ColorComp, circle.Thickness, circle.Fade, (int)entity);
-                    }
-                }
+                RenderCircleComponent();
+                RenderTextComponent();
+                if (s_NativeData.DebugDraw)
+                    RenderDebugShapes();
                 SceneRenderer::EndScene();
 
                 s_NativeData.CameraWarning = false;
@@ -368,14 +535,10 @@ namespace iKan {
                 
                 SceneRenderer::BeginScene(this, { *editorCamera, viewProj });
                 RenderSpriteComponent();
-                {
-                    auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
-                    for (auto entity : view)
-                    {
-                        const auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-                        Renderer2D::DrawCircle(transform.GetTransform(), circle.ColorComp, circle.Thickness, circle.Fade, (int)entity);
-                    }
-                }
+                RenderCircleComponent();
+                RenderTextComponent();
+                if (s_NativeData.DebugDraw)
+                    RenderDebugShapes();
                 SceneRenderer::EndScene();
                 
                 s_NativeData.CameraWarning = false;
@@ -439,14 +602,10 @@ namespace iKan {
 
             SceneRenderer::BeginScene(this, { *mainCamera, viewProj });
             RenderSpriteComponent();
-            {
-                auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
-                for (auto entity : view)
-                {
-                    const auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-                    Renderer2D::DrawCircle(transform.GetTransform(), circle.ColorComp, circle.Thickness, circle.Fade, (int)entity);
-                }
-            }
+            RenderCircleComponent();
+            RenderTextComponent();
+            if (s_NativeData.DebugDraw)
+                RenderDebugShapes();
             SceneRenderer::EndScene();
 
             s_NativeData.CameraWarning = false;
@@ -463,41 +622,73 @@ namespace iKan {
     void Scene::OnRuntimeStart()
     {
         s_NativeData.SceneState = NativeData::State::Play;
+        m_Data.DestroyedScripts.Clear();
         
+        // Scene is played in place, so scripts that were created in last play are
+        // created again (OnCreate is called in first update)
+        m_Registry.view<NativeScriptComponent>().each([](auto entity, auto& nsc) {
+            for (auto script : nsc.Scripts)
+                script->m_Created = false;
+        });
+
         m_PhysicsWorld = new b2World({ 0.0f, -9.8f });
+
+        // Box2D body is stored in the rigid body and colloider, so each instance of
+        // prefab gets its own copy of them while playing. Snapshot taken before play
+        // does not have them, so they are removed when scene is restored
+        {
+            auto view = m_Registry.view<PrefabComponent>(entt::exclude<RigidBody2DComponent>);
+            for (auto e : view)
+            {
+                Entity entity = { e, this };
+                if (!view.get<PrefabComponent>(e).Source->HasComponent<RigidBody2DComponent>())
+                    continue;
+
+                entity.OverrideComponent<RigidBody2DComponent>();
+                if (entity.FindComponent<BoxColloider2DComponent>())
+                    entity.OverrideComponent<BoxColloider2DComponent>();
+            }
+        }
+
         auto view = m_Registry.view<RigidBody2DComponent>();
         for (auto e : view)
+            CreateRuntimeBody({ e, this });
+    }
+
+    // ******************************************************************************
+    // Create the Box2D body of entity from its rigid body and box colloider
+    // ******************************************************************************
+    void Scene::CreateRuntimeBody(Entity entity)
+    {
+        auto& transform = entity.GetComponent<TransformComponent>();
+        auto& rb2d = entity.GetComponent<RigidBody2DComponent>();
+        
+        b2BodyDef bodyDef;
+        bodyDef.type = RigidBody2DTypeToBox2D(rb2d.Type);
+        bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
+        bodyDef.angle = transform.Rotation.z;
+        
+        b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
+        body->SetFixedRotation(rb2d.FixedRotation);
+        
+        rb2d.RuntimeBody = body;
+        
+        if (entity.HasComponent<BoxColloider2DComponent>())
         {
-            Entity entity = { e, this };
-            auto& transform = entity.GetComponent<TransformComponent>();
-            auto& rb2d = entity.GetComponent<RigidBody2DComponent>();
-            
-            b2BodyDef bodyDef;
-            bodyDef.type = RigidBody2DTypeToBox2D(rb2d.Type);
-            bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
-            bodyDef.angle = transform.Rotation.z;
+            auto& bc2d = entity.GetComponent<BoxColloider2DComponent>();
             
-            b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
-            body->SetFixedRotation(rb2d.FixedRotation);
+            // Offset is center of box in body space, same box as drawn by RenderDebugShapes
+            b2PolygonShape polygonShape;
+            polygonShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y, b2Vec2(bc2d.Offset.x, bc2d.Offset.y), 0.0f);
             
-            rb2d.RuntimeBody = body;
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = & polygonShape;
+            fixtureDef.density = bc2d.Density;
+            fixtureDef.friction = bc2d.Friction;
+            fixtureDef.restitution = bc2d.Restitution;
+            fixtureDef.restitutionThreshold = bc2d.RestitutionThreshold;
             
-            if (entity.HasComponent<BoxColloider2DComponent>())
-            {
-                auto& bc2d = entity.GetComponent<BoxColloider2DComponent>();
-                
-                b2PolygonShape polygonShape;
-                polygonShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y);
-                
-                b2FixtureDef fixtureDef;
-                fixtureDef.shape = & polygonShape;
-                fixtureDef.density = bc2d.Density;
-                fixtureDef.friction = bc2d.Friction;
-                fixtureDef.restitution = bc2d.Restitution;
-                fixtureDef.restitutionThreshold = bc2d.RestitutionThreshold;
-                
-                body->CreateFixture(&fixtureDef);
-            }
+            bc2d.RuntimeFixture = body->CreateFixture(&fixtureDef);
         }
     }
 
@@ -510,6 +701,10 @@ namespace iKan {
         
         delete m_PhysicsWorld;
         m_PhysicsWorld = nullptr;
+        
+        // Bodies are deleted with the world
+        m_Registry.view<RigidBody2DComponent>().each([](auto entity, auto& rb2d) { rb2d.RuntimeBody = nullptr; });
+        m_Registry.view<BoxColloider2DComponent>().each([](auto entity, auto& bc2d) { bc2d.RuntimeFixture = nullptr; });
     }
 
     // ******************************************************************************
@@ -518,19 +713,135 @@ namespace iKan {
     // ******************************************************************************
     void Scene::RenderSpriteComponent()
     {
-        auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-        for (auto entity : group)
-        {
-            const auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
+        auto drawSprite = [](const TransformComponent& transform, const SpriteRendererComponent& sprite, entt::entity entity) {
             if (sprite.Texture.Use)
                 Renderer2D::DrawQuad(transform.GetTransform(), sprite.Texture.Component, (int32_t)entity, sprite.TilingFactor, sprite.ColorComp);
             else if (sprite.SubTexComp)
-                Renderer2D::DrawQuad(transform.GetTransform(), sprite.SubTexComp, (int32_t)entity, sprite.TilingFactor, sprite.ColorComp);
+                Renderer2D::DrawQuad(transform.GetTransform(), SubTexture::Get(sprite.SubTexComp), (int32_t)entity, sprite.TilingFactor, sprite.ColorComp);
             else
                 Renderer2D::DrawQuad(transform.GetTransform(), sprite.ColorComp, (int32_t)entity);
+        };
+
+        auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
+        for (auto entity : group)
+        {
+            const auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
+            drawSprite(transform, sprite, entity);
+        }
+
+        // Instances of prefab that share the sprite of prefab
+        auto view = m_Registry.view<TransformComponent, PrefabComponent>(entt::exclude<SpriteRendererComponent>);
+        for (auto entity : view)
+        {
+            const auto [transform, prefab] = view.get<TransformComponent, PrefabComponent>(entity);
+            if (const auto* sprite = prefab.Source->TryGetComponent<SpriteRendererComponent>())
+                drawSprite(transform, *sprite, entity);
         }
     }
 
+    // ******************************************************************************
+    // Render the circle components
+    // ******************************************************************************
+    void Scene::RenderCircleComponent()
+    {
+        auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
+        for (auto entity : view)
+        {
+            const auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
+            Renderer2D::DrawCircle(transform.GetTransform(), circle.ColorComp, circle.Thickness, circle.Fade, (int)entity);
+        }
+
+        // Instances of prefab that share the circle of prefab
+        auto instances = m_Registry.view<TransformComponent, PrefabComponent>(entt::exclude<CircleRendererComponent>);
+        for (auto entity : instances)
+        {
+            const auto [transform, prefab] = instances.get<TransformComponent, PrefabComponent>(entity);
+            if (const auto* circle = prefab.Source->TryGetComponent<CircleRendererComponent>())
+                Renderer2D::DrawCircle(transform.GetTransform(), circle->ColorComp, circle->Thickness, circle->Fade, (int)entity);
+        }
+    }
+
+    // ******************************************************************************
+    // Render the text components. Glyphs of all the texts are drawn in one call
+    // ******************************************************************************
+    void Scene::RenderTextComponent()
+    {
+        auto view = m_Registry.view<TransformComponent, TextRendererComponent>();
+        for (auto entity : view)
+        {
+            const auto [transform, text] = view.get<TransformComponent, TextRendererComponent>(entity);
+            Renderer2D::DrawString(text.Text, text.Font, transform.GetTransform(), text.ColorComp, (int32_t)entity);
+        }
+
+        // Instances of prefab that share the text of prefab
+        auto instances = m_Registry.view<TransformComponent, PrefabComponent>(entt::exclude<TextRendererComponent>);
+        for (auto entity : instances)
+        {
+            const auto [transform, prefab] = instances.get<TransformComponent, PrefabComponent>(entity);
+            if (const auto* text = prefab.Source->TryGetComponent<TextRendererComponent>())
+                Renderer2D::DrawString(text->Text, text->Font, transform.GetTransform(), text->ColorComp, (int32_t)entity);
+        }
+    }
+    
+    // ******************************************************************************
+    // Debug draw of colliders. All the shapes are lines so they are drawn in one
+    // draw call by Renderer2D
+    // ******************************************************************************
+    void Scene::RenderDebugShapes()
+    {
+        const glm::vec4 aabbColor     = { 1.0f, 0.8f, 0.0f, 1.0f };
+        const glm::vec4 colliderColor = { 0.0f, 1.0f, 0.3f, 1.0f };
+        
+        // AABB Colliders. Same box that is used by Scene::OnBoxColloider
+        {
+            auto view = m_Registry.view<TransformComponent>();
+            for (auto entity : view)
+            {
+                if (!Entity(entity, this).FindComponent<AABBColloiderComponent>())
+                    continue;
+
+                const auto& transform = view.get<TransformComponent>(entity);
+                const glm::vec3 size  = glm::abs(transform.Scale);
+                const glm::vec3 pos   = transform.Translation - (size - 1.0f) / 2.0f;
+                
+                glm::mat4 box = glm::translate(glm::mat4(1.0f), pos + size / 2.0f) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+                Renderer2D::DrawRect(box, aabbColor, 2.0f, (int32_t)entity);
+            }
+        }
+        
+        // In Play state Box2D draws the bodies of world, else draw the Box colliders
+        // from components, same box that is created in Scene::OnRuntimeStart
+        if (m_PhysicsWorld)
+        {
+            static PhysicsDebugDraw s_PhysicsDebugDraw;
+            s_PhysicsDebugDraw.SetFlags(b2Draw::e_shapeBit | b2Draw::e_aabbBit);
+            
+            m_PhysicsWorld->SetDebugDraw(&s_PhysicsDebugDraw);
+            m_PhysicsWorld->DebugDraw();
+            m_PhysicsWorld->SetDebugDraw(nullptr);
+        }
+        else
+        {
+            auto view = m_Registry.view<TransformComponent>();
+            for (auto entity : view)
+            {
+                const auto* collider = Entity(entity, this).FindComponent<BoxColloider2DComponent>();
+                if (!collider)
+                    continue;
+
+                const auto& transform = view.get<TransformComponent>(entity);
+                const auto& bc2d      = *collider;
+                
+                // SetAsBox takes the half extents
+                glm::mat4 box = glm::translate(glm::mat4(1.0f), transform.Translation)
+                              * glm::rotate(glm::mat4(1.0f), transform.Rotation.z, { 0.0f, 0.0f, 1.0f })
+                              * glm::translate(glm::mat4(1.0f), { bc2d.Offset.x, bc2d.Offset.y, 0.0f })
+                              * glm::scale(glm::mat4(1.0f), { 2.0f * bc2d.Size.x * transform.Scale.x, 2.0f * bc2d.Size.y * transform.Scale.y, 1.0f });
+                Renderer2D::DrawRect(box, colliderColor, 2.0f, (int32_t)entity);
+            }
+        }
+    }
+    
     // ******************************************************************************
     // get the canera component. First camera component which is found to be Primary
     // ******************************************************************************
@@ -631,8 +942,9 @@ namespace iKan {
         const auto& ceSize = glm::vec3(abs(ceTc.Scale.x), abs(ceTc.Scale.y), abs(ceTc.Scale.z));
         const auto& cePos  = ceTc.Translation - (ceSize - 1.0f) / 2.0f;
 
-        // Traverse entire Entities to get Box colloider entity one by one
-        auto view = m_Registry.view<AABBColloiderComponent>();
+        // Traverse entire Entities to get Box colloider entity one by one. Colloider
+        // can be of entity or shared from its prefab
+        auto view = m_Registry.view<TransformComponent>();
         for (auto entity : view)
         {
             // no operation for same enitity
@@ -643,11 +955,14 @@ namespace iKan {
             Entity e = { entity, this };
 
             // Coilloider entity (still or moving) property (Size and position)
-            auto& transform = e.GetComponent<TransformComponent>();
-            auto& boxColl   = e.GetComponent<AABBColloiderComponent>();
+            const auto* boxColl = e.FindComponent<AABBColloiderComponent>();
+            if (!boxColl)
+                continue;
+
+            auto& transform = view.get<TransformComponent>(entity);
 
             // If coilloider is rigid
-            if (boxColl.IsRigid)
+            if (boxColl->IsRigid)
             {
                 const auto& entSize = transform.Scale;
 
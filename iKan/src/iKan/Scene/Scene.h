@@ -11,16 +11,22 @@
 
 #include <entt.hpp>
 #include <iKan/Core/UUID.h>
+#include <iKan/Core/UUIDMap.h>
 #include <iKan/Core/TimeStep.h>
 #include <iKan/Editor/EditorCamera.h>
 #include <iKan/Renderer/Texture.h>
+#include <iKan/Renderer/TextureMemory.h>
+#include <iKan/Scene/SceneJournal.h>
 
 class b2World;
 
 namespace iKan {
     
     class Entity;
+    class Prefab;
+    class ScriptableEntity;
     class SceneHeirarchyPannel;
+    struct TransformComponent;
     class Scene
     {
     public:
@@ -50,6 +56,9 @@ namespace iKan {
             
             uint32_t ViewportWidth = 1280.0f, ViewportHeight = 720.0f;
             
+            // Draw colliders, AABBs and physics bodies on top of Scene
+            bool DebugDraw = false;
+            
             // Stores the Editor Camera
             Ref<iKan::EditorCamera> EditorCamera;
         };
@@ -72,8 +81,15 @@ namespace iKan {
             // These textures might be used as Sprite as well
             std::unordered_map<std::string, Ref<Texture>> TextureMap;
 
+            // Prefabs of instances present in the Scene, by name
+            std::unordered_map<std::string, Ref<Prefab>> PrefabMap;
+
             // Store the map of Entityes present in the Scene with their UUID
-            std::unordered_map<UUID, Entity> EntityIDMap;
+            UUIDMap<Entity> EntityIDMap;
+
+            // Scripts of entities destroyed while playing. Snapshot does not have the
+            // scripts, so these are given back when restore creates the entity again
+            UUIDMap<std::vector<ScriptableEntity*>> DestroyedScripts;
         };
 
     public:
@@ -81,7 +97,17 @@ namespace iKan {
         ~Scene();
         
         Entity CreateEntity(const std::string& name = "Unknown Entity", UUID uuid = UUID());
+
+        // Create the entities at once. Storage of their components and the ID map are
+        // reserved up front and each component is inserted in one call
+        std::vector<Entity> CreateEntities(uint32_t count, const std::string& name = "Unknown Entity");
+        std::vector<Entity> CreateEntities(const std::vector<TransformComponent>& transforms, const std::string& name = "Unknown Entity");
+
         Entity DuplicateScene(Entity& entity);
+
+        // Instances of prefab. Bulk version creates all the instances with CreateEntities
+        Entity Instantiate(const Ref<Prefab>& prefab, const TransformComponent& transform, UUID uuid = UUID());
+        std::vector<Entity> Instantiate(const Ref<Prefab>& prefab, const std::vector<TransformComponent>& transforms);
         
         void DestroyEntity(Entity entity);
         void OnEvent(Event& event);
@@ -98,6 +124,7 @@ namespace iKan {
         
         uint32_t GetNumEntities() const { return m_Data.NumEntities; }
         uint32_t GetMaxEntityId() const { return m_Data.MaxEntityId; }
+        uint32_t GetNumScriptedEntities() const;
 
         const std::string& GetFileName() const { return m_Data.FileName; }
         const std::string& GetFilePath() const { return m_Data.FilePath; }
@@ -110,9 +137,12 @@ namespace iKan {
         bool IsEditing() const { return s_NativeData.SceneState == NativeData::State::Edit; }
 
         Data& GetDataRef() { return m_Data; }
+        SceneJournal& GetJournal() { return m_Journal; }
 
         Ref<EditorCamera> GetEditorCamera() { return s_NativeData.EditorCamera; }
         Ref<Texture> AddTextureToScene(const std::string& texturePath);
+        Ref<Prefab> AddPrefabToScene(const Ref<Prefab>& prefab);
+        TextureMemory::Usage GetTextureMemoryUsage();
                 
         NativeData::Type GetSceneType() const { return s_NativeData.SceneType; }
         NativeData::State GetSceneState() const { return s_NativeData.SceneState; }
@@ -136,6 +166,10 @@ namespace iKan {
     private:
         void InstantiateScripts(Timestep ts);
         void RenderSpriteComponent();
+        void RenderCircleComponent();
+        void RenderTextComponent();
+        void RenderDebugShapes();
+        void CreateRuntimeBody(Entity entity);
 
     private:
         // Container that contain all the entities
@@ -146,11 +180,15 @@ namespace iKan {
         
         b2World* m_PhysicsWorld = nullptr;
         
+        // Component changes done in editor, for undo/redo
+        SceneJournal m_Journal{ this };
+        
         static NativeData s_NativeData;
         
         friend class Entity;
         friend class SceneHeirarchyPannel;
         friend class SceneSerializer;
+        friend class SceneJournal;
     };
     
 }
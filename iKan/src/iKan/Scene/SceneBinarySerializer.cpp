@@ -0,0 +1,1065 @@
+// ******************************************************************************
+// File         : SceneBinarySerializer.cpp
+// Description  : Saves and loads the scene data and runtime snapshots in binary
+//                format
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "SceneSerializer.h"
+
+#include <iKan/Core/MappedFile.h>
+#include <iKan/Scene/Entity.h>
+#include <iKan/Scene/Component.h>
+
+#include "box2d/b2_world.h"
+#include "box2d/b2_body.h"
+#include "box2d/b2_fixture.h"
+
+#include <filesystem>
+#include <unordered_set>
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Binary scene file:
+    //
+    //     FileHeader
+    //     BlockHeader[NumBlocks]
+    //     Blocks
+    //
+    // Each block stores one component of all the entities that have it, as arrays
+    // of its fields (SoA), first array is the index of entity in Entities block.
+    // Arrays start at 8 byte alignment so they are used in place from the mapped
+    // file. Strings (tags, text, paths) are stored once in string table and
+    // referred by index. Texture paths are stored once in texture table so each
+    // texture is loaded once. Runtime snapshot has one more block with the state
+    // of Box2D bodies.
+    // ******************************************************************************
+    static constexpr uint32_t s_BinarySceneMagic   = 0x42534B49; // "IKSB"
+    static constexpr uint32_t s_BinarySceneVersion = 1;
+
+    // ******************************************************************************
+    // Type of block in binary scene. Never reorder, only add at the end
+    // ******************************************************************************
+    enum class BinaryBlockType : uint32_t
+    {
+        Strings = 0, TexturePaths, Entities,
+        Transform, Camera, SpriteRenderer, HierarchyProp, AABBColloider,
+        RigidBody2D, BoxColloider2D, CircleRenderer, TextRenderer,
+        BodyState, Prefab
+    };
+
+    // ******************************************************************************
+    // Kind of sprite in binary sprite block
+    // ******************************************************************************
+    enum BinarySpriteKind : uint8_t { ColorSprite = 0, TextureSprite = 1, SubTextureSprite = 2 };
+
+    static constexpr int32_t s_NoIndex = -1;
+
+    struct BinaryFileHeader
+    {
+        uint32_t Magic       = s_BinarySceneMagic;
+        uint32_t Version     = s_BinarySceneVersion;
+        uint32_t NumEntities = 0;
+        uint32_t NumBlocks   = 0;
+    };
+
+    struct BinaryBlockHeader
+    {
+        BinaryBlockType Type;
+        uint32_t Count;
+        uint64_t Offset;
+        uint64_t Size;
+    };
+
+    static uint64_t AlignTo8(uint64_t value) { return (value + 7) & ~7ull; }
+
+    // ******************************************************************************
+    // Block being written. Columns are appended one after other
+    // ******************************************************************************
+    struct BinaryBlockWriter
+    {
+        BinaryBlockType Type;
+        uint32_t Count = 0;
+        std::vector<uint8_t> Data;
+
+        template<typename T>
+        void Write(const std::vector<T>& column)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Data.resize(AlignTo8(Data.size()));
+
+            size_t offset = Data.size();
+            Data.resize(offset + column.size() * sizeof(T));
+            if (!column.empty())
+                memcpy(Data.data() + offset, column.data(), column.size() * sizeof(T));
+        }
+    };
+
+    // ******************************************************************************
+    // Block being read from mapped file. Columns are read in same order as written
+    // and point in to the mapped file. Reader is invalid if a column is out of block
+    // ******************************************************************************
+    class BinaryBlockReader
+    {
+    public:
+        BinaryBlockReader(const uint8_t* data, const BinaryBlockHeader& header)
+        : m_Data(data + header.Offset), m_Size(header.Size), m_Count(header.Count) { }
+
+        template<typename T>
+        const T* Read(size_t count)
+        {
+            m_Cursor = AlignTo8(m_Cursor);
+            if (m_Cursor + count * sizeof(T) > m_Size)
+            {
+                m_Valid = false;
+                return nullptr;
+            }
+
+            const T* column = (const T*)(m_Data + m_Cursor);
+            m_Cursor += count * sizeof(T);
+            return column;
+        }
+
+        template<typename T>
+        const T* Read() { return Read<T>(m_Count); }
+
+        uint32_t GetCount() const { return m_Count; }
+        bool IsValid() const { return m_Valid; }
+
+    private:
+        const uint8_t* m_Data;
+        uint64_t m_Size;
+        uint64_t m_Cursor = 0;
+        uint32_t m_Count;
+        bool     m_Valid = true;
+    };
+
+    // ******************************************************************************
+    // Table of unique strings, strings are referred by their index
+    // ******************************************************************************
+    class BinaryStringTable
+    {
+    public:
+        int32_t Add(const std::string& string)
+        {
+            auto [it, inserted] = m_Indices.try_emplace(string, (int32_t)m_Strings.size());
+            if (inserted)
+                m_Strings.push_back(&it->first);
+            return it->second;
+        }
+
+        // Offsets of strings in characters, one more than strings
+        BinaryBlockWriter CreateBlock() const
+        {
+            std::vector<uint32_t> offsets;
+            std::vector<char> characters;
+            offsets.reserve(m_Strings.size() + 1);
+            for (const std::string* string : m_Strings)
+            {
+                offsets.push_back((uint32_t)characters.size());
+                characters.insert(characters.end(), string->begin(), string->end());
+            }
+            offsets.push_back((uint32_t)characters.size());
+
+            BinaryBlockWriter block = { BinaryBlockType::Strings, (uint32_t)m_Strings.size() };
+            block.Write(offsets);
+            block.Write(characters);
+            return block;
+        }
+
+    private:
+        std::unordered_map<std::string, int32_t> m_Indices;
+        std::vector<const std::string*> m_Strings;
+    };
+
+    // ******************************************************************************
+    // Path of binary scene of YAML scene file
+    // ******************************************************************************
+    std::string SceneSerializer::GetBinaryPath(const std::string& filepath)
+    {
+        return std::filesystem::path(filepath).replace_extension(".iKanBin").string();
+    }
+
+    // ******************************************************************************
+    // Binary scene is up to date if it is newer than YAML scene
+    // ******************************************************************************
+    bool SceneSerializer::IsBinaryUpToDate(const std::string& filepath)
+    {
+        std::error_code error;
+        auto binaryTime = std::filesystem::last_write_time(GetBinaryPath(filepath), error);
+        if (error)
+            return false;
+
+        auto sourceTime = std::filesystem::last_write_time(filepath, error);
+        return !error && binaryTime >= sourceTime;
+    }
+
+    // ******************************************************************************
+    // Write the binary scene or snapshot in file
+    // ******************************************************************************
+    void SceneSerializer::WriteBinaryFile(const std::string& filepath, const SceneSnapshot& data)
+    {
+        std::ofstream out(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            IK_CORE_ERROR("Could not write binary scene '{0}'", filepath);
+            return;
+        }
+        out.write((const char*)data.data(), data.size());
+    }
+
+    // ******************************************************************************
+    // Serialize the Scene in binary format
+    // ******************************************************************************
+    void SceneSerializer::SerializeBinary(const std::string& filepath)
+    {
+        IK_CORE_INFO("Serializing binary scene {0}", filepath);
+        WriteBinaryFile(filepath, WriteBinary(false));
+    }
+
+    // ******************************************************************************
+    // Deserialize the Scene from binary format
+    // ******************************************************************************
+    bool SceneSerializer::DeserializeBinary(const std::string& filepath)
+    {
+        IK_CORE_INFO("Deserializing binary scene {0}", filepath);
+
+        MappedFile file(filepath);
+        if (!file.IsValid() || !ReadBinary(file.GetData(), file.GetSize(), false))
+        {
+            IK_CORE_ERROR("Could not load binary scene '{0}'", filepath);
+            return false;
+        }
+        return true;
+    }
+
+    // ******************************************************************************
+    // Snapshot of scene in memory
+    // ******************************************************************************
+    SceneSnapshot SceneSerializer::TakeSnapshot()
+    {
+        return WriteBinary(true);
+    }
+
+    // ******************************************************************************
+    // Restore the scene from snapshot in memory
+    // ******************************************************************************
+    bool SceneSerializer::RestoreSnapshot(const SceneSnapshot& snapshot)
+    {
+        return RestoreBinary(snapshot.data(), snapshot.size());
+    }
+
+    // ******************************************************************************
+    // Restore the scene from binary. Restore changes the scene while reading the
+    // blocks, so if binary turns out to be corrupted, scene is taken back to the
+    // state it had before restore
+    // ******************************************************************************
+    bool SceneSerializer::RestoreBinary(const uint8_t* data, size_t size)
+    {
+        SceneSnapshot current = WriteBinary(true);
+        if (ReadBinary(data, size, true))
+            return true;
+
+        IK_CORE_ERROR("Could not restore the scene, keeping the scene as it was");
+        [[maybe_unused]] bool restored = ReadBinary(current.data(), current.size(), true);
+        IK_CORE_ASSERT(restored, "Could not get back the scene before restore");
+        return false;
+    }
+
+    // ******************************************************************************
+    // Serialize the snapshot of Scene Runtime
+    // ******************************************************************************
+    void SceneSerializer::SerializeRuntime(const std::string& filepath)
+    {
+        IK_CORE_INFO("Serializing runtime scene {0}", filepath);
+        WriteBinaryFile(filepath, WriteBinary(true));
+    }
+
+    // ******************************************************************************
+    // Restore the Scene Runtime from snapshot file
+    // ******************************************************************************
+    bool SceneSerializer::DeserializeRuntime(const std::string& filepath)
+    {
+        IK_CORE_INFO("Deserializing runtime scene {0}", filepath);
+
+        MappedFile file(filepath);
+        if (!file.IsValid() || !RestoreBinary(file.GetData(), file.GetSize()))
+        {
+            IK_CORE_ERROR("Could not load runtime scene '{0}'", filepath);
+            return false;
+        }
+        return true;
+    }
+
+    // ******************************************************************************
+    // Write the scene in binary format. Runtime also writes the state of Box2D bodies
+    // ******************************************************************************
+    SceneSnapshot SceneSerializer::WriteBinary(bool runtime)
+    {
+        entt::registry& registry = m_Scene->m_Registry;
+
+        BinaryStringTable strings;
+        std::vector<BinaryBlockWriter> blocks;
+
+        // Texture table, index of path in string table per texture
+        std::vector<int32_t> texturePaths;
+        std::unordered_map<std::string, int32_t> textureIndices;
+        auto addTexture = [&](const Ref<Texture>& texture) -> int32_t {
+            if (!texture)
+                return s_NoIndex;
+
+            auto [it, inserted] = textureIndices.try_emplace(texture->GetfilePath(), (int32_t)texturePaths.size());
+            if (inserted)
+                texturePaths.push_back(strings.Add(it->first));
+            return it->second;
+        };
+
+        // Entities in order of the registry, components refer them by index
+        std::unordered_map<entt::entity, uint32_t> entityIndices;
+        entityIndices.reserve(registry.size());
+        {
+            std::vector<uint64_t> uuids;
+            std::vector<int32_t>  tags;
+            registry.each([&](auto entity)
+                          {
+                entityIndices[entity] = (uint32_t)uuids.size();
+                uuids.push_back((uint64_t)registry.get<IDComponent>(entity).ID);
+                tags.push_back(strings.Add(registry.get<TagComponent>(entity).Tag));
+            });
+
+            BinaryBlockWriter& block = blocks.emplace_back(BinaryBlockWriter{ BinaryBlockType::Entities, (uint32_t)uuids.size() });
+            block.Write(uuids);
+            block.Write(tags);
+        }
+
+        // ******************************************************************************
+        // Write a block of component. fillColumns is called for each component to
+        // append its fields to columns, columns are written by writeColumns.
+        // Scene file does not store prefabs, so instances are written with the
+        // components they share from prefab. Snapshot only refers the prefab
+        // ******************************************************************************
+        auto writeComponent = [&](BinaryBlockType type, auto* component, auto fillColumns, auto writeColumns) {
+            using Component = std::remove_pointer_t<decltype(component)>;
+            auto view = registry.view<Component>();
+
+            std::vector<uint32_t> owners;
+            owners.reserve(view.size());
+            for (auto entity : view)
+            {
+                owners.push_back(entityIndices[entity]);
+                fillColumns(view.template get<Component>(entity));
+            }
+
+            if (!runtime)
+            {
+                auto instances = registry.view<PrefabComponent>(entt::exclude<Component>);
+                for (auto entity : instances)
+                {
+                    if (const auto* shared = instances.get<PrefabComponent>(entity).Source->template TryGetComponent<Component>())
+                    {
+                        owners.push_back(entityIndices[entity]);
+                        fillColumns(*shared);
+                    }
+                }
+            }
+            if (owners.empty())
+                return;
+
+            BinaryBlockWriter& block = blocks.emplace_back(BinaryBlockWriter{ type, (uint32_t)owners.size() });
+            block.Write(owners);
+            writeColumns(block);
+        };
+
+        {
+            std::vector<glm::vec3> translations, rotations, scales;
+            writeComponent(BinaryBlockType::Transform, (TransformComponent*)nullptr,
+                           [&](const TransformComponent& tc) {
+                translations.push_back(tc.Translation);
+                rotations.push_back(tc.Rotation);
+                scales.push_back(tc.Scale);
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(translations);
+                block.Write(rotations);
+                block.Write(scales);
+            });
+        }
+
+        {
+            // Perspective : FOV, Near, Far. Orthographic : Size, Near, Far
+            std::vector<glm::vec3> perspectives, orthographics;
+            std::vector<uint8_t> projectionTypes, primaries, fixedAspectRatios;
+            writeComponent(BinaryBlockType::Camera, (CameraComponent*)nullptr,
+                           [&](const CameraComponent& cc) {
+                const auto& camera = cc.Camera;
+                perspectives.push_back({ camera.GetPerspectiveFOV(), camera.GetPerspectiveNearClip(), camera.GetPerspectiveFarClip() });
+                orthographics.push_back({ camera.GetOrthographicSize(), camera.GetOrthographicNearClip(), camera.GetOrthographicFarClip() });
+                projectionTypes.push_back((uint8_t)camera.GetProjectionType());
+                primaries.push_back(cc.GetPrimary());
+                fixedAspectRatios.push_back(cc.FixedAspectRatio);
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(perspectives);
+                block.Write(orthographics);
+                block.Write(projectionTypes);
+                block.Write(primaries);
+                block.Write(fixedAspectRatios);
+            });
+        }
+
+        {
+            std::vector<glm::vec4> colors;
+            std::vector<glm::vec2> coords, spriteSizes, cellSizes;
+            std::vector<float>     tilingFactors;
+            std::vector<int32_t>   textures;
+            std::vector<uint8_t>   kinds, textureUses;
+            writeComponent(BinaryBlockType::SpriteRenderer, (SpriteRendererComponent*)nullptr,
+                           [&](const SpriteRendererComponent& src) {
+                colors.push_back(src.ColorComp);
+                tilingFactors.push_back(src.TilingFactor);
+                textureUses.push_back(src.Texture.Use);
+
+                if (src.Texture.Component)
+                {
+                    kinds.push_back(TextureSprite);
+                    textures.push_back(addTexture(src.Texture.Component));
+                    coords.push_back({}); spriteSizes.push_back({}); cellSizes.push_back({});
+                }
+                else if (src.SubTexComp)
+                {
+                    const auto& subTexture = SubTexture::Get(src.SubTexComp);
+                    kinds.push_back(SubTextureSprite);
+                    textures.push_back(addTexture(subTexture.GetTexture()));
+                    coords.push_back(subTexture.GetCoords());
+                    spriteSizes.push_back(subTexture.GetSpriteSize());
+                    cellSizes.push_back(subTexture.GetCellSize());
+                }
+                else
+                {
+                    kinds.push_back(ColorSprite);
+                    textures.push_back(s_NoIndex);
+                    coords.push_back({}); spriteSizes.push_back({}); cellSizes.push_back({});
+                }
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(colors);
+                block.Write(coords);
+                block.Write(spriteSizes);
+                block.Write(cellSizes);
+                block.Write(tilingFactors);
+                block.Write(textures);
+                block.Write(kinds);
+                block.Write(textureUses);
+            });
+        }
+
+        {
+            std::vector<uint8_t> props;
+            writeComponent(BinaryBlockType::HierarchyProp, (SceneHierarchyPannelProp*)nullptr,
+                           [&](const SceneHierarchyPannelProp& prop) { props.push_back(prop.IsProp); },
+                           [&](BinaryBlockWriter& block) { block.Write(props); });
+        }
+
+        {
+            std::vector<uint8_t> rigids;
+            writeComponent(BinaryBlockType::AABBColloider, (AABBColloiderComponent*)nullptr,
+                           [&](const AABBColloiderComponent& acc) { rigids.push_back(acc.IsRigid); },
+                           [&](BinaryBlockWriter& block) { block.Write(rigids); });
+        }
+
+        {
+            std::vector<uint8_t> types, fixedRotations;
+            writeComponent(BinaryBlockType::RigidBody2D, (RigidBody2DComponent*)nullptr,
+                           [&](const RigidBody2DComponent& rb2d) {
+                types.push_back((uint8_t)rb2d.Type);
+                fixedRotations.push_back(rb2d.FixedRotation);
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(types);
+                block.Write(fixedRotations);
+            });
+        }
+
+        {
+            // Density, Friction, Restitution, Restitution threshold
+            std::vector<glm::vec2> offsets, sizes;
+            std::vector<glm::vec4> materials;
+            writeComponent(BinaryBlockType::BoxColloider2D, (BoxColloider2DComponent*)nullptr,
+                           [&](const BoxColloider2DComponent& bc2d) {
+                offsets.push_back(bc2d.Offset);
+                sizes.push_back(bc2d.Size);
+                materials.push_back({ bc2d.Density, bc2d.Friction, bc2d.Restitution, bc2d.RestitutionThreshold });
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(offsets);
+                block.Write(sizes);
+                block.Write(materials);
+            });
+        }
+
+        {
+            std::vector<glm::vec4> colors;
+            std::vector<float> thicknesses, fades;
+            writeComponent(BinaryBlockType::CircleRenderer, (CircleRendererComponent*)nullptr,
+                           [&](const CircleRendererComponent& cc) {
+                colors.push_back(cc.ColorComp);
+                thicknesses.push_back(cc.Thickness);
+                fades.push_back(cc.Fade);
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(colors);
+                block.Write(thicknesses);
+                block.Write(fades);
+            });
+        }
+
+        {
+            std::vector<glm::vec4> colors;
+            std::vector<int32_t> texts, fonts;
+            std::vector<uint32_t> fontSizes;
+            writeComponent(BinaryBlockType::TextRenderer, (TextRendererComponent*)nullptr,
+                           [&](const TextRendererComponent& tc) {
+                colors.push_back(tc.ColorComp);
+                texts.push_back(strings.Add(tc.Text));
+                fonts.push_back(tc.Font ? strings.Add(tc.Font->GetPath()) : s_NoIndex);
+                fontSizes.push_back(tc.Font ? tc.Font->GetPixelHeight() : 0);
+            }, [&](BinaryBlockWriter& block) {
+                block.Write(colors);
+                block.Write(texts);
+                block.Write(fonts);
+                block.Write(fontSizes);
+            });
+        }
+
+        // Position, angle, velocity of Box2D bodies. Only bodies that exist are written
+        if (runtime)
+        {
+            std::vector<uint32_t>  owners;
+            std::vector<glm::vec4> states; // Position x, y, Angle, Angular velocity
+            std::vector<glm::vec2> velocities;
+            std::vector<uint8_t>   awakes;
+
+            auto view = registry.view<RigidBody2DComponent>();
+            for (auto entity : view)
+            {
+                const b2Body* body = (const b2Body*)view.get<RigidBody2DComponent>(entity).RuntimeBody;
+                if (!body)
+                    continue;
+
+                const auto& position = body->GetPosition();
+                const auto& velocity = body->GetLinearVelocity();
+                owners.push_back(entityIndices[entity]);
+                states.push_back({ position.x, position.y, body->GetAngle(), body->GetAngularVelocity() });
+                velocities.push_back({ velocity.x, velocity.y });
+                awakes.push_back(body->IsAwake());
+            }
+
+            if (!owners.empty())
+            {
+                BinaryBlockWriter& block = blocks.emplace_back(BinaryBlockWriter{ BinaryBlockType::BodyState, (uint32_t)owners.size() });
+                block.Write(owners);
+                block.Write(states);
+                block.Write(velocities);
+                block.Write(awakes);
+            }
+        }
+
+        // Prefab of instances, by name of prefab in scene
+        if (runtime)
+        {
+            std::vector<uint32_t> owners;
+            std::vector<int32_t>  names;
+
+            auto view = registry.view<PrefabComponent>();
+            for (auto entity : view)
+            {
+                owners.push_back(entityIndices[entity]);
+                names.push_back(strings.Add(view.get<PrefabComponent>(entity).Source->GetName()));
+            }
+
+            if (!owners.empty())
+            {
+                BinaryBlockWriter& block = blocks.emplace_back(BinaryBlockWriter{ BinaryBlockType::Prefab, (uint32_t)owners.size() });
+                block.Write(owners);
+                block.Write(names);
+            }
+        }
+
+        // Tables are complete only after all the components are written
+        {
+            BinaryBlockWriter& block = blocks.emplace_back(BinaryBlockWriter{ BinaryBlockType::TexturePaths, (uint32_t)texturePaths.size() });
+            block.Write(texturePaths);
+        }
+        blocks.push_back(strings.CreateBlock());
+
+        // Header and directory of blocks
+        BinaryFileHeader header;
+        header.NumEntities = (uint32_t)entityIndices.size();
+        header.NumBlocks   = (uint32_t)blocks.size();
+
+        std::vector<BinaryBlockHeader> directory;
+        uint64_t offset = AlignTo8(sizeof(BinaryFileHeader) + blocks.size() * sizeof(BinaryBlockHeader));
+        for (const auto& block : blocks)
+        {
+            directory.push_back({ block.Type, block.Count, offset, (uint64_t)block.Data.size() });
+            offset = AlignTo8(offset + block.Data.size());
+        }
+
+        // Blocks start at 8 byte alignment, gap is filled with zero
+        SceneSnapshot data(offset, 0);
+        memcpy(data.data(), &header, sizeof(header));
+        memcpy(data.data() + sizeof(header), directory.data(), directory.size() * sizeof(BinaryBlockHeader));
+        for (size_t i = 0; i < blocks.size(); i++)
+            if (!blocks[i].Data.empty())
+                memcpy(data.data() + directory[i].Offset, blocks[i].Data.data(), blocks[i].Data.size());
+        return data;
+    }
+
+    // ******************************************************************************
+    // Read the scene from binary format. Components are inserted in registry in bulk,
+    // one pool at a time.
+    // Restore reads the snapshot in to the existing entities of scene: entities are
+    // matched by UUID, missing ones are created and the ones not in snapshot are
+    // destroyed. Pools of serialized components are replaced, so components added
+    // after snapshot are removed. Box2D bodies of running scene are kept and moved
+    // to the state of snapshot. Native scripts are not part of snapshot, they stay
+    // with their entities, entities destroyed while playing get back their scripts
+    // from the scene
+    // ******************************************************************************
+    bool SceneSerializer::ReadBinary(const uint8_t* data, size_t size, bool restore)
+    {
+        if (!data || size < sizeof(BinaryFileHeader))
+            return false;
+
+        const auto& header = *(const BinaryFileHeader*)data;
+        if (header.Magic != s_BinarySceneMagic || header.Version != s_BinarySceneVersion)
+        {
+            IK_CORE_ERROR("Not a binary scene of version {0}", s_BinarySceneVersion);
+            return false;
+        }
+
+        // Check the directory so that blocks can be read without bound checks of file
+        const auto* directory = (const BinaryBlockHeader*)(data + sizeof(BinaryFileHeader));
+        if (sizeof(BinaryFileHeader) + header.NumBlocks * sizeof(BinaryBlockHeader) > size)
+            return false;
+
+        const BinaryBlockHeader* blockHeaders[(uint32_t)BinaryBlockType::Prefab + 1] = {};
+        for (uint32_t i = 0; i < header.NumBlocks; i++)
+        {
+            const BinaryBlockHeader& block = directory[i];
+            if (block.Size > size || block.Offset > size - block.Size || block.Offset % 8 != 0)
+            {
+                IK_CORE_ERROR("Corrupted binary scene");
+                return false;
+            }
+
+            // Blocks of newer types are skipped
+            if ((uint32_t)block.Type < std::size(blockHeaders))
+                blockHeaders[(uint32_t)block.Type] = &block;
+        }
+
+        auto getBlock = [&](BinaryBlockType type) { return blockHeaders[(uint32_t)type]; };
+        if (!getBlock(BinaryBlockType::Entities) || !getBlock(BinaryBlockType::Strings) || !getBlock(BinaryBlockType::TexturePaths))
+            return false;
+
+        // String table, strings are views in to mapped file
+        std::vector<std::string_view> strings;
+        {
+            BinaryBlockReader reader(data, *getBlock(BinaryBlockType::Strings));
+            const uint32_t* offsets = reader.Read<uint32_t>(reader.GetCount() + 1);
+            const char* characters  = offsets ? reader.Read<char>(offsets[reader.GetCount()]) : nullptr;
+            if (!reader.IsValid())
+                return false;
+
+            strings.reserve(reader.GetCount());
+            for (uint32_t i = 0; i < reader.GetCount(); i++)
+            {
+                if (offsets[i] > offsets[i + 1])
+                    return false;
+                strings.emplace_back(characters + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+        }
+        auto getString = [&](int32_t index) -> std::string {
+            return (index >= 0 && index < (int32_t)strings.size()) ? std::string(strings[index]) : std::string();
+        };
+
+        // Texture table, each texture is loaded once
+        std::vector<Ref<Texture>> textures;
+        {
+            BinaryBlockReader reader(data, *getBlock(BinaryBlockType::TexturePaths));
+            const int32_t* paths = reader.Read<int32_t>();
+            if (!reader.IsValid())
+                return false;
+
+            textures.reserve(reader.GetCount());
+            for (uint32_t i = 0; i < reader.GetCount(); i++)
+                textures.push_back(m_Scene->AddTextureToScene(getString(paths[i])));
+        }
+        auto getTexture = [&](int32_t index) -> Ref<Texture> {
+            return (index >= 0 && index < (int32_t)textures.size()) ? textures[index] : nullptr;
+        };
+
+        entt::registry& registry = m_Scene->m_Registry;
+        Scene::Data& sceneData   = m_Scene->m_Data;
+        b2World* physicsWorld    = m_Scene->m_PhysicsWorld;
+
+        // Count of entities is checked against the size of block before allocating
+        const BinaryBlockHeader& entitiesBlock = *getBlock(BinaryBlockType::Entities);
+        if (entitiesBlock.Count != header.NumEntities || (uint64_t)header.NumEntities * (sizeof(uint64_t) + sizeof(int32_t)) > entitiesBlock.Size)
+        {
+            IK_CORE_ERROR("Corrupted binary scene, {0} entities do not fit in entity block", header.NumEntities);
+            return false;
+        }
+
+        // Create all the entities at once
+        std::vector<entt::entity> entities(header.NumEntities);
+        {
+            BinaryBlockReader reader(data, *getBlock(BinaryBlockType::Entities));
+            const uint64_t* uuids = reader.Read<uint64_t>();
+            const int32_t*  tags  = reader.Read<int32_t>();
+            if (!reader.IsValid() || reader.GetCount() != header.NumEntities)
+                return false;
+
+            if (restore)
+            {
+                uint32_t numCreated = 0;
+                std::unordered_set<entt::entity> restored;
+                restored.reserve(header.NumEntities);
+                for (uint32_t i = 0; i < header.NumEntities; i++)
+                {
+                    const Entity* found = sceneData.EntityIDMap.Find(uuids[i]);
+                    if (found && registry.valid(*found))
+                    {
+                        entities[i] = *found;
+                    }
+                    else
+                    {
+                        entities[i] = registry.create();
+                        numCreated++;
+                    }
+                    restored.insert(entities[i]);
+                }
+
+                // Entities created after snapshot
+                std::vector<entt::entity> destroyed;
+                registry.each([&](auto entity)
+                              {
+                    if (restored.find(entity) == restored.end())
+                        destroyed.push_back(entity);
+                });
+                for (auto entity : destroyed)
+                {
+                    if (auto* rb2d = registry.try_get<RigidBody2DComponent>(entity); rb2d && rb2d->RuntimeBody && physicsWorld)
+                        physicsWorld->DestroyBody((b2Body*)rb2d->RuntimeBody);
+                    registry.destroy(entity);
+                }
+
+                registry.clear<IDComponent>();
+                registry.clear<TagComponent>();
+                sceneData.EntityIDMap.Clear();
+
+                // Entities created again get back the scripts they had when destroyed
+                for (uint32_t i = 0; i < header.NumEntities && !sceneData.DestroyedScripts.Empty(); i++)
+                {
+                    auto* scripts = sceneData.DestroyedScripts.Find(uuids[i]);
+                    if (!scripts || registry.try_get<NativeScriptComponent>(entities[i]))
+                        continue;
+
+                    registry.emplace<NativeScriptComponent>(entities[i]).Scripts = std::move(*scripts);
+                    sceneData.DestroyedScripts.Erase(uuids[i]);
+                }
+
+                sceneData.NumEntities  = header.NumEntities;
+                sceneData.MaxEntityId += numCreated;
+            }
+            else
+            {
+                registry.create(entities.begin(), entities.end());
+
+                sceneData.NumEntities += header.NumEntities;
+                sceneData.MaxEntityId += header.NumEntities;
+            }
+
+            std::vector<IDComponent>  ids(uuids, uuids + header.NumEntities);
+            std::vector<TagComponent> tagComponents;
+            tagComponents.reserve(header.NumEntities);
+            for (uint32_t i = 0; i < header.NumEntities; i++)
+                tagComponents.emplace_back(getString(tags[i]));
+
+            registry.insert<IDComponent>(entities.begin(), entities.end(), ids.begin(), ids.end());
+            registry.insert<TagComponent>(entities.begin(), entities.end(), tagComponents.begin(), tagComponents.end());
+
+            sceneData.EntityIDMap.Reserve(sceneData.EntityIDMap.Size() + header.NumEntities);
+            for (uint32_t i = 0; i < header.NumEntities; i++)
+                sceneData.EntityIDMap[uuids[i]] = Entity{ entities[i], m_Scene.get() };
+        }
+
+        // Box2D objects of running scene, given back to the restored components
+        std::unordered_map<entt::entity, void*> runtimeBodies, runtimeFixtures;
+        if (restore && physicsWorld)
+        {
+            registry.view<RigidBody2DComponent>().each([&](auto entity, auto& rb2d) {
+                if (rb2d.RuntimeBody)
+                    runtimeBodies[entity] = rb2d.RuntimeBody;
+            });
+            registry.view<BoxColloider2DComponent>().each([&](auto entity, auto& bc2d) {
+                if (bc2d.RuntimeFixture)
+                    runtimeFixtures[entity] = bc2d.RuntimeFixture;
+            });
+        }
+
+        // ******************************************************************************
+        // Read the block of component and insert the components in one call. readColumns
+        // reads the columns and returns the function that creates component at index
+        // ******************************************************************************
+        bool valid = true;
+        auto readComponent = [&](BinaryBlockType type, auto* component, auto readColumns) {
+            using Component = std::remove_pointer_t<decltype(component)>;
+            if (restore && valid)
+                registry.clear<Component>();
+
+            const BinaryBlockHeader* blockHeader = getBlock(type);
+            if (!blockHeader || !valid)
+                return;
+
+            BinaryBlockReader reader(data, *blockHeader);
+            const uint32_t* owners = reader.Read<uint32_t>();
+            auto createComponent   = readColumns(reader);
+            if (!reader.IsValid())
+            {
+                valid = false;
+                return;
+            }
+
+            uint32_t count = reader.GetCount();
+            std::vector<entt::entity> ownerEntities;
+            std::vector<Component> components;
+            ownerEntities.reserve(count);
+            components.reserve(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (owners[i] >= header.NumEntities)
+                {
+                    valid = false;
+                    return;
+                }
+                ownerEntities.push_back(entities[owners[i]]);
+                components.push_back(createComponent(i));
+            }
+
+            registry.insert<Component>(ownerEntities.begin(), ownerEntities.end(), components.begin(), components.end());
+        };
+
+        readComponent(BinaryBlockType::Transform, (TransformComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const glm::vec3* translations = reader.Read<glm::vec3>();
+            const glm::vec3* rotations    = reader.Read<glm::vec3>();
+            const glm::vec3* scales       = reader.Read<glm::vec3>();
+            return [=](uint32_t i) {
+                TransformComponent tc(translations[i]);
+                tc.Rotation = rotations[i];
+                tc.Scale    = scales[i];
+                return tc;
+            };
+        });
+
+        readComponent(BinaryBlockType::Camera, (CameraComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const glm::vec3* perspectives      = reader.Read<glm::vec3>();
+            const glm::vec3* orthographics     = reader.Read<glm::vec3>();
+            const uint8_t*   projectionTypes   = reader.Read<uint8_t>();
+            const uint8_t*   primaries         = reader.Read<uint8_t>();
+            const uint8_t*   fixedAspectRatios = reader.Read<uint8_t>();
+            return [=](uint32_t i) {
+                CameraComponent cc;
+                cc.Camera.SetPerspective(perspectives[i].x, perspectives[i].y, perspectives[i].z);
+                cc.Camera.SetOrthographic(orthographics[i].x, orthographics[i].y, orthographics[i].z);
+                cc.Camera.SetProjectionType((SceneCamera::ProjectionType)projectionTypes[i]);
+                if (primaries[i])
+                    cc.MakePrimary();
+                else
+                    cc.MakeEditor();
+                cc.FixedAspectRatio = fixedAspectRatios[i];
+                return cc;
+            };
+        });
+
+        readComponent(BinaryBlockType::SpriteRenderer, (SpriteRendererComponent*)nullptr, [&](BinaryBlockReader& reader) {
+            const glm::vec4* colors        = reader.Read<glm::vec4>();
+            const glm::vec2* coords        = reader.Read<glm::vec2>();
+            const glm::vec2* spriteSizes   = reader.Read<glm::vec2>();
+            const glm::vec2* cellSizes     = reader.Read<glm::vec2>();
+            const float*     tilingFactors = reader.Read<float>();
+            const int32_t*   textureIds    = reader.Read<int32_t>();
+            const uint8_t*   kinds         = reader.Read<uint8_t>();
+            const uint8_t*   textureUses   = reader.Read<uint8_t>();
+            return [=, &getTexture](uint32_t i) {
+                SpriteRendererComponent src(colors[i]);
+                src.TilingFactor = tilingFactors[i];
+
+                if (Ref<Texture> texture = getTexture(textureIds[i]); texture && kinds[i] == TextureSprite)
+                {
+                    src.Texture.Component = texture;
+                    src.Texture.Use       = textureUses[i];
+                }
+                else if (texture && kinds[i] == SubTextureSprite)
+                {
+                    src.SubTexComp = SubTexture::CreateFromCoords(texture, coords[i], spriteSizes[i], cellSizes[i]);
+                }
+                return src;
+            };
+        });
+
+        readComponent(BinaryBlockType::HierarchyProp, (SceneHierarchyPannelProp*)nullptr, [](BinaryBlockReader& reader) {
+            const uint8_t* props = reader.Read<uint8_t>();
+            return [=](uint32_t i) { return SceneHierarchyPannelProp((bool)props[i]); };
+        });
+
+        readComponent(BinaryBlockType::AABBColloider, (AABBColloiderComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const uint8_t* rigids = reader.Read<uint8_t>();
+            return [=](uint32_t i) { return AABBColloiderComponent((bool)rigids[i]); };
+        });
+
+        readComponent(BinaryBlockType::RigidBody2D, (RigidBody2DComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const uint8_t* types          = reader.Read<uint8_t>();
+            const uint8_t* fixedRotations = reader.Read<uint8_t>();
+            return [=](uint32_t i) {
+                RigidBody2DComponent rb2d;
+                rb2d.Type          = (RigidBody2DComponent::BodyType)types[i];
+                rb2d.FixedRotation = fixedRotations[i];
+                return rb2d;
+            };
+        });
+
+        readComponent(BinaryBlockType::BoxColloider2D, (BoxColloider2DComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const glm::vec2* offsets   = reader.Read<glm::vec2>();
+            const glm::vec2* sizes     = reader.Read<glm::vec2>();
+            const glm::vec4* materials = reader.Read<glm::vec4>();
+            return [=](uint32_t i) {
+                BoxColloider2DComponent bc2d;
+                bc2d.Offset               = offsets[i];
+                bc2d.Size                 = sizes[i];
+                bc2d.Density              = materials[i].x;
+                bc2d.Friction             = materials[i].y;
+                bc2d.Restitution          = materials[i].z;
+                bc2d.RestitutionThreshold = materials[i].w;
+                return bc2d;
+            };
+        });
+
+        readComponent(BinaryBlockType::CircleRenderer, (CircleRendererComponent*)nullptr, [](BinaryBlockReader& reader) {
+            const glm::vec4* colors      = reader.Read<glm::vec4>();
+            const float*     thicknesses = reader.Read<float>();
+            const float*     fades       = reader.Read<float>();
+            return [=](uint32_t i) {
+                CircleRendererComponent cc;
+                cc.ColorComp = colors[i];
+                cc.Thickness = thicknesses[i];
+                cc.Fade      = fades[i];
+                return cc;
+            };
+        });
+
+        readComponent(BinaryBlockType::TextRenderer, (TextRendererComponent*)nullptr, [&](BinaryBlockReader& reader) {
+            const glm::vec4* colors    = reader.Read<glm::vec4>();
+            const int32_t*   texts     = reader.Read<int32_t>();
+            const int32_t*   fonts     = reader.Read<int32_t>();
+            const uint32_t*  fontSizes = reader.Read<uint32_t>();
+            return [=, &getString](uint32_t i) {
+                std::string fontPath = getString(fonts[i]);
+                return TextRendererComponent(getString(texts[i]), fontPath.empty() ? nullptr : Font::Create(fontPath, fontSizes[i]), colors[i]);
+            };
+        });
+
+        // Instances whose prefab is not in scene keep only their own components
+        readComponent(BinaryBlockType::Prefab, (PrefabComponent*)nullptr, [&](BinaryBlockReader& reader) {
+            const int32_t* names = reader.Read<int32_t>();
+            return [=, &getString, &sceneData](uint32_t i) {
+                auto it = sceneData.PrefabMap.find(getString(names[i]));
+                return PrefabComponent(it != sceneData.PrefabMap.end() ? it->second.get() : nullptr);
+            };
+        });
+        {
+            std::vector<entt::entity> orphans;
+            registry.view<PrefabComponent>().each([&](auto entity, const auto& prefab) {
+                if (!prefab.Source)
+                    orphans.push_back(entity);
+            });
+            registry.remove<PrefabComponent>(orphans.begin(), orphans.end());
+        }
+
+        if (!valid)
+        {
+            IK_CORE_ERROR("Corrupted binary scene");
+            return false;
+        }
+
+        // Bodies of entities that still have rigid body are kept and others are
+        // destroyed, new rigid bodies get their body. Then all the bodies are moved to
+        // the state in snapshot, or to their transform if snapshot has no state of body
+        if (restore && physicsWorld)
+        {
+            for (auto [entity, body] : runtimeBodies)
+            {
+                if (auto* rb2d = registry.try_get<RigidBody2DComponent>(entity))
+                    rb2d->RuntimeBody = body;
+                else
+                    physicsWorld->DestroyBody((b2Body*)body);
+            }
+            for (auto [entity, fixture] : runtimeFixtures)
+            {
+                // Fixture is destroyed with its body
+                auto* rb2d = registry.try_get<RigidBody2DComponent>(entity);
+                if (!rb2d || !rb2d->RuntimeBody)
+                    continue;
+
+                if (auto* bc2d = registry.try_get<BoxColloider2DComponent>(entity))
+                    bc2d->RuntimeFixture = fixture;
+                else
+                    ((b2Body*)rb2d->RuntimeBody)->DestroyFixture((b2Fixture*)fixture);
+            }
+
+            auto view = registry.view<RigidBody2DComponent>();
+            for (auto entity : view)
+            {
+                auto& rb2d = view.get<RigidBody2DComponent>(entity);
+                if (!rb2d.RuntimeBody)
+                    m_Scene->CreateRuntimeBody({ entity, m_Scene.get() });
+
+                const auto& transform = registry.get<TransformComponent>(entity);
+                b2Body* body = (b2Body*)rb2d.RuntimeBody;
+                body->SetTransform({ transform.Translation.x, transform.Translation.y }, transform.Rotation.z);
+                body->SetLinearVelocity({ 0.0f, 0.0f });
+                body->SetAngularVelocity(0.0f);
+                body->SetAwake(true);
+            }
+
+            if (const BinaryBlockHeader* blockHeader = getBlock(BinaryBlockType::BodyState))
+            {
+                BinaryBlockReader reader(data, *blockHeader);
+                const uint32_t*  owners     = reader.Read<uint32_t>();
+                const glm::vec4* states     = reader.Read<glm::vec4>();
+                const glm::vec2* velocities = reader.Read<glm::vec2>();
+                const uint8_t*   awakes     = reader.Read<uint8_t>();
+                if (!reader.IsValid())
+                    return false;
+
+                for (uint32_t i = 0; i < reader.GetCount(); i++)
+                {
+                    if (owners[i] >= header.NumEntities)
+                        continue;
+
+                    auto* rb2d = registry.try_get<RigidBody2DComponent>(entities[owners[i]]);
+                    if (!rb2d || !rb2d->RuntimeBody)
+                        continue;
+
+                    b2Body* body = (b2Body*)rb2d->RuntimeBody;
+                    body->SetTransform({ states[i].x, states[i].y }, states[i].z);
+                    body->SetLinearVelocity({ velocities[i].x, velocities[i].y });
+                    body->SetAngularVelocity(states[i].w);
+                    body->SetAwake(awakes[i]);
+                }
+            }
+        }
+
+        IK_CORE_INFO("{0} {1} entities from binary scene", restore ? "Restored" : "Deserialized", header.NumEntities);
+        return true;
+    }
+
+}
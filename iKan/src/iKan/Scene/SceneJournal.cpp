@@ -0,0 +1,687 @@
+// ******************************************************************************
+// File         : SceneJournal.cpp
+// Description  : Journal of component changes for undo/redo and scene patches
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#include "SceneJournal.h"
+#include <iKan/Scene/Entity.h>
+#include <iKan/Scene/Component.h>
+
+#include "box2d/b2_world.h"
+#include "box2d/b2_body.h"
+
+namespace iKan {
+
+    // ******************************************************************************
+    // Scene patch:
+    //
+    //     Magic, Version, NumChanges
+    //     { UUID, ComponentType, StateSize, State }[NumChanges]
+    //
+    // State is the component encoded by SceneJournal::CaptureState, empty state
+    // removes the component
+    // ******************************************************************************
+    static constexpr uint32_t s_PatchMagic   = 0x50534B49; // "IKSP"
+    static constexpr uint32_t s_PatchVersion = 1;
+
+    // ******************************************************************************
+    // Kind of sprite in encoded state
+    // ******************************************************************************
+    enum class JournalSpriteKind : uint8_t { Color = 0, Texture = 1, SubTexture = 2 };
+
+    // ******************************************************************************
+    // Append the values to encoded state
+    // ******************************************************************************
+    class StateWriter
+    {
+    public:
+        StateWriter(std::vector<uint8_t>& data)
+        : m_Data(data) { }
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            size_t offset = m_Data.size();
+            m_Data.resize(offset + sizeof(T));
+            memcpy(m_Data.data() + offset, &value, sizeof(T));
+        }
+
+        void Write(const std::string& string)
+        {
+            Write((uint32_t)string.size());
+            m_Data.insert(m_Data.end(), string.begin(), string.end());
+        }
+
+        void WriteBytes(const std::vector<uint8_t>& bytes)
+        {
+            Write((uint32_t)bytes.size());
+            m_Data.insert(m_Data.end(), bytes.begin(), bytes.end());
+        }
+
+    private:
+        std::vector<uint8_t>& m_Data;
+    };
+
+    // ******************************************************************************
+    // Read the values of encoded state in same order as written. Reader is invalid
+    // if a value is out of data
+    // ******************************************************************************
+    class StateReader
+    {
+    public:
+        StateReader(const uint8_t* data, size_t size)
+        : m_Data(data), m_Size(size) { }
+
+        template<typename T>
+        T Read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value{};
+            if (m_Cursor + sizeof(T) > m_Size)
+            {
+                m_Valid = false;
+                return value;
+            }
+
+            memcpy(&value, m_Data + m_Cursor, sizeof(T));
+            m_Cursor += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            uint32_t size = Read<uint32_t>();
+            const char* characters = (const char*)ReadBytes(size);
+            return characters ? std::string(characters, size) : "";
+        }
+
+        const uint8_t* ReadBytes(size_t size)
+        {
+            if (!m_Valid || m_Cursor + size > m_Size)
+            {
+                m_Valid = false;
+                return nullptr;
+            }
+
+            const uint8_t* bytes = m_Data + m_Cursor;
+            m_Cursor += size;
+            return bytes;
+        }
+
+        bool IsValid() const { return m_Valid; }
+
+    private:
+        const uint8_t* m_Data;
+        size_t m_Size;
+        size_t m_Cursor = 0;
+        bool   m_Valid = true;
+    };
+
+    // ******************************************************************************
+    // Scene journal constructor
+    // ******************************************************************************
+    SceneJournal::SceneJournal(Scene* scene)
+    : m_Scene(scene)
+    {
+    }
+
+    // ******************************************************************************
+    // Store the state of component before edit. Later calls of same component are
+    // ignored so state before the first change is kept till Commit
+    // ******************************************************************************
+    void SceneJournal::Track(entt::entity entity, ComponentType type)
+    {
+        const auto* idComp = m_Scene->m_Registry.try_get<IDComponent>(entity);
+        if (!m_Scene->IsEditing() || !idComp)
+            return;
+
+        auto key = std::make_pair((uint64_t)idComp->ID, type);
+        if (m_Tracked.find(key) == m_Tracked.end())
+            m_Tracked.emplace(key, CaptureState(m_Scene, entity, type));
+    }
+
+    // ******************************************************************************
+    // Store the changed tracked components as one step
+    // ******************************************************************************
+    bool SceneJournal::Commit()
+    {
+        if (m_Tracked.empty())
+            return false;
+
+        Step step;
+        for (auto& [key, before] : m_Tracked)
+        {
+            // Entity is destroyed while editing
+            entt::entity entity = FindEntity(m_Scene, key.first);
+            if (entity == entt::null)
+                continue;
+
+            std::vector<uint8_t> after = CaptureState(m_Scene, entity, key.second);
+            if (after != before)
+                step.push_back({ key.first, key.second, std::move(before), std::move(after) });
+        }
+        m_Tracked.clear();
+
+        if (step.empty())
+            return false;
+
+        m_Steps.erase(m_Steps.begin() + m_Position, m_Steps.end());
+        m_Steps.push_back(std::move(step));
+        if (m_Steps.size() > s_MaxSteps)
+            m_Steps.pop_front();
+
+        m_Position = m_Steps.size();
+        IK_CORE_TRACE("Journal step {0} with {1} changes", m_Position, m_Steps.back().size());
+        return true;
+    }
+
+    // ******************************************************************************
+    // Undo the last step. Edit in progress is committed first
+    // ******************************************************************************
+    bool SceneJournal::Undo()
+    {
+        Commit();
+        if (!CanUndo())
+            return false;
+
+        ApplyStep(m_Steps[--m_Position], true);
+        return true;
+    }
+
+    // ******************************************************************************
+    // Redo the last undone step
+    // ******************************************************************************
+    bool SceneJournal::Redo()
+    {
+        Commit();
+        if (!CanRedo())
+            return false;
+
+        ApplyStep(m_Steps[m_Position++], false);
+        return true;
+    }
+
+    // ******************************************************************************
+    // Clear all the steps
+    // ******************************************************************************
+    void SceneJournal::Clear()
+    {
+        m_Steps.clear();
+        m_Tracked.clear();
+        m_Position = 0;
+    }
+
+    // ******************************************************************************
+    // Apply the state before (undo) or after (redo) of changes of step
+    // ******************************************************************************
+    void SceneJournal::ApplyStep(const Step& step, bool undo)
+    {
+        for (size_t i = 0; i < step.size(); i++)
+        {
+            const Change& change = undo ? step[step.size() - 1 - i] : step[i];
+
+            entt::entity entity = FindEntity(m_Scene, change.EntityID);
+            if (entity == entt::null)
+            {
+                IK_CORE_WARN("Entity {0} of journal is not in scene", (uint64_t)change.EntityID);
+                continue;
+            }
+
+            const std::vector<uint8_t>& state = undo ? change.Before : change.After;
+            ApplyState(m_Scene, entity, change.Type, state.data(), state.size());
+        }
+    }
+
+    // ******************************************************************************
+    // Net changes of done steps, last state of each changed component
+    // ******************************************************************************
+    ScenePatch SceneJournal::ExportPatch() const
+    {
+        std::map<std::pair<uint64_t, ComponentType>, const std::vector<uint8_t>*> states;
+        for (size_t i = 0; i < m_Position; i++)
+            for (const Change& change : m_Steps[i])
+                states[{ (uint64_t)change.EntityID, change.Type }] = &change.After;
+
+        ScenePatch patch;
+        StateWriter out(patch);
+        out.Write(s_PatchMagic);
+        out.Write(s_PatchVersion);
+        out.Write((uint32_t)states.size());
+        for (const auto& [key, state] : states)
+        {
+            out.Write(key.first);
+            out.Write(key.second);
+            out.WriteBytes(*state);
+        }
+        return patch;
+    }
+
+    // ******************************************************************************
+    // Store the patch in file
+    // ******************************************************************************
+    bool SceneJournal::SavePatch(const std::string& filepath) const
+    {
+        ScenePatch patch = ExportPatch();
+
+        std::ofstream out(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            IK_CORE_ERROR("Could not write scene patch '{0}'", filepath);
+            return false;
+        }
+
+        out.write((const char*)patch.data(), patch.size());
+        IK_CORE_INFO("Scene patch {0} saved ({1} bytes)", filepath, patch.size());
+        return true;
+    }
+
+    // ******************************************************************************
+    // Load the patch from file. Empty if file is not there
+    // ******************************************************************************
+    ScenePatch SceneJournal::LoadPatch(const std::string& filepath)
+    {
+        std::ifstream in(filepath, std::ios::in | std::ios::binary);
+        if (!in)
+        {
+            IK_CORE_ERROR("Could not open scene patch '{0}'", filepath);
+            return {};
+        }
+        return ScenePatch((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    // ******************************************************************************
+    // Apply the patch to scene
+    // ******************************************************************************
+    bool SceneJournal::ApplyPatch(Scene* scene, const ScenePatch& patch)
+    {
+        StateReader in(patch.data(), patch.size());
+        uint32_t magic   = in.Read<uint32_t>();
+        uint32_t version = in.Read<uint32_t>();
+        uint32_t count   = in.Read<uint32_t>();
+        if (!in.IsValid() || magic != s_PatchMagic || version != s_PatchVersion)
+        {
+            IK_CORE_ERROR("Invalid scene patch");
+            return false;
+        }
+
+        uint32_t applied = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint64_t uuid      = in.Read<uint64_t>();
+            ComponentType type = in.Read<ComponentType>();
+            uint32_t size      = in.Read<uint32_t>();
+            const uint8_t* state = in.ReadBytes(size);
+            if (!in.IsValid() || type > ComponentType::TextRenderer)
+            {
+                IK_CORE_ERROR("Scene patch is corrupted");
+                return false;
+            }
+
+            entt::entity entity = FindEntity(scene, uuid);
+            if (entity == entt::null)
+                continue;
+
+            ApplyState(scene, entity, type, state, size);
+            applied++;
+        }
+
+        IK_CORE_INFO("Applied {0} of {1} changes of scene patch", applied, count);
+        return true;
+    }
+
+    // ******************************************************************************
+    // Entity of UUID, null if it is not in scene
+    // ******************************************************************************
+    entt::entity SceneJournal::FindEntity(Scene* scene, UUID uuid)
+    {
+        const Entity* found = scene->GetDataRef().EntityIDMap.Find(uuid);
+        if (!found)
+            return entt::null;
+
+        entt::registry& registry = scene->m_Registry;
+        entt::entity entity      = *found;
+        if (!registry.valid(entity) || (uint64_t)registry.get<IDComponent>(entity).ID != (uint64_t)uuid)
+            return entt::null;
+
+        return entity;
+    }
+
+    // ******************************************************************************
+    // Encode the component of entity, empty if entity does not have it
+    // ******************************************************************************
+    std::vector<uint8_t> SceneJournal::CaptureState(Scene* scene, entt::entity entity, ComponentType type)
+    {
+        entt::registry& registry = scene->m_Registry;
+
+        std::vector<uint8_t> state;
+        StateWriter out(state);
+        switch (type)
+        {
+            case ComponentType::Tag:
+                if (const auto* tag = registry.try_get<TagComponent>(entity))
+                    out.Write(tag->Tag);
+                break;
+
+            case ComponentType::Transform:
+                if (const auto* tc = registry.try_get<TransformComponent>(entity))
+                {
+                    out.Write(tc->Translation);
+                    out.Write(tc->Rotation);
+                    out.Write(tc->Scale);
+                }
+                break;
+
+            case ComponentType::Camera:
+                if (const auto* cc = registry.try_get<CameraComponent>(entity))
+                {
+                    const auto& camera = cc->Camera;
+                    out.Write(glm::vec3(camera.GetPerspectiveFOV(), camera.GetPerspectiveNearClip(), camera.GetPerspectiveFarClip()));
+                    out.Write(glm::vec3(camera.GetOrthographicSize(), camera.GetOrthographicNearClip(), camera.GetOrthographicFarClip()));
+                    out.Write((uint8_t)camera.GetProjectionType());
+                    out.Write((uint8_t)cc->GetPrimary());
+                    out.Write((uint8_t)cc->FixedAspectRatio);
+                }
+                break;
+
+            case ComponentType::SpriteRenderer:
+                if (const auto* src = registry.try_get<SpriteRendererComponent>(entity))
+                {
+                    out.Write(src->ColorComp);
+                    out.Write(src->TilingFactor);
+                    out.Write((uint8_t)src->Texture.Use);
+
+                    if (src->Texture.Component)
+                    {
+                        out.Write(JournalSpriteKind::Texture);
+                        out.Write(src->Texture.Component->GetfilePath());
+                    }
+                    else if (src->SubTexComp)
+                    {
+                        const auto& subTexture = SubTexture::Get(src->SubTexComp);
+                        out.Write(JournalSpriteKind::SubTexture);
+                        out.Write(subTexture.GetTexture()->GetfilePath());
+                        out.Write(subTexture.GetCoords());
+                        out.Write(subTexture.GetSpriteSize());
+                        out.Write(subTexture.GetCellSize());
+                    }
+                    else
+                    {
+                        out.Write(JournalSpriteKind::Color);
+                    }
+                }
+                break;
+
+            case ComponentType::AABBColloider:
+                if (const auto* aabb = registry.try_get<AABBColloiderComponent>(entity))
+                    out.Write((uint8_t)aabb->IsRigid);
+                break;
+
+            case ComponentType::RigidBody2D:
+                if (const auto* rb2d = registry.try_get<RigidBody2DComponent>(entity))
+                {
+                    out.Write(rb2d->Type);
+                    out.Write((uint8_t)rb2d->FixedRotation);
+                }
+                break;
+
+            case ComponentType::BoxColloider2D:
+                if (const auto* bc2d = registry.try_get<BoxColloider2DComponent>(entity))
+                {
+                    out.Write(bc2d->Offset);
+                    out.Write(bc2d->Size);
+                    out.Write(glm::vec4(bc2d->Density, bc2d->Friction, bc2d->Restitution, bc2d->RestitutionThreshold));
+                }
+                break;
+
+            case ComponentType::CircleRenderer:
+                if (const auto* cc = registry.try_get<CircleRendererComponent>(entity))
+                {
+                    out.Write(cc->ColorComp);
+                    out.Write(cc->Thickness);
+                    out.Write(cc->Fade);
+                }
+                break;
+
+            case ComponentType::TextRenderer:
+                if (const auto* tc = registry.try_get<TextRendererComponent>(entity))
+                {
+                    out.Write(tc->Text);
+                    out.Write(tc->ColorComp);
+                    out.Write(tc->Font ? tc->Font->GetPath() : "");
+                    out.Write(tc->Font ? tc->Font->GetPixelHeight() : 0u);
+                }
+                break;
+        }
+        return state;
+    }
+
+    // ******************************************************************************
+    // Set the component of entity to encoded state, component is added if entity
+    // does not have it and empty state removes it. Box2D body of running scene is moved or created again with the
+    // changed components
+    // ******************************************************************************
+    void SceneJournal::ApplyState(Scene* scene, entt::entity entity, ComponentType type, const uint8_t* state, size_t size)
+    {
+        entt::registry& registry = scene->m_Registry;
+        b2World* world = scene->m_PhysicsWorld;
+
+        // Body is created again if its rigid body or colloider is changed, velocity is
+        // kept
+        bool rebuildBody = world && (type == ComponentType::RigidBody2D || type == ComponentType::BoxColloider2D);
+        b2Vec2 linearVelocity = { 0.0f, 0.0f };
+        float angularVelocity = 0.0f;
+        if (auto* rb2d = registry.try_get<RigidBody2DComponent>(entity); rebuildBody && rb2d && rb2d->RuntimeBody)
+        {
+            b2Body* body    = (b2Body*)rb2d->RuntimeBody;
+            linearVelocity  = body->GetLinearVelocity();
+            angularVelocity = body->GetAngularVelocity();
+
+            // Fixtures are destroyed with body
+            world->DestroyBody(body);
+            rb2d->RuntimeBody = nullptr;
+            if (auto* bc2d = registry.try_get<BoxColloider2DComponent>(entity))
+                bc2d->RuntimeFixture = nullptr;
+        }
+
+        StateReader in(state, size);
+        bool remove = (size == 0);
+        switch (type)
+        {
+            case ComponentType::Tag:
+            {
+                // Entity always has tag
+                std::string tag = in.ReadString();
+                if (!remove && in.IsValid())
+                    registry.get_or_emplace<TagComponent>(entity).Tag = tag;
+                break;
+            }
+
+            case ComponentType::Transform:
+            {
+                // Entity always has transform
+                glm::vec3 translation = in.Read<glm::vec3>();
+                glm::vec3 rotation    = in.Read<glm::vec3>();
+                glm::vec3 scale       = in.Read<glm::vec3>();
+                if (remove || !in.IsValid())
+                    break;
+
+                auto& tc       = registry.get_or_emplace<TransformComponent>(entity);
+                tc.Translation = translation;
+                tc.Rotation    = rotation;
+                tc.Scale       = scale;
+
+                if (auto* rb2d = registry.try_get<RigidBody2DComponent>(entity); rb2d && rb2d->RuntimeBody)
+                {
+                    b2Body* body = (b2Body*)rb2d->RuntimeBody;
+                    body->SetTransform({ translation.x, translation.y }, rotation.z);
+                    body->SetAwake(true);
+                }
+                break;
+            }
+
+            case ComponentType::Camera:
+            {
+                glm::vec3 perspective   = in.Read<glm::vec3>();
+                glm::vec3 orthographic  = in.Read<glm::vec3>();
+                uint8_t projectionType  = in.Read<uint8_t>();
+                bool primary            = in.Read<uint8_t>();
+                bool fixedAspectRatio   = in.Read<uint8_t>();
+                if (remove)
+                {
+                    registry.remove_if_exists<CameraComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& cc = registry.get_or_emplace<CameraComponent>(entity);
+                cc.Camera.SetPerspective(perspective.x, perspective.y, perspective.z);
+                cc.Camera.SetOrthographic(orthographic.x, orthographic.y, orthographic.z);
+                cc.Camera.SetProjectionType((SceneCamera::ProjectionType)projectionType);
+                cc.FixedAspectRatio = fixedAspectRatio;
+                if (primary)
+                    cc.MakePrimary();
+                else
+                    cc.MakeEditor();
+                break;
+            }
+
+            case ComponentType::SpriteRenderer:
+            {
+                glm::vec4 color        = in.Read<glm::vec4>();
+                float tilingFactor     = in.Read<float>();
+                bool textureUse        = in.Read<uint8_t>();
+                JournalSpriteKind kind = in.Read<JournalSpriteKind>();
+                std::string path       = (kind != JournalSpriteKind::Color) ? in.ReadString() : "";
+                glm::vec2 coords       = (kind == JournalSpriteKind::SubTexture) ? in.Read<glm::vec2>() : glm::vec2(0.0f);
+                glm::vec2 spriteSize   = (kind == JournalSpriteKind::SubTexture) ? in.Read<glm::vec2>() : glm::vec2(0.0f);
+                glm::vec2 cellSize     = (kind == JournalSpriteKind::SubTexture) ? in.Read<glm::vec2>() : glm::vec2(0.0f);
+                if (remove)
+                {
+                    registry.remove_if_exists<SpriteRendererComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& src        = registry.get_or_emplace<SpriteRendererComponent>(entity);
+                src.ColorComp    = color;
+                src.TilingFactor = tilingFactor;
+                src.Texture.Use  = textureUse;
+                src.Texture.Component = (kind == JournalSpriteKind::Texture) ? scene->AddTextureToScene(path) : nullptr;
+                src.SubTexComp        = (kind == JournalSpriteKind::SubTexture) ? SubTexture::CreateFromCoords(scene->AddTextureToScene(path), coords, spriteSize, cellSize) : 0;
+                break;
+            }
+
+            case ComponentType::AABBColloider:
+            {
+                bool isRigid = in.Read<uint8_t>();
+                if (remove)
+                    registry.remove_if_exists<AABBColloiderComponent>(entity);
+                else if (in.IsValid())
+                    registry.get_or_emplace<AABBColloiderComponent>(entity).IsRigid = isRigid;
+                break;
+            }
+
+            case ComponentType::RigidBody2D:
+            {
+                auto bodyType      = in.Read<RigidBody2DComponent::BodyType>();
+                bool fixedRotation = in.Read<uint8_t>();
+                if (remove)
+                {
+                    registry.remove_if_exists<RigidBody2DComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& rb2d         = registry.get_or_emplace<RigidBody2DComponent>(entity);
+                rb2d.Type          = bodyType;
+                rb2d.FixedRotation = fixedRotation;
+                break;
+            }
+
+            case ComponentType::BoxColloider2D:
+            {
+                glm::vec2 offset   = in.Read<glm::vec2>();
+                glm::vec2 boxSize  = in.Read<glm::vec2>();
+                glm::vec4 material = in.Read<glm::vec4>();
+                if (remove)
+                {
+                    registry.remove_if_exists<BoxColloider2DComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& bc2d                = registry.get_or_emplace<BoxColloider2DComponent>(entity);
+                bc2d.Offset               = offset;
+                bc2d.Size                 = boxSize;
+                bc2d.Density              = material.x;
+                bc2d.Friction             = material.y;
+                bc2d.Restitution          = material.z;
+                bc2d.RestitutionThreshold = material.w;
+                break;
+            }
+
+            case ComponentType::CircleRenderer:
+            {
+                glm::vec4 color = in.Read<glm::vec4>();
+                float thickness = in.Read<float>();
+                float fade      = in.Read<float>();
+                if (remove)
+                {
+                    registry.remove_if_exists<CircleRendererComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& cc     = registry.get_or_emplace<CircleRendererComponent>(entity);
+                cc.ColorComp = color;
+                cc.Thickness = thickness;
+                cc.Fade      = fade;
+                break;
+            }
+
+            case ComponentType::TextRenderer:
+            {
+                std::string text  = in.ReadString();
+                glm::vec4 color   = in.Read<glm::vec4>();
+                std::string font  = in.ReadString();
+                uint32_t fontSize = in.Read<uint32_t>();
+                if (remove)
+                {
+                    registry.remove_if_exists<TextRendererComponent>(entity);
+                    break;
+                }
+                if (!in.IsValid())
+                    break;
+
+                auto& tc     = registry.get_or_emplace<TextRendererComponent>(entity);
+                tc.Text      = text;
+                tc.ColorComp = color;
+                tc.Font      = font.empty() ? nullptr : Font::Create(font, fontSize);
+                break;
+            }
+        }
+
+        if (!remove && !in.IsValid())
+            IK_CORE_ERROR("Invalid state of component {0} of entity {1}", (uint32_t)type, (uint32_t)entity);
+
+        if (auto* rb2d = registry.try_get<RigidBody2DComponent>(entity); rebuildBody && rb2d)
+        {
+            scene->CreateRuntimeBody({ entity, scene });
+
+            b2Body* body = (b2Body*)rb2d->RuntimeBody;
+            body->SetLinearVelocity(linearVelocity);
+            body->SetAngularVelocity(angularVelocity);
+        }
+    }
+
+}
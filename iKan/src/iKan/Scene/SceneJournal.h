@@ -0,0 +1,144 @@
+// ******************************************************************************
+// File         : SceneJournal.h
+// Description  : Journal of component changes for undo/redo and scene patches
+// Project      : iKan : Scene
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+#pragma once
+
+#include <iKan/Core/UUID.h>
+#include <entt.hpp>
+#include <deque>
+#include <map>
+
+namespace iKan {
+
+    class Scene;
+
+    struct TagComponent;
+    struct TransformComponent;
+    struct CameraComponent;
+    struct SpriteRendererComponent;
+    struct AABBColloiderComponent;
+    struct RigidBody2DComponent;
+    struct BoxColloider2DComponent;
+    struct CircleRendererComponent;
+    struct TextRendererComponent;
+
+    // ******************************************************************************
+    // Patch of scene. Last state of changed components, applied to other instance of
+    // same scene (even running one) without serializing whole scene
+    // ******************************************************************************
+    using ScenePatch = std::vector<uint8_t>;
+
+    // ******************************************************************************
+    // Journal of the component changes of scene. Each change stores the state of
+    // one component of one entity (by UUID) before and after edit, encoded in few
+    // bytes, so undo and redo only touch the changed components.
+    // Editors call Track before changing a component and Commit once the edit is
+    // done (mouse released), all the components changed in between are one step
+    // ******************************************************************************
+    class SceneJournal
+    {
+    public:
+        // ******************************************************************************
+        // Type of journaled component. Stored in patch, never reorder, only add at the
+        // end
+        // ******************************************************************************
+        enum class ComponentType : uint8_t
+        {
+            Tag = 0, Transform, Camera, SpriteRenderer, AABBColloider,
+            RigidBody2D, BoxColloider2D, CircleRenderer, TextRenderer
+        };
+
+        // ******************************************************************************
+        // Change of one component. State is empty if entity does not have component,
+        // so adding and removing of component is a change too
+        // ******************************************************************************
+        struct Change
+        {
+            UUID                 EntityID;
+            ComponentType        Type;
+            std::vector<uint8_t> Before, After;
+        };
+
+    public:
+        SceneJournal(Scene* scene);
+        ~SceneJournal() = default;
+
+        SceneJournal(const SceneJournal&) = delete;
+        SceneJournal& operator=(const SceneJournal&) = delete;
+
+        // Store the state of component before it is changed. Only the first call of
+        // a component till Commit is stored. Ignored while scene is playing
+        void Track(entt::entity entity, ComponentType type);
+
+        template<typename T>
+        void Track(entt::entity entity) { Track(entity, GetComponentType<T>()); }
+
+        // Tracked components that are changed are stored as one step, steps that
+        // were undone are lost. Returns false if nothing is changed
+        bool Commit();
+
+        bool Undo();
+        bool Redo();
+        void Clear();
+
+        bool CanUndo() const { return m_Position > 0; }
+        bool CanRedo() const { return m_Position < m_Steps.size(); }
+
+        // Net changes of all the steps done, one record per component with its last
+        // state
+        ScenePatch ExportPatch() const;
+        bool SavePatch(const std::string& filepath) const;
+
+        // Apply the patch to scene. Box2D bodies of running scene are updated with
+        // their components. Entities that are not in scene are skipped
+        static bool ApplyPatch(Scene* scene, const ScenePatch& patch);
+        static ScenePatch LoadPatch(const std::string& filepath);
+
+        // ******************************************************************************
+        // Journaled type of component T
+        // ******************************************************************************
+        template<typename T>
+        static constexpr ComponentType GetComponentType()
+        {
+            if constexpr (std::is_same_v<T, TagComponent>)                  return ComponentType::Tag;
+            else if constexpr (std::is_same_v<T, TransformComponent>)       return ComponentType::Transform;
+            else if constexpr (std::is_same_v<T, CameraComponent>)          return ComponentType::Camera;
+            else if constexpr (std::is_same_v<T, SpriteRendererComponent>)  return ComponentType::SpriteRenderer;
+            else if constexpr (std::is_same_v<T, AABBColloiderComponent>)   return ComponentType::AABBColloider;
+            else if constexpr (std::is_same_v<T, RigidBody2DComponent>)     return ComponentType::RigidBody2D;
+            else if constexpr (std::is_same_v<T, BoxColloider2DComponent>)  return ComponentType::BoxColloider2D;
+            else if constexpr (std::is_same_v<T, CircleRendererComponent>)  return ComponentType::CircleRenderer;
+            else if constexpr (std::is_same_v<T, TextRendererComponent>)    return ComponentType::TextRenderer;
+            else static_assert(sizeof(T) == 0, "Component is not journaled");
+        }
+
+    private:
+        using Step = std::vector<Change>;
+
+        void ApplyStep(const Step& step, bool undo);
+
+        static entt::entity FindEntity(Scene* scene, UUID uuid);
+        static std::vector<uint8_t> CaptureState(Scene* scene, entt::entity entity, ComponentType type);
+        static void ApplyState(Scene* scene, entt::entity entity, ComponentType type, const uint8_t* state, size_t size);
+
+    private:
+        // Oldest steps are dropped after this
+        static constexpr size_t s_MaxSteps = 256;
+
+        Scene* m_Scene;
+
+        // Steps before position are done, the ones after it are undone
+        std::deque<Step> m_Steps;
+        size_t           m_Position = 0;
+
+        // State before edit of tracked components, by UUID and type
+        std::map<std::pair<uint64_t, ComponentType>, std::vector<uint8_t>> m_Tracked;
+    };
+
+}
@@ -16,6 +16,10 @@
 #pragma clang diagnostic ignored "-Wdocumentation"
 #include <yaml-cpp/yaml.h>
 
+#include <optional>
+#include <mutex>
+#include <thread>
+
 namespace YAML {
 
     // ******************************************************************************
@@ -181,31 +185,142 @@ namespace iKan {
         IK_CORE_INFO("Scene Serialised ...");
     }
 
+    // Size of buffer of file stream, YAML is written to file in chunks of this size
+    static constexpr size_t s_WriteBufferSize = 64 * 1024;
+
     // ******************************************************************************
-    // Serialize the entity. Extract the entity componenets from serialiser
+    // Sprite data as it is serialized, sub texture is resolved while capturing
     // ******************************************************************************
-    static void SerializeEntity(YAML::Emitter& out, Entity entity)
+    struct SpriteRecord
     {
-        out << YAML::BeginMap; // Entity
-        out << YAML::Key << "Entity" << YAML::Value << entity.GetUUID();
+        glm::vec4 Color = glm::vec4(1.0f);
+        float TilingFactor = 1.0f;
+        bool IsTexture = false, IsSubTexture = false, TexAssetUse = false;
+        std::string TexAssetPath;
+        glm::vec2 Coords = { 0.0f, 0.0f }, SpriteSize = { 0.0f, 0.0f }, CellSize = { 0.0f, 0.0f };
+    };
+
+    // ******************************************************************************
+    // Text data as it is serialized
+    // ******************************************************************************
+    struct TextRecord
+    {
+        std::string Text, Font;
+        glm::vec4 Color = glm::vec4(1.0f);
+        uint32_t FontSize = 0;
+    };
+
+    // ******************************************************************************
+    // Copy of the serialized components of one entity. Records are captured from the
+    // registry on the calling thread so the file can be written on other thread
+    // while the scene keeps changing
+    // ******************************************************************************
+    struct EntityRecord
+    {
+        UUID ID;
+        std::optional<std::string>              Tag;
+        std::optional<TransformComponent>       Transform;
+        std::optional<CameraComponent>          Camera;
+        std::optional<SpriteRecord>             Sprite;
+        std::optional<SceneHierarchyPannelProp> HierarchyProp;
+        std::optional<AABBColloiderComponent>   AABBColloider;
+        std::optional<RigidBody2DComponent>     RigidBody2D;
+        std::optional<BoxColloider2DComponent>  BoxColloider2D;
+        std::optional<CircleRendererComponent>  CircleRenderer;
+        std::optional<TextRecord>               TextRenderer;
+    };
+
+    // ******************************************************************************
+    // Copy the component of entity in record if entity (or its prefab) has it.
+    // Prefabs are not saved, so instance is saved with the shared components
+    // ******************************************************************************
+    template<typename Component>
+    static void CaptureComponent(std::optional<Component>& record, Entity& entity)
+    {
+        if (const Component* component = entity.FindComponent<Component>())
+            record = *component;
+    }
+
+    // ******************************************************************************
+    // Capture the entity componenets in record
+    // ******************************************************************************
+    static EntityRecord CaptureEntity(Entity entity)
+    {
+        EntityRecord record;
+        record.ID = entity.GetUUID();
 
         if (entity.HasComponent<TagComponent>())
+            record.Tag = entity.GetComponent<TagComponent>().Tag;
+
+        CaptureComponent(record.Transform, entity);
+        CaptureComponent(record.Camera, entity);
+        CaptureComponent(record.HierarchyProp, entity);
+        CaptureComponent(record.AABBColloider, entity);
+        CaptureComponent(record.RigidBody2D, entity);
+        CaptureComponent(record.BoxColloider2D, entity);
+        CaptureComponent(record.CircleRenderer, entity);
+
+        if (const auto* sharedSprite = entity.FindComponent<SpriteRendererComponent>())
+        {
+            const auto& src = *sharedSprite;
+            SpriteRecord& sprite = record.Sprite.emplace();
+            sprite.Color        = src.ColorComp;
+            sprite.TilingFactor = src.TilingFactor;
+
+            if (src.Texture.Component)
+            {
+                sprite.IsTexture    = true;
+                sprite.TexAssetUse  = src.Texture.Use;
+                sprite.TexAssetPath = src.Texture.Component->GetfilePath();
+            }
+            else if (src.SubTexComp)
+            {
+                const auto& subTexture = SubTexture::Get(src.SubTexComp);
+                sprite.IsSubTexture = true;
+                sprite.TexAssetPath = subTexture.GetTexture()->GetfilePath();
+                sprite.Coords       = subTexture.GetCoords();
+                sprite.SpriteSize   = subTexture.GetSpriteSize();
+                sprite.CellSize     = subTexture.GetCellSize();
+            }
+        }
+
+        if (const auto* sharedText = entity.FindComponent<TextRendererComponent>())
+        {
+            const auto& tc = *sharedText;
+            TextRecord& text = record.TextRenderer.emplace();
+            text.Text     = tc.Text;
+            text.Color    = tc.ColorComp;
+            text.Font     = tc.Font ? tc.Font->GetPath() : "";
+            text.FontSize = tc.Font ? tc.Font->GetPixelHeight() : 0;
+        }
+
+        return record;
+    }
+
+    // ******************************************************************************
+    // Serialize the entity. Extract the entity componenets from record
+    // ******************************************************************************
+    static void SerializeEntity(YAML::Emitter& out, const EntityRecord& record)
+    {
+        out << YAML::BeginMap; // Entity
+        out << YAML::Key << "Entity" << YAML::Value << record.ID;
+
+        if (record.Tag)
         {
             out << YAML::Key << "TagComponent";
             out << YAML::BeginMap; // TagComponent
 
-            auto& tag = entity.GetComponent<TagComponent>().Tag;
-            out << YAML::Key << "Tag" << YAML::Value << tag;
+            out << YAML::Key << "Tag" << YAML::Value << *record.Tag;
 
             out << YAML::EndMap; // TagComponent
         }
 
-        if (entity.HasComponent<TransformComponent>())
+        if (record.Transform)
         {
             out << YAML::Key << "TransformComponent";
             out << YAML::BeginMap; // TransformComponent
 
-            auto& tc = entity.GetComponent<TransformComponent>();
+            auto& tc = *record.Transform;
             out << YAML::Key << "Translation" << YAML::Value << tc.Translation;
             out << YAML::Key << "Rotation" << YAML::Value << tc.Rotation;
             out << YAML::Key << "Scale" << YAML::Value << tc.Scale;
@@ -213,12 +328,12 @@ namespace iKan {
             out << YAML::EndMap; // TransformComponent
         }
 
-        if (entity.HasComponent<CameraComponent>())
+        if (record.Camera)
         {
             out << YAML::Key << "CameraComponent";
             out << YAML::BeginMap; // CameraComponent
 
-            auto& cameraComponent = entity.GetComponent<CameraComponent>();
+            auto& cameraComponent = *record.Camera;
             auto& camera = cameraComponent.Camera;
 
             out << YAML::Key << "Camera" << YAML::Value;
@@ -239,106 +354,80 @@ namespace iKan {
             out << YAML::EndMap; // CameraComponent
         }
 
-        if (entity.HasComponent<SpriteRendererComponent>())
+        if (record.Sprite)
         {
             out << YAML::Key << "SpriteRendererComponent";
             out << YAML::BeginMap; // SpriteRendererComponent
 
-            auto& spriteRendererComponent = entity.GetComponent<SpriteRendererComponent>();
-            out << YAML::Key << "Color" << YAML::Value << spriteRendererComponent.ColorComp;
+            auto& sprite = *record.Sprite;
+            out << YAML::Key << "Color" << YAML::Value << sprite.Color;
 
-            out << YAML::Key << "TilingFactor" << YAML::Value << spriteRendererComponent.TilingFactor;
+            out << YAML::Key << "TilingFactor" << YAML::Value << sprite.TilingFactor;
 
-            if (spriteRendererComponent.Texture.Component)
-            {
-                out << YAML::Key << "IsTexture" << YAML::Value << (bool)true;
-                out << YAML::Key << "IsSubTexture" << YAML::Value << (bool)false;
+            out << YAML::Key << "IsTexture" << YAML::Value << sprite.IsTexture;
+            out << YAML::Key << "IsSubTexture" << YAML::Value << sprite.IsSubTexture;
 
-                out << YAML::Key << "TexAssetUse" << YAML::Value << spriteRendererComponent.Texture.Use;
-                out << YAML::Key << "TexAssetPath" << YAML::Value << spriteRendererComponent.Texture.Component->GetfilePath();
+            if (sprite.IsTexture)
+            {
+                out << YAML::Key << "TexAssetUse" << YAML::Value << sprite.TexAssetUse;
+                out << YAML::Key << "TexAssetPath" << YAML::Value << sprite.TexAssetPath;
             }
-            else if (spriteRendererComponent.SubTexComp)
+            else if (sprite.IsSubTexture)
             {
-                out << YAML::Key << "IsTexture" << YAML::Value << (bool)false;
-                out << YAML::Key << "IsSubTexture" << YAML::Value << (bool)true;
-
-                out << YAML::Key << "TexAssetPath" << YAML::Value << spriteRendererComponent.SubTexComp->GetTexture()->GetfilePath();
+                out << YAML::Key << "TexAssetPath" << YAML::Value << sprite.TexAssetPath;
 
-                out << YAML::Key << "Coords" << YAML::Value << spriteRendererComponent.SubTexComp->GetCoords();
-                out << YAML::Key << "SpriteSize" << YAML::Value << spriteRendererComponent.SubTexComp->GetSpriteSize();
-                out << YAML::Key << "CellSize" << YAML::Value << spriteRendererComponent.SubTexComp->GetCellSize();
+                out << YAML::Key << "Coords" << YAML::Value << sprite.Coords;
+                out << YAML::Key << "SpriteSize" << YAML::Value << sprite.SpriteSize;
+                out << YAML::Key << "CellSize" << YAML::Value << sprite.CellSize;
             }
             else
             {
-                out << YAML::Key << "IsTexture" << YAML::Value << (bool)false;
-                out << YAML::Key << "IsSubTexture" << YAML::Value << (bool)false;
-
                 out << YAML::Key << "TexAssetPath" << YAML::Value << "";
             }
 
-            // TODO: Add subtexture later
             out << YAML::EndMap; // SpriteRendererComponent
         }
 
-        if (entity.HasComponent<SceneHierarchyPannelProp>())
+        if (record.HierarchyProp)
         {
             out << YAML::Key << "SceneHierarchyPannelProp";
             out << YAML::BeginMap; // SceneHierarchyPannelProp
 
-            auto& schComp = entity.GetComponent<SceneHierarchyPannelProp>();
-            out << YAML::Key << "IsProp" << YAML::Value << schComp.IsProp;
+            out << YAML::Key << "IsProp" << YAML::Value << record.HierarchyProp->IsProp;
 
             out << YAML::EndMap; // SceneHierarchyPannelProp
 
         }
 
-        if (entity.HasComponent<AABBColloiderComponent>())
+        if (record.AABBColloider)
         {
             out << YAML::Key << "BoxColliderComponentss";
             out << YAML::BeginMap; // BoxCollider2DComponent
 
-            auto& boxColComp = entity.GetComponent<AABBColloiderComponent>();
-            out << YAML::Key << "IsRigid" << YAML::Value << boxColComp.IsRigid;
+            out << YAML::Key << "IsRigid" << YAML::Value << record.AABBColloider->IsRigid;
 
             out << YAML::EndMap; // BoxCollider2DComponent
 
         }
         
-//        if (entity.HasComponent<NativeScriptComponent>())
-//        {
-//            out << YAML::Key << "NativeScriptComponent";
-//            out << YAML::BeginMap; // NativeScriptComponent
-//
-//            auto& scriptComp = entity.GetComponent<NativeScriptComponent>();
-//            int32_t numScripts = 0;
-//            for (auto scripname : scriptComp.ScriptsName)
-//            {
-//                out << YAML::Key << "Name" << YAML::Value << scripname;
-//                numScripts++;
-//            }
-//            out << YAML::Key << "NumScripts" << YAML::Value << numScripts;
-//
-//            out << YAML::EndMap; // NativeScriptComponent
-//        }
-        
-        if (entity.HasComponent<RigidBody2DComponent>())
+        if (record.RigidBody2D)
         {
             out << YAML::Key << "RigidBody2DComponent";
             out << YAML::BeginMap; // RigidBody2DComponent
             
-            auto& rigidComp = entity.GetComponent<RigidBody2DComponent>();
+            auto& rigidComp = *record.RigidBody2D;
             out << YAML::Key << "BodyType" << YAML::Value << RigidBody2DTypeToString(rigidComp.Type);
             out << YAML::Key << "FixedRotation" << YAML::Value << rigidComp.FixedRotation;
             
             out << YAML::EndMap; // RigidBody2DComponent
         }
         
-        if (entity.HasComponent<BoxColloider2DComponent>())
+        if (record.BoxColloider2D)
         {
             out << YAML::Key << "BoxColloider2DComponent";
             out << YAML::BeginMap; // BoxColloider2DComponent
             
-            auto& boxColComp = entity.GetComponent<BoxColloider2DComponent>();
+            auto& boxColComp = *record.BoxColloider2D;
             out << YAML::Key << "Offset" << YAML::Value << boxColComp.Offset;
             out << YAML::Key << "Size" << YAML::Value << boxColComp.Size;
             
@@ -350,299 +439,476 @@ namespace iKan {
             out << YAML::EndMap; // BoxColloider2DComponent
         }
         
-        if (entity.HasComponent<CircleRendererComponent>())
+        if (record.CircleRenderer)
         {
             out << YAML::Key << "CircleRendererComponent";
             out << YAML::BeginMap; // CircleRendererComponent
             
-            auto& circleRendererComponent = entity.GetComponent<CircleRendererComponent>();
+            auto& circleRendererComponent = *record.CircleRenderer;
             out << YAML::Key << "Color" << YAML::Value << circleRendererComponent.ColorComp;
             
             out << YAML::Key << "Thickness" << YAML::Value << circleRendererComponent.Thickness;
             out << YAML::Key << "Fade" << YAML::Value << circleRendererComponent.Fade;
+            
+            out << YAML::EndMap; // CircleRendererComponent
+        }
+        
+        if (record.TextRenderer)
+        {
+            out << YAML::Key << "TextRendererComponent";
+            out << YAML::BeginMap; // TextRendererComponent
+            
+            auto& text = *record.TextRenderer;
+            out << YAML::Key << "Text" << YAML::Value << text.Text;
+            out << YAML::Key << "Color" << YAML::Value << text.Color;
+            out << YAML::Key << "Font" << YAML::Value << text.Font;
+            out << YAML::Key << "FontSize" << YAML::Value << text.FontSize;
+            
+            out << YAML::EndMap; // TextRendererComponent
         }
 
         out << YAML::EndMap; // Entity
     }
 
     // ******************************************************************************
-    // Serialize the Scene each enityt
+    // Write the records in YAML file. Emitter writes directly in to buffered file
+    // stream, so whole document is never kept in memory
     // ******************************************************************************
-    void SceneSerializer::Serialize(const std::string& filepath)
+    static void WriteScene(const std::string& filepath, const std::vector<EntityRecord>& records)
     {
-        YAML::Emitter out;
+        // Buffer is set before opening the file
+        std::vector<char> buffer(s_WriteBufferSize);
+        std::ofstream fout;
+        fout.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        fout.open(filepath, std::ios::out | std::ios::trunc);
+        if (!fout)
+        {
+            IK_CORE_ERROR("Could not write scene '{0}'", filepath);
+            return;
+        }
+
+        YAML::Emitter out(fout);
         out << YAML::BeginMap;
         out << YAML::Key << "Scene" << YAML::Value << "Untitled";
         out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
-        m_Scene->m_Registry.each([&](auto entityID)
-                                 {
-            Entity entity = { entityID, m_Scene.get() };
+        for (const auto& record : records)
+            SerializeEntity(out, record);
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+    }
+
+    // ******************************************************************************
+    // Capture the records of all the entities of scene
+    // ******************************************************************************
+    static std::vector<EntityRecord> CaptureScene(Scene* scene, entt::registry& registry)
+    {
+        std::vector<EntityRecord> records;
+        records.reserve(registry.alive());
+        registry.each([&](auto entityID)
+                      {
+            Entity entity = { entityID, scene };
             if (!entity)
                 return;
 
-            SerializeEntity(out, entity);
+            records.push_back(CaptureEntity(entity));
         });
-        out << YAML::EndSeq;
-        out << YAML::EndMap;
+        return records;
+    }
 
-        std::ofstream fout(filepath);
-        fout << out.c_str();
+    // ******************************************************************************
+    // Serialize the Scene each enityt
+    // ******************************************************************************
+    void SceneSerializer::Serialize(const std::string& filepath)
+    {
+        WriteScene(filepath, CaptureScene(m_Scene.get(), m_Scene->m_Registry));
     }
 
     // ******************************************************************************
-    // Serialize the Scene Runtime
+    // Serialize the Scene on other thread. Components are captured before returning
+    // so scene can be edited while file is written. Binary scene, if path is given,
+    // is also captured now but written after YAML so that it is newer than YAML
     // ******************************************************************************
-    void SceneSerializer::SerializeRuntime(const std::string& filepath)
+    std::future<void> SceneSerializer::SerializeAsync(const std::string& filepath, const std::string& binaryPath)
     {
-        // Not implemented
-        IK_CORE_ASSERT(false, "Not Implemented Yet");
+        IK_CORE_INFO("Serializing scene {0} in background", filepath);
+
+        std::vector<EntityRecord> records = CaptureScene(m_Scene.get(), m_Scene->m_Registry);
+        SceneSnapshot binary = binaryPath.empty() ? SceneSnapshot() : WriteBinary(false);
+
+        return std::async(std::launch::async, [filepath, binaryPath, records = std::move(records), binary = std::move(binary)]()
+                          {
+            WriteScene(filepath, records);
+            if (!binaryPath.empty())
+                WriteBinaryFile(binaryPath, binary);
+
+            IK_CORE_INFO("Scene {0} is saved", filepath);
+        });
     }
 
+    // Entities parsed by one task are at least this many, so small scenes are not
+    // split in many tasks
+    static constexpr size_t s_MinEntitiesPerTask = 256;
+
     // ******************************************************************************
-    // Deserialize the Scene Runtime
+    // Texture files decoded on worker threads while the entities are still being
+    // parsed. Each path is decoded once, paths are in order of first use
     // ******************************************************************************
-    bool SceneSerializer::Deserialize(const std::string& filepath)
+    class TextureDecoder
     {
-        auto& texMap = m_Scene->GetDataRef().TextureMap;
+    public:
+        TextureDecoder(const std::unordered_map<std::string, Ref<Texture>>& loaded)
+        {
+            for (const auto& [path, texture] : loaded)
+                m_Decoding.emplace(path, std::future<Texture::Image>());
+        }
+
+        // Start decoding the file if it is not decoded yet. Thread safe
+        void Add(const std::string& path)
+        {
+            if (path.empty())
+                return;
+
+            std::scoped_lock lock(m_Mutex);
+            if (m_Decoding.find(path) != m_Decoding.end())
+                return;
+
+            m_Decoding.emplace(path, std::async(std::launch::async, Texture::Decode, path));
+            m_Paths.push_back(path);
+        }
+
+        // Create the textures once all the entities are parsed
+        void CreateTextures(std::unordered_map<std::string, Ref<Texture>>& textureMap)
+        {
+            for (const auto& path : m_Paths)
+                textureMap[path] = Texture::Create(path, m_Decoding[path].get());
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::unordered_map<std::string, std::future<Texture::Image>> m_Decoding;
+        std::vector<std::string> m_Paths;
+    };
+
+    // ******************************************************************************
+    // Parse the YAML node of entity in record
+    // ******************************************************************************
+    static EntityRecord ParseEntity(const YAML::Node& entity)
+    {
+        EntityRecord record;
+        record.ID = entity["Entity"].as<uint64_t>();
+
+        if (auto tagComponent = entity["TagComponent"])
+            record.Tag = tagComponent["Tag"].as<std::string>();
+
+        if (auto transformComponent = entity["TransformComponent"])
+        {
+            auto& tc = record.Transform.emplace();
+            tc.Translation = transformComponent["Translation"].as<glm::vec3>();
+            tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
+            tc.Scale = transformComponent["Scale"].as<glm::vec3>();
+        }
+
+        if (auto cameraComponent = entity["CameraComponent"])
+        {
+            auto& cc = record.Camera.emplace();
+
+            auto cameraProps = cameraComponent["Camera"];
+            cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
+
+            cc.Camera.SetPerspectiveFOV(cameraProps["PerspectiveFOV"].as<float>());
+            cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
+            cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
+
+            cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+            cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
+            cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
+
+            if (cameraComponent["Primary"].as<bool>())
+                cc.MakePrimary();
+            else
+                cc.MakeEditor();
+
+            cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+        }
+
+        if (auto spriteRendererComponent = entity["SpriteRendererComponent"])
+        {
+            auto& sprite = record.Sprite.emplace();
+            sprite.Color        = spriteRendererComponent["Color"].as<glm::vec4>();
+            sprite.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+            sprite.TexAssetPath = spriteRendererComponent["TexAssetPath"].as<std::string>();
+
+            if (!sprite.TexAssetPath.empty())
+            {
+                sprite.IsTexture    = spriteRendererComponent["IsTexture"].as<bool>();
+                sprite.IsSubTexture = spriteRendererComponent["IsSubTexture"].as<bool>();
+            }
+
+            if (sprite.IsTexture)
+            {
+                sprite.TexAssetUse = spriteRendererComponent["TexAssetUse"].as<bool>();
+            }
+            else if (sprite.IsSubTexture)
+            {
+                sprite.Coords     = spriteRendererComponent["Coords"].as<glm::vec2>();
+                sprite.SpriteSize = spriteRendererComponent["SpriteSize"].as<glm::vec2>();
+                sprite.CellSize   = spriteRendererComponent["CellSize"].as<glm::vec2>();
+            }
+        }
+
+        if (auto schComp = entity["SceneHierarchyPannelProp"])
+            record.HierarchyProp = SceneHierarchyPannelProp(schComp["IsProp"].as<bool>());
+
+        if (auto boxColComp = entity["BoxColliderComponentss"])
+            record.AABBColloider = AABBColloiderComponent(boxColComp["IsRigid"].as<bool>());
+
+        if (auto rigidComp = entity["RigidBody2DComponent"])
+        {
+            auto& rcc = record.RigidBody2D.emplace();
+            rcc.Type = StringToRigidBody2DType(rigidComp["BodyType"].as<std::string>());
+            rcc.FixedRotation = rigidComp["FixedRotation"].as<bool>();
+        }
+
+        if (auto boxCol2DComp = entity["BoxColloider2DComponent"])
+        {
+            auto& bcc = record.BoxColloider2D.emplace();
+            bcc.Offset = boxCol2DComp["Offset"].as<glm::vec2>();
+            bcc.Size = boxCol2DComp["Size"].as<glm::vec2>();
+
+            bcc.Density = boxCol2DComp["Density"].as<float>();
+            bcc.Friction = boxCol2DComp["Friction"].as<float>();
+            bcc.Restitution = boxCol2DComp["Restitution"].as<float>();
+            bcc.RestitutionThreshold = boxCol2DComp["RestitutionThreshold"].as<float>();
+        }
+
+        if (auto circleComp = entity["CircleRendererComponent"])
+        {
+            auto& cc = record.CircleRenderer.emplace();
+            cc.ColorComp = circleComp["Color"].as<glm::vec4>();
+            cc.Thickness = circleComp["Thickness"].as<float>();
+            cc.Fade = circleComp["Fade"].as<float>();
+        }
+
+        if (auto textComp = entity["TextRendererComponent"])
+        {
+            auto& text = record.TextRenderer.emplace();
+            text.Text     = textComp["Text"].as<std::string>();
+            text.Color    = textComp["Color"].as<glm::vec4>();
+            text.Font     = textComp["Font"].as<std::string>();
+            text.FontSize = textComp["FontSize"].as<uint32_t>();
+        }
+
+        return record;
+    }
+
+    // ******************************************************************************
+    // Parse the entities of YAML sequence. Texture files are sent for decoding as
+    // soon as they are found
+    // ******************************************************************************
+    static std::vector<EntityRecord> ParseEntities(const YAML::Node& entities, TextureDecoder& textures)
+    {
+        std::vector<EntityRecord> records;
+        records.reserve(entities.size());
+        for (const auto& entity : entities)
+        {
+            const EntityRecord& record = records.emplace_back(ParseEntity(entity));
+            if (record.Sprite)
+                textures.Add(record.Sprite->TexAssetPath);
+        }
+        return records;
+    }
+
+    // ******************************************************************************
+    // Find the items of Entities sequence in scene file as written by Serialize:
+    // items start at the lines with same indentation as first item followed by
+    // "- ". listBegin is the end of "Entities:" line. Returns false if file is laid
+    // out in other way (edited by hand) and it should be parsed as one document
+    // ******************************************************************************
+    static bool FindEntityItems(const std::string& text, size_t& listBegin, size_t& listEnd, std::vector<size_t>& items)
+    {
+        size_t key = text.compare(0, 9, "Entities:") == 0 ? 0 : text.find("\nEntities:");
+        if (key == std::string::npos)
+            return false;
 
-        YAML::Node data = YAML::LoadFile(filepath);
+        listBegin = text.find('\n', key + 1);
+        if (listBegin == std::string::npos)
+            return false;
 
-        if (!data["Scene"])
+        // Indentation of first item
+        size_t itemBegin = listBegin + 1;
+        size_t dash = text.find_first_not_of(' ', itemBegin);
+        if (dash == std::string::npos || text.compare(dash, 2, "- ") != 0)
             return false;
 
-        std::string sceneName = data["Scene"].as<std::string>();
-        IK_CORE_TRACE("Deserializing scene '{0}'", sceneName);
+        // List ends at next key of top level map
+        listEnd = text.size();
+        for (size_t line = text.find('\n', itemBegin); line != std::string::npos; line = text.find('\n', line + 1))
+        {
+            if (line + 1 < text.size() && std::isalpha((unsigned char)text[line + 1]))
+            {
+                listEnd = line + 1;
+                break;
+            }
+        }
+
+        std::string itemPrefix = "\n" + text.substr(itemBegin, dash - itemBegin) + "- ";
+        for (size_t item = listBegin; item != std::string::npos && item < listEnd; item = text.find(itemPrefix, item + 1))
+            items.push_back(item + 1);
+        return true;
+    }
 
-        auto entities = data["Entities"];
-        if (entities)
+    // ******************************************************************************
+    // Deserialize the Scene. Entities are split in ranges that are parsed in to
+    // records on worker threads, texture files are decoded while parsing goes on.
+    // Then records are inserted in registry in bulk, one pool at a time
+    // ******************************************************************************
+    bool SceneSerializer::Deserialize(const std::string& filepath)
+    {
+        std::ifstream in(filepath, std::ios::in | std::ios::binary);
+        if (!in)
+        {
+            IK_CORE_ERROR("Could not open scene '{0}'", filepath);
+            return false;
+        }
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        auto& texMap = m_Scene->GetDataRef().TextureMap;
+        TextureDecoder textures(texMap);
+
+        std::vector<EntityRecord> records;
+        size_t listBegin = 0, listEnd = 0;
+        std::vector<size_t> items;
+        if (FindEntityItems(text, listBegin, listEnd, items))
         {
-            for (auto entity : entities)
+            YAML::Node header = YAML::Load(text.substr(0, listBegin));
+            if (!header["Scene"])
+                return false;
+
+            IK_CORE_TRACE("Deserializing scene '{0}'", header["Scene"].as<std::string>());
+
+            // Each task parses its range of items as separate YAML sequence
+            size_t numTasks = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), items.size() / s_MinEntitiesPerTask));
+            size_t itemsPerTask = (items.size() + numTasks - 1) / numTasks;
+
+            std::vector<std::future<std::vector<EntityRecord>>> tasks;
+            for (size_t first = 0; first < items.size(); first += itemsPerTask)
             {
-                uint64_t uuid = entity["Entity"].as<uint64_t>(); // TODO
-
-                std::string name;
-                auto tagComponent = entity["TagComponent"];
-                if (tagComponent)
-                    name = tagComponent["Tag"].as<std::string>();
-
-                IK_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
-
-                Entity deserializedEntity = m_Scene->CreateEntity(name, uuid);
-
-                auto transformComponent = entity["TransformComponent"];
-                if (transformComponent)
-                {
-                    // Entities always have transforms
-                    auto& tc = deserializedEntity.GetComponent<TransformComponent>();
-                    tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-                    tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-                    tc.Scale = transformComponent["Scale"].as<glm::vec3>();
-
-                    IK_CORE_INFO("  Entity Transform:");
-                    IK_CORE_INFO("      Translation: {0}, {1}, {2}", tc.Translation.x, tc.Translation.y, tc.Translation.z);
-                    IK_CORE_INFO("      Rotation: {0}, {1}, {2}", tc.Rotation.x, tc.Rotation.y, tc.Rotation.z);
-                    IK_CORE_INFO("      Scale: {0}, {1}, {2}", tc.Scale.x, tc.Scale.y, tc.Scale.z);
-                }
-
-                auto cameraComponent = entity["CameraComponent"];
-                if (cameraComponent)
-                {
-                    auto& cc = deserializedEntity.AddComponent<CameraComponent>();
-
-                    auto cameraProps = cameraComponent["Camera"]; // TODO: It was reference
-                    cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
-
-                    cc.Camera.SetPerspectiveFOV(cameraProps["PerspectiveFOV"].as<float>());
-                    cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
-                    cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
-
-                    cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-                    cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
-                    cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
-
-                    if (cameraComponent["Primary"].as<bool>())
-                        cc.MakePrimary();
-                    else
-                        cc.MakeEditor();
-
-                    cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
-
-                    IK_CORE_INFO("  Entity Camera:");
-                    IK_CORE_INFO("      Primary: {0}", cc.GetPrimary());
-                    IK_CORE_INFO("      Editor: {0}", cc.GetEditor());
-                    IK_CORE_INFO("      FixedAspectRatio: {0}", cc.FixedAspectRatio);
-                    IK_CORE_INFO("          Projection Type: {0}", cc.Camera.GetProjectionType());
-
-                    IK_CORE_INFO("              PerspectiveFOV: {0}", cc.Camera.GetPerspectiveFOV());
-                    IK_CORE_INFO("              PerspectiveFar: {0}", cc.Camera.GetPerspectiveFarClip());
-                    IK_CORE_INFO("              PerspectiveNear: {0}", cc.Camera.GetPerspectiveNearClip());
-
-                    IK_CORE_INFO("              OrthographicSize: {0}", cc.Camera.GetOrthographicSize());
-                    IK_CORE_INFO("              OrthographicNear: {0}", cc.Camera.GetOrthographicNearClip());
-                    IK_CORE_INFO("              OrthographicFar: {0}",  cc.Camera.GetOrthographicFarClip());
-                }
-
-                auto spriteRendererComponent = entity["SpriteRendererComponent"];
-                if (spriteRendererComponent)
-                {
-                    // TODO: Add for Texutre
-                    auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
-                    src.ColorComp = spriteRendererComponent["Color"].as<glm::vec4>();
-
-                    src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
-
-                    bool isTexture    = spriteRendererComponent["IsTexture"].as<bool>();
-                    bool isSubTexture = spriteRendererComponent["IsSubTexture"].as<bool>();
-
-                    std::string texPath = spriteRendererComponent["TexAssetPath"].as<std::string>();
-                    if (texPath != "")
-                    {
-                        Ref<Texture> texture = nullptr;
-                        if (texMap.find(texPath) != texMap.end())
-                        {
-                            texture = texMap[texPath];
-                        }
-                        else
-                        {
-                            texture = Texture::Create(texPath);
-                            texMap[texPath] = texture;
-                        }
-
-                        if (isTexture)
-                        {
-                            src.Texture.Component = texture;
-                            src.Texture.Use = spriteRendererComponent["TexAssetUse"].as<bool>();
-                        }
-                        else if (isSubTexture)
-                        {
-                            glm::vec2 coords     = spriteRendererComponent["Coords"].as<glm::vec2>();
-                            glm::vec2 spriteSize = spriteRendererComponent["SpriteSize"].as<glm::vec2>();
-                            glm::vec2 cellSize   = spriteRendererComponent["CellSize"].as<glm::vec2>();
-
-                            src.SubTexComp = SubTexture::CreateFromCoords(texture, coords, spriteSize, cellSize);
-                        }
-                        else
-                        {
-                            src.SubTexComp  = nullptr;
-                            src.Texture.Component = nullptr;
-                        }
-                    }
-                    else
-                    {
-                        src.SubTexComp  = nullptr;
-                        src.Texture.Component = nullptr;
-                    }
-
-                    IK_CORE_INFO("  Entity Sprite:");
-
-                    IK_CORE_INFO("      Color: {0}, {1}, {2}", src.ColorComp.x, src.ColorComp.y, src.ColorComp.z);
-                    IK_CORE_INFO("      Texture Tiling Factor: {0}", src.TilingFactor);
-                    IK_CORE_INFO("      Texture Asset Path: {0}", texPath);
-                }
-
-                auto schComp = entity["SceneHierarchyPannelProp"];
-                if (schComp)
-                {
-                    auto& schc  = deserializedEntity.GetComponent<SceneHierarchyPannelProp>();
-                    schc.IsProp = schComp["IsProp"].as<bool>();
-
-                    IK_CORE_INFO("  Scene Hierarchy Pannel Property:");
-                    IK_CORE_INFO("      Is Property pannel present : {0}", schc.IsProp);
-                }
-
-                auto boxColComp = entity["BoxColliderComponentss"];
-                if (boxColComp)
-                {
-                    auto& bcc   = deserializedEntity.GetComponent<AABBColloiderComponent>();
-                    bcc.IsRigid = boxColComp["IsRigid"].as<bool>();
-
-                    IK_CORE_INFO("  BoxCollider 2D Component:");
-                    IK_CORE_INFO("      Is Rigid object : {0}", bcc.IsRigid);
-                }
-                
-//                auto scriptComp = entity["NativeScriptComponent"];
-//                if (scriptComp)
-//                {
-//                    IK_CORE_INFO("  Native Script Component:");
-//                    auto& scc   = deserializedEntity.AddComponent<NativeScriptComponent>();
-//                    
-//                    uint32_t numScript = scriptComp["NumScripts"].as<uint32_t>();
-//                    for (int32_t i = 0; i < numScript; i++)
-//                    {
-//                        const std::string& name = scriptComp["Name"].as<std::string>();
-//                        scc.ScriptsName.emplace_back(name);
-//                        
-//                        auto instance = NativeScriptComponent::ScriptsMap[name];
-//                        scc.Scripts.emplace_back(instance);
-//                        
-//                        instance->UpdateScene(m_Scene);
-//                        instance->UpdateEntity(deserializedEntity);
-//                        
-//                        IK_CORE_INFO("      Script Added : {0}", name);
-//                    }
-//                }
-                
-                auto rigidComp = entity["RigidBody2DComponent"];
-                if (rigidComp)
-                {
-                    IK_CORE_INFO("  Rigid Body 2D Component:");
-                    auto& rcc   = deserializedEntity.AddComponent<RigidBody2DComponent>();
-                    
-                    rcc.Type = StringToRigidBody2DType(rigidComp["BodyType"].as<std::string>());
-                    rcc.FixedRotation = rigidComp["FixedRotation"].as<bool>();
-                    
-                    IK_CORE_INFO("      Type : {0}, Fixed Rotation : {1}", rigidComp["BodyType"].as<std::string>(), rcc.FixedRotation);
-                }
-                
-                auto boxCol2DComp = entity["BoxColloider2DComponent"];
-                if (rigidComp)
-                {
-                    IK_CORE_INFO("  Box Colloider 2D Component:");
-                    auto& bcc   = deserializedEntity.AddComponent<BoxColloider2DComponent>();
-                    
-                    bcc.Offset = boxCol2DComp["Offset"].as<glm::vec2>();
-                    bcc.Size = boxCol2DComp["Size"].as<glm::vec2>();
-                    
-                    bcc.Density = boxCol2DComp["Density"].as<float>();
-                    bcc.Friction = boxCol2DComp["Friction"].as<float>();
-                    bcc.Restitution = boxCol2DComp["Restitution"].as<float>();
-                    bcc.RestitutionThreshold = boxCol2DComp["RestitutionThreshold"].as<float>();
-                    
-                    IK_CORE_INFO("      Offset {0} x {1}", bcc.Offset.x, bcc.Offset.y);
-                    IK_CORE_INFO("      Size {0} x {1}", bcc.Size.x, bcc.Size.y);
-                    
-                    IK_CORE_INFO("      Density {0}", bcc.Density);
-                    IK_CORE_INFO("      Friction {0}", bcc.Friction);
-                    IK_CORE_INFO("      Restitution {0}", bcc.Restitution);
-                    IK_CORE_INFO("      RestitutionThreshold {0}", bcc.RestitutionThreshold);
-                }
-                
-                auto circleComp = entity["CircleRendererComponent"];
-                if (circleComp)
-                {
-                    IK_CORE_INFO("  Circle Renderer Component:");
-                    auto& cc   = deserializedEntity.AddComponent<CircleRendererComponent>();
-                    
-                    cc.ColorComp = circleComp["Color"].as<glm::vec4>();
-                    
-                    cc.Thickness = circleComp["Thickness"].as<float>();
-                    cc.Fade = circleComp["Thickness"].as<float>();
-                    
-                    IK_CORE_INFO("      Color {0} x {1} x {2} x {3}", cc.ColorComp.x, cc.ColorComp.y, cc.ColorComp.z, cc.ColorComp.a);
-                    IK_CORE_INFO("      Thickness {0}", cc.Thickness);
-                    IK_CORE_INFO("      Fade {0}", cc.Fade);
-                }
+                size_t begin = items[first];
+                size_t end   = first + itemsPerTask < items.size() ? items[first + itemsPerTask] : listEnd;
+                tasks.emplace_back(std::async(std::launch::async, [range = text.substr(begin, end - begin), &textures]()
+                                              {
+                    return ParseEntities(YAML::Load(range), textures);
+                }));
             }
+
+            records.reserve(items.size());
+            for (auto& task : tasks)
+            {
+                std::vector<EntityRecord> range = task.get();
+                std::move(range.begin(), range.end(), std::back_inserter(records));
+            }
+        }
+        else
+        {
+            YAML::Node data = YAML::Load(text);
+            if (!data["Scene"])
+                return false;
+
+            IK_CORE_TRACE("Deserializing scene '{0}'", data["Scene"].as<std::string>());
+            if (auto entities = data["Entities"]; entities && entities.IsSequence())
+                records = ParseEntities(entities, textures);
         }
 
+        textures.CreateTextures(texMap);
+        InsertRecords(records);
+
+        IK_CORE_INFO("Deserialized {0} entities from scene {1}", records.size(), filepath);
         return true;
     }
 
-    bool SceneSerializer::DeserializeRuntime(const std::string& filepath)
+    // ******************************************************************************
+    // Create the entities of records and insert their components in bulk. Entities
+    // get transform and hierarchy property even if record has not, same as
+    // Scene::CreateEntity
+    // ******************************************************************************
+    void SceneSerializer::InsertRecords(const std::vector<EntityRecord>& records)
     {
-        // Not implemented
-        IK_CORE_ASSERT(false, "Not Implemented Yet");
-        return false;
+        entt::registry& registry = m_Scene->m_Registry;
+        Scene::Data& sceneData   = m_Scene->m_Data;
+
+        std::vector<entt::entity> entities(records.size());
+        registry.create(entities.begin(), entities.end());
+
+        // ******************************************************************************
+        // Insert the component made by createComponent for each record that has it
+        // ******************************************************************************
+        auto insertComponent = [&](auto* component, auto hasComponent, auto createComponent) {
+            using Component = std::remove_pointer_t<decltype(component)>;
+
+            std::vector<entt::entity> owners;
+            std::vector<Component> components;
+            for (size_t i = 0; i < records.size(); i++)
+            {
+                if (!hasComponent(records[i]))
+                    continue;
+
+                owners.push_back(entities[i]);
+                components.push_back(createComponent(records[i]));
+            }
+            registry.insert<Component>(owners.begin(), owners.end(), components.begin(), components.end());
+        };
+
+        auto always = [](const EntityRecord&) { return true; };
+
+        insertComponent((IDComponent*)nullptr, always, [](const EntityRecord& record) { return IDComponent(record.ID); });
+        insertComponent((TagComponent*)nullptr, always, [](const EntityRecord& record) { return TagComponent(record.Tag.value_or("")); });
+        insertComponent((TransformComponent*)nullptr, always, [](const EntityRecord& record) { return record.Transform.value_or(TransformComponent()); });
+        insertComponent((SceneHierarchyPannelProp*)nullptr, always, [](const EntityRecord& record) { return record.HierarchyProp.value_or(SceneHierarchyPannelProp(true)); });
+
+        insertComponent((CameraComponent*)nullptr, [](const EntityRecord& record) { return record.Camera.has_value(); },
+                        [](const EntityRecord& record) { return *record.Camera; });
+        insertComponent((AABBColloiderComponent*)nullptr, [](const EntityRecord& record) { return record.AABBColloider.has_value(); },
+                        [](const EntityRecord& record) { return *record.AABBColloider; });
+        insertComponent((RigidBody2DComponent*)nullptr, [](const EntityRecord& record) { return record.RigidBody2D.has_value(); },
+                        [](const EntityRecord& record) { return *record.RigidBody2D; });
+        insertComponent((BoxColloider2DComponent*)nullptr, [](const EntityRecord& record) { return record.BoxColloider2D.has_value(); },
+                        [](const EntityRecord& record) { return *record.BoxColloider2D; });
+        insertComponent((CircleRendererComponent*)nullptr, [](const EntityRecord& record) { return record.CircleRenderer.has_value(); },
+                        [](const EntityRecord& record) { return *record.CircleRenderer; });
+
+        auto& texMap = sceneData.TextureMap;
+        insertComponent((SpriteRendererComponent*)nullptr, [](const EntityRecord& record) { return record.Sprite.has_value(); },
+                        [&texMap](const EntityRecord& record) {
+            const SpriteRecord& sprite = *record.Sprite;
+            SpriteRendererComponent src(sprite.Color);
+            src.TilingFactor = sprite.TilingFactor;
+
+            auto it = texMap.find(sprite.TexAssetPath);
+            Ref<Texture> texture = it != texMap.end() ? it->second : nullptr;
+            if (texture && sprite.IsTexture)
+            {
+                src.Texture.Component = texture;
+                src.Texture.Use       = sprite.TexAssetUse;
+            }
+            else if (texture && sprite.IsSubTexture)
+            {
+                src.SubTexComp = SubTexture::CreateFromCoords(texture, sprite.Coords, sprite.SpriteSize, sprite.CellSize);
+            }
+            return src;
+        });
+
+        insertComponent((TextRendererComponent*)nullptr, [](const EntityRecord& record) { return record.TextRenderer.has_value(); },
+                        [](const EntityRecord& record) {
+            const TextRecord& text = *record.TextRenderer;
+            return TextRendererComponent(text.Text, text.Font.empty() ? nullptr : Font::Create(text.Font, text.FontSize), text.Color);
+        });
+
+        sceneData.EntityIDMap.Reserve(sceneData.EntityIDMap.Size() + records.size());
+        for (size_t i = 0; i < records.size(); i++)
+            sceneData.EntityIDMap[records[i].ID] = Entity{ entities[i], m_Scene.get() };
+
+        sceneData.NumEntities += (uint32_t)records.size();
+        sceneData.MaxEntityId += (uint32_t)records.size();
     }
 
 }
@@ -10,9 +10,19 @@
 #pragma once
 
 #include <iKan/Scene/Scene.h>
+#include <future>
 
 namespace iKan {
 
+    // ******************************************************************************
+    // Snapshot of runtime scene. Binary scene with the state of physics bodies, kept
+    // in memory or stored in file
+    // ******************************************************************************
+    using SceneSnapshot = std::vector<uint8_t>;
+
+    // Plain copy of serialized components of one entity
+    struct EntityRecord;
+
     // ******************************************************************************
     // cl;ass to save the scene
     // ******************************************************************************
@@ -23,11 +33,42 @@ namespace iKan {
         ~SceneSerializer();
 
         void Serialize(const std::string& filepath);
-        void SerializeRuntime(const std::string& filepath);
-
         bool Deserialize(const std::string& filepath);
+
+        // Serialize on other thread, scene can be changed as soon as it returns.
+        // Binary scene is written after YAML if binaryPath is not empty
+        std::future<void> SerializeAsync(const std::string& filepath, const std::string& binaryPath = "");
+
+        // Snapshot of scene with the state of Box2D bodies (play/stop, checkpoints).
+        // Restore is done in place: entities are matched by UUID, the ones created
+        // after the snapshot are destroyed, component pools are replaced in bulk and
+        // existing Box2D bodies are moved back, so world is not created again
+        SceneSnapshot TakeSnapshot();
+        bool RestoreSnapshot(const SceneSnapshot& snapshot);
+
+        // Snapshot stored in file (save games)
+        void SerializeRuntime(const std::string& filepath);
         bool DeserializeRuntime(const std::string& filepath);
         
+        // Binary scene, loaded much faster than YAML. YAML is still the editable
+        // source and binary is written next to it (check GetBinaryPath)
+        void SerializeBinary(const std::string& filepath);
+        bool DeserializeBinary(const std::string& filepath);
+        
+        // Path of binary scene of YAML scene file
+        static std::string GetBinaryPath(const std::string& filepath);
+        
+        // Binary scene is up to date if it is newer than YAML scene
+        static bool IsBinaryUpToDate(const std::string& filepath);
+        
+    private:
+        SceneSnapshot WriteBinary(bool runtime);
+        bool ReadBinary(const uint8_t* data, size_t size, bool restore);
+        bool RestoreBinary(const uint8_t* data, size_t size);
+        void InsertRecords(const std::vector<EntityRecord>& records);
+
+        static void WriteBinaryFile(const std::string& filepath, const SceneSnapshot& data);
+
     private:
         Ref<Scene> m_Scene;
     };
@@ -16,6 +16,7 @@
 #include <iKan/Renderer/RendererStats.h>
 #include <iKan/Renderer/SceneRenderer.h>
 #include "ImGuizmo.h"
+#include <filesystem>
 
 namespace iKan {
 
@@ -146,6 +147,9 @@ namespace iKan {
             
             if (ImGuizmo::IsUsing())
             {
+                // Whole drag is one step of journal, committed once gizmo is released
+                m_ActiveScene->GetJournal().Track<TransformComponent>(selectedEntity);
+
                 glm::vec3 translation, rotation, scale;
                 Math::DecomposeTransform(transform, translation, rotation, scale);
                 
@@ -285,6 +289,7 @@ namespace iKan {
 
         bool cmd    = Input::IsKeyPressed(KeyCode::LeftSuper) || Input::IsKeyPressed(KeyCode::RightSuper);
         bool ctrl   = Input::IsKeyPressed(KeyCode::LeftControl) || Input::IsKeyPressed(KeyCode::RightControl);
+        bool shift  = Input::IsKeyPressed(KeyCode::LeftShift) || Input::IsKeyPressed(KeyCode::RightShift);
         switch (event.GetKeyCode())
         {
             case KeyCode::S:    if (cmd && m_ActiveScene)   m_SaveFile   = true;    break;
@@ -294,6 +299,13 @@ namespace iKan {
             case KeyCode::X:    if (cmd)    CloseScene();   break;
                 
             case KeyCode::D:    if (cmd)    OnDuplicateEntity(); break;
+
+            // Undo : Cmd + Z, Redo : Cmd + Shift + Z
+            case KeyCode::Z:    if (cmd && shift)   OnRedo();   else if (cmd)   OnUndo();   break;
+
+            // Checkpoints of playing scene
+            case KeyCode::F5:   OnSaveCheckpoint(); break;
+            case KeyCode::F9:   OnLoadCheckpoint(); break;
                                 
             // Gizmos
             case KeyCode::Q:    if (ctrl)    m_Data.GizmoType = -1;                               break;
@@ -338,13 +350,30 @@ namespace iKan {
         IK_INFO("Opening saved scene from {0}", path.c_str());
         if (!path.empty())
         {
+            // Scene might be still being saved
+            if (m_Saving.valid())
+                m_Saving.wait();
+
             m_SceneHierarchyPannel.SetSelectedEntity({});
             CloseScene();
             
             m_EditorScene = CreateRef<Scene>(path);
 
-            SceneSerializer serializer(m_EditorScene);
-            serializer.Deserialize(path);
+            // Binary scene is loaded if it is saved after the YAML scene. Scene is
+            // created again if binary is corrupted, it might be loaded partially
+            bool loaded = false;
+            if (SceneSerializer::IsBinaryUpToDate(path))
+            {
+                loaded = SceneSerializer(m_EditorScene).DeserializeBinary(SceneSerializer::GetBinaryPath(path));
+                if (!loaded)
+                    m_EditorScene = CreateRef<Scene>(path);
+            }
+            
+            if (!loaded)
+            {
+                SceneSerializer serializer(m_EditorScene);
+                serializer.Deserialize(path);
+            }
             
             m_EditorScene->OnViewportResize((uint32_t)m_Data.Size.x, (uint32_t)m_Data.Size.y);
             
@@ -363,8 +392,7 @@ namespace iKan {
         if (path != "")
         {
             m_ActiveScene->SetFilePath(path);
-            SceneSerializer serializer(m_ActiveScene);
-            serializer.Serialize(path);
+            SaveSceneFile(path);
             return m_ActiveScene;
         }
         
@@ -388,8 +416,7 @@ namespace iKan {
             if (!filepath.empty())
             {
                 m_ActiveScene->SetFilePath(filepath);
-                SceneSerializer serializer(m_ActiveScene);
-                serializer.Serialize(filepath);
+                SaveSceneFile(filepath);
             }
             m_SaveFileAs = false;
         }
@@ -398,6 +425,18 @@ namespace iKan {
         return m_ActiveScene;
     }
 
+    // ******************************************************************************
+    // Write the YAML and binary scene file on other thread. Previous save is finished
+    // first so that two saves never write same file
+    // ******************************************************************************
+    void Viewport::SaveSceneFile(const std::string& filepath)
+    {
+        if (m_Saving.valid())
+            m_Saving.wait();
+
+        m_Saving = SceneSerializer(m_ActiveScene).SerializeAsync(filepath, SceneSerializer::GetBinaryPath(filepath));
+    }
+
     // ******************************************************************************
     // Saving Scene
     // ******************************************************************************
@@ -413,8 +452,7 @@ namespace iKan {
             IK_INFO("Saving Scene at {0}", filepath.c_str());
             if (!filepath.empty())
             {
-                SceneSerializer serializer(m_ActiveScene);
-                serializer.Serialize(filepath);
+                SaveSceneFile(filepath);
                 m_SaveFile = false;
             }
         }
@@ -459,6 +497,12 @@ namespace iKan {
                 ImGui::EndMenu(); // ImGui::BeginMenu("File")
             } // if (ImGui::BeginMenuBar())
 
+            if (ImGui::BeginMenu("Edit"))
+            {
+                EditMenu();
+                ImGui::EndMenu(); // if (ImGui::BeginMenu("Edit"))
+            }
+
             if (ImGui::BeginMenu("View"))
             {
                 ViewMenu();
@@ -475,6 +519,26 @@ namespace iKan {
         }
     }
 
+    // ******************************************************************************
+    // Edit menu for Viewport. Patch is stored next to the scene file, it can be
+    // applied to the scene while it is playing
+    // ******************************************************************************
+    void Viewport::EditMenu()
+    {
+        bool editing = m_ActiveScene && m_ActiveScene->IsEditing();
+        bool saved   = m_ActiveScene && !m_ActiveScene->GetFilePath().empty();
+
+        if (ImGui::MenuItem("Undo", "Cmd + Z", false, editing && m_ActiveScene->GetJournal().CanUndo()))          OnUndo();
+        if (ImGui::MenuItem("Redo", "Cmd + Shift + Z", false, editing && m_ActiveScene->GetJournal().CanRedo()))  OnRedo();
+        ImGui::Separator();
+
+        if (ImGui::MenuItem("Export Patch", nullptr, false, editing && saved))
+            m_ActiveScene->GetJournal().SavePatch(GetPatchPath(m_ActiveScene->GetFilePath()));
+
+        if (ImGui::MenuItem("Apply Patch", nullptr, false, saved))
+            SceneJournal::ApplyPatch(m_ActiveScene.get(), SceneJournal::LoadPatch(GetPatchPath(m_ActiveScene->GetFilePath())));
+    }
+
     // ******************************************************************************
     // Property menu for Viewport
     // ******************************************************************************
@@ -528,6 +592,11 @@ namespace iKan {
             m_Flags.IsImguiPannel = !m_Flags.IsImguiPannel;
         
         ImGui::Separator();
+
+        if (ImGui::MenuItem("Physics Debug Draw", nullptr, Scene::GetNativeDataRef().DebugDraw))
+            Scene::GetNativeDataRef().DebugDraw = !Scene::GetNativeDataRef().DebugDraw;
+
+        ImGui::Separator();
     }
     
     // ******************************************************************************
@@ -637,6 +706,11 @@ namespace iKan {
                 // Render Scene Hierarchy pannel in imgui
                 m_SceneHierarchyPannel.OnImguiender();
             }
+
+            // Edit is done once no widget or gizmo is held, all the changes of edit are
+            // one step of journal
+            if (!ImGui::IsAnyItemActive() && !ImGuizmo::IsUsing())
+                m_ActiveScene->GetJournal().Commit();
         }
     }
     
@@ -647,17 +721,85 @@ namespace iKan {
     {
         m_ActiveScene->OnRuntimeStop();
         m_ActiveScene = m_EditorScene;
+
+        // Get back the scene as it was before play
+        SceneSerializer(m_EditorScene).RestoreSnapshot(m_PlaySnapshot);
+        m_PlaySnapshot.clear();
+        m_CheckpointSnapshot.clear();
+
+        // Restored cameras have default aspect ratio
+        m_ActiveScene->OnViewportResize((uint32_t)m_Data.Size.x, (uint32_t)m_Data.Size.y);
+
+        // Scripts are not in snapshot, so entities destroyed while playing must get
+        // them back from the scene
+        uint32_t numScripts = m_ActiveScene->GetNumScriptedEntities();
+        if (numScripts != m_PlayNumScripts)
+            IK_CORE_ERROR("Scene had {0} entities with scripts before play, {1} after stop", m_PlayNumScripts, numScripts);
     }
     
     // ******************************************************************************
-    // Play The Scene
+    // Play The Scene. Scene is played in place, snapshot taken before play is
+    // restored on stop
     // ******************************************************************************
     void Viewport::OnScenePlay()
     {
-        m_ActiveScene = Scene::Copy(m_EditorScene);
+        m_PlaySnapshot   = SceneSerializer(m_EditorScene).TakeSnapshot();
+        m_PlayNumScripts = m_EditorScene->GetNumScriptedEntities();
+
+        m_ActiveScene = m_EditorScene;
         m_ActiveScene->OnRuntimeStart();
     }
+
+    // ******************************************************************************
+    // Store the checkpoint of playing scene
+    // ******************************************************************************
+    void Viewport::OnSaveCheckpoint()
+    {
+        if (!m_ActiveScene || m_ActiveScene->IsEditing())
+            return;
+
+        m_CheckpointSnapshot = SceneSerializer(m_ActiveScene).TakeSnapshot();
+        IK_CORE_INFO("Checkpoint of playing scene is stored ({0} bytes)", m_CheckpointSnapshot.size());
+    }
+
+    // ******************************************************************************
+    // Get back the playing scene to stored checkpoint
+    // ******************************************************************************
+    void Viewport::OnLoadCheckpoint()
+    {
+        if (!m_ActiveScene || m_ActiveScene->IsEditing() || m_CheckpointSnapshot.empty())
+            return;
+
+        SceneSerializer(m_ActiveScene).RestoreSnapshot(m_CheckpointSnapshot);
+        m_ActiveScene->OnViewportResize((uint32_t)m_Data.Size.x, (uint32_t)m_Data.Size.y);
+    }
     
+    // ******************************************************************************
+    // Undo the last edit of scene
+    // ******************************************************************************
+    void Viewport::OnUndo()
+    {
+        if (m_ActiveScene && m_ActiveScene->IsEditing())
+            m_ActiveScene->GetJournal().Undo();
+    }
+
+    // ******************************************************************************
+    // Redo the last undone edit of scene
+    // ******************************************************************************
+    void Viewport::OnRedo()
+    {
+        if (m_ActiveScene && m_ActiveScene->IsEditing())
+            m_ActiveScene->GetJournal().Redo();
+    }
+
+    // ******************************************************************************
+    // Path of patch of scene file
+    // ******************************************************************************
+    std::string Viewport::GetPatchPath(const std::string& scenePath)
+    {
+        return std::filesystem::path(scenePath).replace_extension(".iKanPatch").string();
+    }
+
     // ******************************************************************************
     // Duplicate the entity
     // ******************************************************************************
@@ -799,7 +941,10 @@ namespace iKan {
         if (m_ActiveScene->GetSceneState() == Scene::NativeData::State::Edit)
         {
             if (m_Flags.IsRendererStats)
-                ImGuiAPI::RendererStats(&m_Flags.IsRendererStats);
+            {
+                TextureMemory::Usage sceneTextures = m_ActiveScene->GetTextureMemoryUsage();
+                ImGuiAPI::RendererStats(&m_Flags.IsRendererStats, &sceneTextures);
+            }
             
             if (m_Flags.IsVendorType)
                 ImGuiAPI::RendererVersion(&m_Flags.IsVendorType);
@@ -81,6 +81,7 @@ namespace iKan {
         bool OnKeyPressed(KeyPressedEvent& e);
 
         void OnUpdateImGui();
+        void EditMenu();
         void PropertyMenu();
         void ViewMenu();
         void RendererStats(Timestep ts);
@@ -91,9 +92,16 @@ namespace iKan {
         
         void OnSceneEdit();
         void OnScenePlay();
+        void OnSaveCheckpoint();
+        void OnLoadCheckpoint();
         void OnImguizmoUpdate();
         
+        void OnUndo();
+        void OnRedo();
         void OnDuplicateEntity();
+        void SaveSceneFile(const std::string& filepath);
+
+        static std::string GetPatchPath(const std::string& scenePath);
 
     public:
         ~Viewport() = default;
@@ -144,6 +152,10 @@ namespace iKan {
 
         Ref<Scene>                 m_ActiveScene;
         Ref<Scene>                 m_EditorScene;
+        SceneSnapshot              m_PlaySnapshot;
+        SceneSnapshot              m_CheckpointSnapshot;
+        uint32_t                   m_PlayNumScripts = 0; // Checked after stop
+        std::future<void>          m_Saving;
         PropFlag                   m_Flags;
         ViewportData               m_Data;
         iKan::SceneHeirarchyPannel m_SceneHierarchyPannel;
@@ -0,0 +1,148 @@
+// ******************************************************************************
+// File         : RefCountedSlotsTest.cpp
+// Description  : Test of generational handles of RefCountedSlots
+// Project      : iKan : Tests
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+// ******************************************************************************
+// Standalone program, not part of engine target. Build and run from repo root:
+//
+//     c++ -std=c++17 -g -fsanitize=address,undefined -I iKan/src iKan/tests/RefCountedSlotsTest.cpp -o RefCountedSlotsTest
+//     ./RefCountedSlotsTest
+//
+// RefCountedSlots is the book keeping of interned SubTexture table, so this
+// checks the handles of SubTexture: retain after free, double release and stale
+// handles of reused slots. Returns non zero if any check fails
+// ******************************************************************************
+
+#include <cstdio>
+#include <set>
+
+#include <iKan/Core/RefCountedSlots.h>
+
+namespace iKan {
+
+    static uint32_t s_NumFailed = 0;
+
+    // ******************************************************************************
+    // Check the condition and print the failed ones
+    // ******************************************************************************
+    static void Check(bool condition, const char* what)
+    {
+        if (condition)
+            return;
+
+        std::printf("FAILED : %s\n", what);
+        s_NumFailed++;
+    }
+
+    // ******************************************************************************
+    // Retain of released slot is refused, so slot is not freed twice and two new
+    // entries never share one slot
+    // ******************************************************************************
+    static void TestRetainAfterFree()
+    {
+        RefCountedSlots slots;
+        uint32_t handle = slots.Allocate();
+        Check(handle != 0, "Allocated handle is not 0");
+        Check(slots.Retain(handle), "Live slot is retained");
+        Check(slots.Release(handle), "Last release frees the slot");
+
+        Check(!slots.IsValid(handle), "Released handle is stale");
+        Check(!slots.Retain(handle), "Released handle can not be retained");
+        Check(!slots.Release(handle), "Released handle can not be released again");
+        Check(slots.GetNumFree() == 1, "Slot is in free list once");
+
+        uint32_t first  = slots.Allocate();
+        uint32_t second = slots.Allocate();
+        Check(RefCountedSlots::IndexOf(first) != RefCountedSlots::IndexOf(second), "New entries get their own slots");
+        Check(RefCountedSlots::IndexOf(first) == RefCountedSlots::IndexOf(handle), "Freed slot is reused");
+        Check(first != handle, "Reused slot gets new handle");
+    }
+
+    // ******************************************************************************
+    // Stale handle does not alias the entry that reused its slot
+    // ******************************************************************************
+    static void TestStaleHandle()
+    {
+        RefCountedSlots slots;
+        uint32_t stale = slots.Allocate();
+        slots.Retain(stale);
+        slots.Release(stale);
+
+        uint32_t reused = slots.Allocate();
+        slots.Retain(reused);
+
+        Check(!slots.Retain(stale), "Stale handle does not retain reused slot");
+        Check(!slots.Release(stale), "Stale handle does not release reused slot");
+        Check(slots.GetRefCount(reused) == 1, "Reused slot keeps its own references");
+        Check(slots.GetRefCount(stale) == 0, "Stale handle has no references");
+    }
+
+    // ******************************************************************************
+    // Slot is freed only with its last reference
+    // ******************************************************************************
+    static void TestRefCount()
+    {
+        RefCountedSlots slots;
+        uint32_t handle = slots.Allocate();
+        slots.Retain(handle);
+        slots.Retain(handle);
+
+        Check(!slots.Release(handle), "Slot with references left is not freed");
+        Check(slots.IsValid(handle), "Slot with references left is live");
+        Check(slots.Release(handle), "Last reference frees the slot");
+        Check(!slots.Retain(0) && !slots.Release(0), "Handle 0 is ignored");
+    }
+
+    // ******************************************************************************
+    // Clear makes all the handles stale, and every slot is free once
+    // ******************************************************************************
+    static void TestClear()
+    {
+        RefCountedSlots slots;
+        std::set<uint32_t> handles;
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            uint32_t handle = slots.Allocate();
+            slots.Retain(handle);
+            handles.insert(handle);
+        }
+        Check(handles.size() == 100, "Handles are unique");
+
+        slots.Clear();
+        Check(slots.GetNumLive() == 0, "No live slot after clear");
+        Check(slots.GetNumFree() == 100, "All the slots are free after clear");
+
+        bool anyValid = false;
+        for (uint32_t handle : handles)
+            anyValid |= slots.IsValid(handle) || slots.Release(handle);
+        Check(!anyValid, "Handles before clear are stale");
+
+        std::set<uint32_t> indices;
+        for (uint32_t i = 0; i < 100; i++)
+            indices.insert(RefCountedSlots::IndexOf(slots.Allocate()));
+        Check(indices.size() == 100 && slots.GetCapacity() == 101, "Freed slots are reused once each");
+    }
+
+}
+
+int main()
+{
+    iKan::TestRetainAfterFree();
+    iKan::TestStaleHandle();
+    iKan::TestRefCount();
+    iKan::TestClear();
+
+    if (iKan::s_NumFailed)
+    {
+        std::printf("%u checks failed\n", iKan::s_NumFailed);
+        return 1;
+    }
+
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,283 @@
+// ******************************************************************************
+// File         : ShaderLexerFuzz.cpp
+// Description  : Regression and fuzz test of GLSL lexer used for reflection
+// Project      : iKan : Tests
+//
+// Created by Ashish on 19/10/26.
+// Copyright © 2021 Ashish. All rights reserved.
+// ******************************************************************************
+
+// ******************************************************************************
+// Standalone program, not part of engine target. Build (in one line) and run
+// from repo root:
+//
+//     c++ -std=c++17 -g -fsanitize=address,undefined -I iKan/src
+//         iKan/tests/ShaderLexerFuzz.cpp iKan/src/iKan/Platform/OpenGL/OpenGLShaderLexer.cpp
+//         -o ShaderLexerFuzz
+//     ./ShaderLexerFuzz [shader directory, default iKan/assets/shaders]
+//
+// Corpus is the shaders of assets and malformed inputs below (unterminated
+// comments and strings, open conditionals, "#type" at end of file ...). Each
+// input, every truncation of it and random mutations of it are split in stages
+// and walked the way OpenGLShader parses the reflection. Tokens must stay in
+// source and lexer must end. Returns non zero if any check fails
+// ******************************************************************************
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <iKan/Platform/OpenGL/OpenGLShaderLexer.h>
+
+namespace iKan {
+
+    using Token = OpenGLShaderLexer::Token;
+
+    static uint32_t s_NumFailed = 0;
+
+    // ******************************************************************************
+    // Check the condition and print the failed ones
+    // ******************************************************************************
+    static void Check(bool condition, const char* what, std::string_view input = {})
+    {
+        if (condition)
+            return;
+
+        std::printf("FAILED : %s\n", what);
+        if (!input.empty())
+            std::printf("  input (%zu bytes) : %.*s\n", input.size(), (int)std::min<size_t>(input.size(), 120), input.data());
+        s_NumFailed++;
+    }
+
+    // ******************************************************************************
+    // Token is a non empty view in to source, or the End token
+    // ******************************************************************************
+    static bool IsInSource(const Token& token, std::string_view source)
+    {
+        if (token.Kind == Token::Type::End)
+            return true;
+
+        return !token.Text.empty() && token.Text.data() >= source.data() && token.Text.data() + token.Text.size() <= source.data() + source.size();
+    }
+
+    // ******************************************************************************
+    // Walk the source like OpenGLShader::ParseSource: structs and uniforms are parsed
+    // member by member with Peek, Accept and SkipPast, other blocks are skipped.
+    // Every token lexed is checked. Each loop lexes at least one token per char, so
+    // walk is stopped if it takes more steps than that
+    // ******************************************************************************
+    static void Walk(std::string_view source)
+    {
+        OpenGLShaderLexer lexer(source);
+        size_t maxSteps = source.size() + 2;
+        size_t steps    = 0;
+
+        auto next = [&]() {
+            Token token = lexer.Next();
+            Check(IsInSource(token, source), "Token is out of source", source);
+            steps++;
+            return token;
+        };
+
+        while (steps < maxSteps)
+        {
+            Token token = next();
+            if (token.Kind == Token::Type::End)
+                break;
+
+            if (token.Is("struct") || token.Is("uniform"))
+            {
+                next();
+                if (!lexer.Accept('{'))
+                {
+                    if (lexer.Accept('['))
+                        lexer.SkipPast(']');
+                    lexer.SkipPast(';');
+                    continue;
+                }
+
+                while (steps < maxSteps && lexer.Peek().Kind != Token::Type::End && !lexer.Accept('}'))
+                {
+                    next();
+                    do
+                    {
+                        next();
+                        if (lexer.Accept('['))
+                            lexer.SkipPast(']');
+                    } while (steps < maxSteps && lexer.Accept(','));
+                    lexer.SkipPast(';');
+                }
+            }
+            else if (token.Is('{'))
+            {
+                lexer.SkipPast('}');
+            }
+        }
+        Check(steps < maxSteps, "Lexer does not end", source);
+
+        // Lexer stays at end
+        Check(lexer.Next().Kind == Token::Type::End && lexer.Peek().Kind == Token::Type::End, "Lexer does not stay at end", source);
+    }
+
+    // ******************************************************************************
+    // Split the stages and walk the whole input and each stage
+    // ******************************************************************************
+    static void Run(std::string_view input)
+    {
+        Walk(input);
+        for (const auto& stage : OpenGLShaderLexer::SplitStages(input))
+        {
+            Check(stage.Source.data() >= input.data() && stage.Source.data() + stage.Source.size() <= input.data() + input.size(), "Stage is out of source", input);
+            Walk(stage.Source);
+        }
+    }
+
+    // ******************************************************************************
+    // All the tokens of source as text
+    // ******************************************************************************
+    static std::string Tokens(std::string_view source)
+    {
+        std::string result;
+        OpenGLShaderLexer lexer(source);
+        for (Token token = lexer.Next(); token.Kind != Token::Type::End; token = lexer.Next())
+        {
+            result += result.empty() ? "" : " ";
+            result += token.Text;
+        }
+        return result;
+    }
+
+    // ******************************************************************************
+    // Expected results of malformed inputs
+    // ******************************************************************************
+    static void TestRegressions()
+    {
+        auto stages = OpenGLShaderLexer::SplitStages("#type vertex");
+        Check(stages.size() == 1 && stages[0].Type == "vertex" && stages[0].Source.empty(), "\"#type vertex\" at end of file is empty stage");
+
+        stages = OpenGLShaderLexer::SplitStages("#type");
+        Check(stages.size() == 1 && stages[0].Type.empty() && stages[0].Source.empty(), "\"#type\" at end of file has no type");
+
+        stages = OpenGLShaderLexer::SplitStages("#type vertex\r\nA\n#type  fragment\nB");
+        Check(stages.size() == 2 && stages[0].Type == "vertex" && stages[1].Type == "fragment", "Types of stages");
+        Check(stages.size() == 2 && stages[0].Source == "\r\nA\n" && stages[1].Source == "\nB", "Sources of stages");
+
+        Check(OpenGLShaderLexer::SplitStages("uniform float u;").empty(), "File without \"#type\" has no stage");
+
+        Check(Tokens("uniform /* never closed uniform float x;") == "uniform", "Unterminated block comment ends the source");
+        Check(Tokens("uniform float x; // at end") == "uniform float x ;", "Line comment at end of file");
+        Check(Tokens("a / b * c") == "a / b * c", "Division is not a comment");
+        Check(Tokens("#ifdef A\nuniform float hidden;\n") == "", "Unterminated #ifdef of undefined name");
+        Check(Tokens("#define A\n#ifdef A\nuniform float x;\n#else\nuniform float y;\n#endif\n") == "uniform float x ;", "Active #ifdef branch");
+        Check(Tokens("#ifndef A\nfloat a;\n#else\nfloat b;\n#endif\n#endif\n#else\nfloat c;") == "float a ; float c ;", "Unbalanced #endif and #else");
+        Check(Tokens("#") == "" && Tokens("#ifdef") == "" && Tokens("#define") == "", "Directive at end of file");
+        Check(Tokens("uniform float s = \"unterminated;") == "uniform float s = \" unterminated ;", "Unterminated string is lexed as symbols");
+        Check(Tokens("float f = 1.5e3;") == "float f = 1.5e3 ;", "Number with fraction and exponent");
+    }
+
+    // ******************************************************************************
+    // Read the shader files of directory
+    // ******************************************************************************
+    static std::vector<std::string> ReadShaders(const std::string& directory)
+    {
+        std::vector<std::string> shaders;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        {
+            if (entry.path().extension() != ".glsl")
+                continue;
+
+            std::ifstream in(entry.path(), std::ios::binary);
+            std::stringstream content;
+            content << in.rdbuf();
+            shaders.push_back(content.str());
+
+            // Shaders that are not included have vertex and fragment stage
+            auto stages = OpenGLShaderLexer::SplitStages(shaders.back());
+            if (!stages.empty())
+            {
+                bool vertex = false, fragment = false;
+                for (const auto& stage : stages)
+                {
+                    vertex   |= stage.Type == "vertex";
+                    fragment |= stage.Type == "fragment";
+                }
+                Check(vertex && fragment, "Shader asset has vertex and fragment stage", entry.path().filename().string());
+            }
+        }
+
+        Check(!shaders.empty(), "No shader found in directory", directory);
+        return shaders;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    using namespace iKan;
+
+    TestRegressions();
+
+    std::vector<std::string> corpus = ReadShaders(argc > 1 ? argv[1] : "iKan/assets/shaders");
+    const char* malformed[] = {
+        "", "#", "/", "/*", "*/", "\"", "{", "}", "[", "]", ";", ",",
+        "#type", "#type ", "#type vertex", "#type vertex\n", "#type\n#type\n#type",
+        "uniform", "uniform {", "uniform r_Block { float a", "uniform float a[", "uniform float a[4",
+        "struct S { vec2 a, b", "struct { } ;", "uniform sampler2D u_Textures[16",
+        "/* unterminated comment #type vertex\nuniform float x;",
+        "uniform float s = \"unterminated string;\n",
+        "#ifdef A\n#ifdef B\n#else\n#else\n#endif", "#endif\n#endif\n#else",
+        "#define\n#define A\n#ifdef A\n#elif\n#elif", "#if 0\nuniform float x;\n#endif",
+        "{{{{{{{{{{{{{{{{{{{{", "}}}}}}}}}}}}}}}}}}}}", "uniform highp", "uniform lowp float",
+        "#type vertex\r#version 330 core\r\nuniform mat4 m;\r",
+    };
+    for (const char* input : malformed)
+        corpus.emplace_back(input);
+
+    // Dictionary of mutations, tokens that open or close something
+    const std::string_view dictionary[] = {
+        "/*", "*/", "//", "\"", "\n", "#", "#type ", "#ifdef A\n", "#ifndef A\n", "#else\n", "#endif\n",
+        "#define A\n", "{", "}", "[", "]", ";", ",", "uniform ", "struct ", std::string_view("\0", 1),
+    };
+
+    std::mt19937 random(1234);
+    size_t numInputs = 0;
+    for (const auto& input : corpus)
+    {
+        // Every truncation of input
+        for (size_t size = 0; size <= input.size(); size++, numInputs++)
+            Run(std::string_view(input).substr(0, size));
+
+        // Random mutations, each in its own buffer so that reads past end are found
+        for (uint32_t i = 0; i < 500; i++, numInputs++)
+        {
+            std::string mutated = input;
+            uint32_t numEdits = 1 + random() % 8;
+            for (uint32_t edit = 0; edit < numEdits; edit++)
+            {
+                size_t at = mutated.empty() ? 0 : random() % (mutated.size() + 1);
+                switch (random() % 3)
+                {
+                    case 0 : mutated.insert(at, std::string(dictionary[random() % std::size(dictionary)])); break;
+                    case 1 : if (at < mutated.size()) mutated.erase(at, 1 + random() % 16); break;
+                    case 2 : if (at < mutated.size()) mutated[at] = (char)random(); break;
+                }
+            }
+
+            std::vector<char> buffer(mutated.begin(), mutated.end());
+            Run(std::string_view(buffer.data(), buffer.size()));
+        }
+    }
+
+    if (s_NumFailed)
+    {
+        std::printf("%u checks failed\n", s_NumFailed);
+        return 1;
+    }
+
+    std::printf("All checks passed (%zu inputs)\n", numInputs);
+    return 0;
+}